@@ -95,6 +95,13 @@ parser.add_argument(
     help="DRAM address map policy",
 )
 
+parser.add_argument(
+    "--verify-frfcfs",
+    action="store_true",
+    help="Check every FR-FCFS scheduling decision against a full "
+    "queue scan",
+)
+
 args = parser.parse_args()
 
 # at the moment we stay with the default open-adaptive page policy,
@@ -136,6 +143,8 @@ system.mem_ctrls[0].dram.null = True
 # Set the address mapping based on input argument
 system.mem_ctrls[0].dram.addr_mapping = args.addr_map
 
+system.mem_ctrls[0].dram.verify_frfcfs = args.verify_frfcfs
+
 # stay in each state for 0.25 ms, long enough to warm things up, and
 # short enough to avoid hitting a refresh
 period = 250000000
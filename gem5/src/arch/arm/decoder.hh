@@ -135,7 +135,9 @@ class Decoder : public InstDecoder
     StaticInstPtr
     decode(ExtMachInst mach_inst, Addr addr)
     {
-        StaticInstPtr si = defaultCache.decode(this, mach_inst, addr);
+        StaticInstPtr si = defaultCache.decode(
+                this, mach_inst, addr,
+                decodeContext(decoderFlavor, dvmEnabled));
         DPRINTF(Decode, "Decode: Decoded %s instruction: %#x\n",
                 si->getName(), mach_inst);
         si->size((!emi.thumb || emi.bigThumb) ? 4 : 2);
@@ -145,6 +147,17 @@ class Decoder : public InstDecoder
   public: // Decoder API
     Decoder(const ArmDecoderParams &params);
 
+    /**
+     * Key of the decoder state that the generated decode functions read
+     * and that is not part of the ExtMachInst, used to look instructions
+     * up in the decode cache shared by all Arm decoders.
+     */
+    static uint64_t
+    decodeContext(enums::DecoderFlavor flavor, bool dvm_enabled)
+    {
+        return (uint64_t)flavor << 1 | dvm_enabled;
+    }
+
     /** Reset the decoders internal state. */
     void reset() override;
 
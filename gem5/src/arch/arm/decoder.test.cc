@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <set>
+
+#include "arch/arm/decoder.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+using SharedMap = decode_cache::SharedInstMap<ArmISA::Decoder,
+                                              ArmISA::ExtMachInst>;
+
+/**
+ * Looks an instruction up in the shared decode table the way a decoder
+ * with the given state does, and returns whether it had to be decoded.
+ */
+bool
+lookupDecodes(enums::DecoderFlavor flavor, bool dvm_enabled,
+              ArmISA::ExtMachInst mach_inst)
+{
+    bool decoded = false;
+    SharedMap::instance().lookup(
+        ArmISA::Decoder::decodeContext(flavor, dvm_enabled), mach_inst,
+        [&]() {
+            decoded = true;
+            return StaticInstPtr();
+        });
+    return decoded;
+}
+
+} // anonymous namespace
+
+/*
+ * The generated decode functions emit different instructions for the
+ * DVM TLBI and DC operations depending on dvmEnabled, so decoders which
+ * only differ in it must not share decoded instructions.
+ */
+TEST(ArmDecoderTest, DecodeContextIncludesDvmEnabled)
+{
+    std::set<uint64_t> contexts;
+    for (int i = 0; i < enums::Num_DecoderFlavor; i++) {
+        auto flavor = static_cast<enums::DecoderFlavor>(i);
+        contexts.insert(ArmISA::Decoder::decodeContext(flavor, false));
+        contexts.insert(ArmISA::Decoder::decodeContext(flavor, true));
+    }
+    EXPECT_EQ(2 * enums::Num_DecoderFlavor, contexts.size());
+}
+
+TEST(ArmDecoderTest, DvmDecodersDoNotShareInstructions)
+{
+    // TLBI VAE1IS, X0
+    ArmISA::ExtMachInst tlbi = 0xd5088320;
+    tlbi.aarch64 = 1;
+
+    EXPECT_TRUE(lookupDecodes(enums::Generic, false, tlbi));
+    EXPECT_TRUE(lookupDecodes(enums::Generic, true, tlbi));
+
+    // Decoders with the same state still share.
+    EXPECT_FALSE(lookupDecodes(enums::Generic, false, tlbi));
+    EXPECT_FALSE(lookupDecodes(enums::Generic, true, tlbi));
+}
@@ -43,7 +43,6 @@ template <typename Decoder, typename EMI>
 class BasicDecodeCache
 {
   private:
-    decode_cache::InstMap<EMI> instMap;
     struct AddrMapEntry
     {
         StaticInstPtr inst;
@@ -53,25 +52,24 @@ class BasicDecodeCache
 
   public:
     /// Decode a machine instruction.
+    /// Instructions are looked up by address in this decoder's pages
+    /// first, and then in the table shared by all decoders of the ISA.
     /// @param mach_inst The binary instruction to decode.
+    /// @param context Decoder state which affects decoding and is not
+    ///        part of mach_inst.
     /// @retval A pointer to the corresponding StaticInst object.
     StaticInstPtr
-    decode(Decoder *const decoder, EMI mach_inst, Addr addr)
+    decode(Decoder *const decoder, EMI mach_inst, Addr addr,
+           uint64_t context=0)
     {
         auto &entry = decodePages.lookup(addr);
         if (entry.inst && (entry.machInst == mach_inst))
             return entry.inst;
 
         entry.machInst = mach_inst;
-
-        auto iter = instMap.find(mach_inst);
-        if (iter != instMap.end()) {
-            entry.inst = iter->second;
-            return entry.inst;
-        }
-
-        entry.inst = decoder->decodeInst(mach_inst);
-        instMap[mach_inst] = entry.inst;
+        entry.inst = decode_cache::SharedInstMap<Decoder, EMI>::instance().
+            lookup(context, mach_inst,
+                   [&]() { return decoder->decodeInst(mach_inst); });
         return entry.inst;
     }
 };
@@ -46,6 +46,7 @@ Decoder::Decoder(const RiscvDecoderParams &p) : InstDecoder(p, &machInst)
     vlen = isa->getVecLenInBits();
     elen = isa->getVecElemLenInBits();
     _enableZcd = isa->enableZcd();
+    decodeContext = (uint64_t)vlen << 32 | (uint64_t)elen << 1 | _enableZcd;
     reset();
 }
 
@@ -121,8 +122,11 @@ Decoder::decode(ExtMachInst mach_inst, Addr addr)
             mach_inst.instBits, addr);
 
     StaticInstPtr &si = instMap[mach_inst];
-    if (!si)
-        si = decodeInst(mach_inst);
+    if (!si) {
+        si = decode_cache::SharedInstMap<Decoder, ExtMachInst>::instance().
+            lookup(decodeContext, mach_inst,
+                   [&]() { return decodeInst(mach_inst); });
+    }
 
     si->size(compressed(mach_inst) ? 2 : 4);
 
@@ -63,6 +63,9 @@ class Decoder : public InstDecoder
     uint32_t vlen;
     uint32_t elen;
     bool _enableZcd;
+    /// The ISA configuration above, as a key into the decode cache shared
+    /// by all RISC-V decoders.
+    uint64_t decodeContext;
     Addr jvtEntry;
 
     VTYPE vtype = (1ULL << 63); // vtype.vill = 1 at initial;
@@ -639,7 +639,9 @@ Decoder::decode(ExtMachInst mach_inst, Addr addr)
     if (iter != instMap->end()) {
         si = iter->second;
     } else {
-        si = decodeInst(mach_inst);
+        si = decode_cache::SharedInstMap<Decoder, ExtMachInst>::instance().
+            lookup(instMapKey, mach_inst,
+                   [&]() { return decodeInst(mach_inst); });
         (*instMap)[mach_inst] = si;
     }
 
@@ -246,6 +246,9 @@ class Decoder : public InstDecoder
     typedef std::unordered_map<
             CacheKey, decode_cache::InstMap<ExtMachInst> *> InstCacheMap;
     InstCacheMap instCacheMap;
+    /// The m5Reg value instMap belongs to, which is also the context used
+    /// in the decode cache shared by all x86 decoders.
+    CacheKey instMapKey = 0;
 
     StaticInstPtr decodeInst(ExtMachInst mach_inst);
 
@@ -280,6 +283,7 @@ class Decoder : public InstDecoder
         defAddr = m5Reg.defAddr;
         stack = m5Reg.stack;
 
+        instMapKey = m5Reg;
         InstCacheMap::iterator imIter = instCacheMap.find(m5Reg);
         if (imIter != instCacheMap.end()) {
             instMap = imIter->second;
@@ -0,0 +1,296 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "base/binary_trace.hh"
+
+#include <algorithm>
+#include <iostream>
+
+#include "base/logging.hh"
+
+namespace gem5
+{
+
+namespace trace
+{
+
+thread_local std::unique_ptr<BinaryLogger::ThreadBuffer>
+    BinaryLogger::localBuffer;
+
+BinaryLogger::ThreadBuffer::ThreadBuffer(BinaryLogger *_logger, uint32_t _id)
+    : logger(_logger), id(_id)
+{
+    data.reserve(logger->blockSize);
+}
+
+BinaryLogger::ThreadBuffer::~ThreadBuffer()
+{
+    if (!logger)
+        return;
+
+    std::lock_guard<std::mutex> lock(logger->mutex);
+    logger->completeBlock(*this);
+    auto &threads = logger->threads;
+    threads.erase(std::remove(threads.begin(), threads.end(), this),
+                  threads.end());
+}
+
+BinaryLogger::BinaryLogger(std::ostream &_stream, size_t ring_size,
+                           size_t block_size)
+    : stream(_stream), ringSize(ring_size), blockSize(block_size)
+{
+    recordsRaw = true;
+    writeHeader();
+
+    // Panics and fatal errors don't unwind the stack, so make sure that
+    // the messages leading up to them end up in the file.
+    static bool registered = false;
+    if (!registered) {
+        gem5::Logger::getPanic().registerExtraLog(&flushOnFailure);
+        gem5::Logger::getFatal().registerExtraLog(&flushOnFailure);
+        registered = true;
+    }
+}
+
+BinaryLogger::~BinaryLogger()
+{
+    // No other thread can log through a logger that is being destroyed,
+    // so all their buffers can be written out.
+    std::lock_guard<std::mutex> lock(mutex);
+    for (auto *tb : threads) {
+        completeBlock(*tb);
+        tb->logger = nullptr;
+    }
+    threads.clear();
+    flushLocked();
+}
+
+std::string
+BinaryLogger::flushOnFailure()
+{
+    auto *logger = dynamic_cast<BinaryLogger *>(getDebugLogger());
+    if (!logger)
+        return "";
+
+    // Don't deadlock if the failure happened while logging.
+    std::unique_lock<std::mutex> lock(logger->mutex, std::try_to_lock);
+    if (!lock.owns_lock())
+        return "Binary debug trace could not be flushed.\n";
+
+    logger->flushLocked();
+    return logger->ringMode() ?
+        "Binary debug trace ring written out.\n" : "";
+}
+
+void
+BinaryLogger::flush()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    flushLocked();
+}
+
+void
+BinaryLogger::flushLocked()
+{
+    // Other threads may still be adding to their buffers, so only the
+    // caller's buffer can safely be written out.
+    if (localBuffer && localBuffer->logger == this)
+        completeBlock(*localBuffer);
+
+    writeStrings();
+    for (const auto &block : ring)
+        writeBlock(block.thread, block.data);
+    ring.clear();
+    ringBytes = 0;
+
+    stream.flush();
+}
+
+std::ostream &
+BinaryLogger::getOstream()
+{
+    return std::cerr;
+}
+
+void
+BinaryLogger::logMessage(Tick when, const std::string &name,
+        const std::string &flag, const std::string &message)
+{
+    if (!isEnabled(name))
+        return;
+
+    auto &buf = beginRaw(when, name, flag, "%s", 1);
+    RawArgs(buf).add(message);
+    endRaw(buf);
+}
+
+BinaryLogger::ThreadBuffer &
+BinaryLogger::threadBuffer()
+{
+    if (!localBuffer || localBuffer->logger != this) {
+        // Release the buffer of a previous logger before taking our own
+        // lock, its destructor takes the lock of its logger.
+        localBuffer.reset();
+
+        std::lock_guard<std::mutex> lock(mutex);
+        localBuffer.reset(new ThreadBuffer(this, nextThreadId++));
+        threads.push_back(localBuffer.get());
+    }
+    return *localBuffer;
+}
+
+std::vector<uint8_t> &
+BinaryLogger::beginRaw(Tick when, const std::string &name,
+        const std::string &flag, const char *fmt, unsigned num_args)
+{
+    ThreadBuffer &tb = threadBuffer();
+    RawArgs header(tb.data);
+    // Messages without a tick use MaxTick, which wraps to 0 here.
+    header.putVarint(when + 1);
+    header.putVarint(intern(tb, name));
+    header.putVarint(intern(tb, flag));
+    header.putVarint(intern(tb, fmt));
+    header.putVarint(num_args);
+    return tb.data;
+}
+
+void
+BinaryLogger::endRaw(std::vector<uint8_t> &buf)
+{
+    if (buf.size() < blockSize)
+        return;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    completeBlock(*localBuffer);
+}
+
+uint32_t
+BinaryLogger::intern(ThreadBuffer &tb, const std::string &str)
+{
+    auto it = tb.strings.find(str);
+    if (it != tb.strings.end())
+        return it->second;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    const uint32_t id = internLocked(str);
+    tb.strings.emplace(str, id);
+    return id;
+}
+
+uint32_t
+BinaryLogger::intern(ThreadBuffer &tb, const char *fmt)
+{
+    auto it = tb.formats.find(fmt);
+    if (it != tb.formats.end())
+        return it->second;
+
+    const uint32_t id = intern(tb, std::string(fmt));
+    tb.formats.emplace(fmt, id);
+    return id;
+}
+
+uint32_t
+BinaryLogger::internLocked(const std::string &str)
+{
+    auto it = stringIds.find(str);
+    if (it != stringIds.end())
+        return it->second;
+
+    const uint32_t id = strings.size();
+    strings.push_back(str);
+    stringIds.emplace(str, id);
+    return id;
+}
+
+void
+BinaryLogger::completeBlock(ThreadBuffer &tb)
+{
+    if (tb.data.empty())
+        return;
+
+    if (ringMode()) {
+        ringBytes += tb.data.size();
+        ring.push_back({tb.id, std::move(tb.data)});
+        while (ringBytes > ringSize && ring.size() > 1) {
+            ringBytes -= ring.front().data.size();
+            ring.pop_front();
+        }
+        tb.data = std::vector<uint8_t>();
+        tb.data.reserve(blockSize);
+    } else {
+        writeStrings();
+        writeBlock(tb.id, tb.data);
+        tb.data.clear();
+    }
+}
+
+void
+BinaryLogger::writeStrings()
+{
+    for (; stringsWritten < strings.size(); ++stringsWritten)
+        writeString(stringsWritten, strings[stringsWritten]);
+}
+
+void
+BinaryLogger::writeHeader()
+{
+    stream.write("gem5dbgt", 8);
+    for (int i = 0; i < 4; ++i)
+        stream.put(static_cast<char>((Version >> (8 * i)) & 0xff));
+}
+
+void
+BinaryLogger::writeString(uint32_t id, const std::string &str)
+{
+    stream.put('T');
+    writeVarint(id);
+    writeVarint(str.size());
+    stream.write(str.data(), str.size());
+}
+
+void
+BinaryLogger::writeBlock(uint32_t thread, const std::vector<uint8_t> &data)
+{
+    stream.put('B');
+    writeVarint(thread);
+    writeVarint(data.size());
+    stream.write(reinterpret_cast<const char *>(data.data()), data.size());
+}
+
+void
+BinaryLogger::writeVarint(uint64_t value)
+{
+    do {
+        uint8_t byte = value & 0x7f;
+        value >>= 7;
+        stream.put(static_cast<char>(value ? byte | 0x80 : byte));
+    } while (value);
+}
+
+} // namespace trace
+} // namespace gem5
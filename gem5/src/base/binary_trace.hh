@@ -0,0 +1,191 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __BASE_BINARY_TRACE_HH__
+#define __BASE_BINARY_TRACE_HH__
+
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "base/trace.hh"
+#include "base/types.hh"
+
+namespace gem5
+{
+
+namespace trace
+{
+
+/**
+ * Debug logger that records messages without formatting them.
+ *
+ * Each message is stored as the ids of its format string, object name
+ * and flag, followed by its raw arguments (see RawArgs). Messages are
+ * collected in a per-thread buffer that is written out as a block once
+ * it reaches the block size, so the hot path is a few table lookups and
+ * byte copies. util/decode_debug_trace.py renders the file as text.
+ *
+ * In ring mode, completed blocks are kept in memory instead, and only
+ * the most recent ring_size bytes survive. The ring is written out when
+ * the simulator panics or exits with a fatal error, when flush() is
+ * called, or when the logger is destroyed, which makes it possible to
+ * keep tracing enabled during a long run and only look at what happened
+ * just before a failure or the end of the run.
+ *
+ * The file starts with the 8-byte magic "gem5dbgt" and a little-endian
+ * 32-bit version. It is then a sequence of records:
+ *   - 'T' (string): id, length, bytes
+ *   - 'B' (block): thread id, length, messages
+ * A message is: tick + 1 (0 for messages without a tick), name id, flag
+ * id, format id, number of arguments, and the arguments. All integers
+ * are unsigned LEB128 varints. Strings used by a block are always
+ * written before that block.
+ */
+class BinaryLogger : public Logger
+{
+  public:
+    static constexpr uint32_t Version = 1;
+
+    /**
+     * @param stream Output stream, must be opened in binary mode.
+     * @param ring_size Number of bytes of completed blocks to keep in
+     *        memory, or 0 to stream blocks to the output as they fill.
+     * @param block_size Size at which a thread's buffer is flushed.
+     */
+    BinaryLogger(std::ostream &stream, size_t ring_size = 0,
+                 size_t block_size = 1 << 20);
+
+    /**
+     * Write out the buffers of all threads and, in ring mode, the ring.
+     * No thread may log through the logger while it is destroyed.
+     */
+    ~BinaryLogger();
+
+    void logMessage(Tick when, const std::string &name,
+            const std::string &flag, const std::string &message) override;
+
+    /**
+     * Binary traces can't be interleaved with text output, so this
+     * returns std::cerr.
+     */
+    std::ostream &getOstream() override;
+
+    /**
+     * Write out all buffered messages. In ring mode this writes the
+     * string table and the current contents of the ring.
+     */
+    void flush();
+
+    /** Whether completed blocks are only kept in memory. */
+    bool ringMode() const { return ringSize != 0; }
+
+  protected:
+    std::vector<uint8_t> &beginRaw(Tick when, const std::string &name,
+            const std::string &flag, const char *fmt,
+            unsigned num_args) override;
+    void endRaw(std::vector<uint8_t> &buf) override;
+
+    /** Per-thread message buffer and string id caches. */
+    struct ThreadBuffer
+    {
+        ThreadBuffer(BinaryLogger *logger, uint32_t id);
+        ~ThreadBuffer();
+
+        /** Owning logger, nullptr once the logger is gone. */
+        BinaryLogger *logger;
+        const uint32_t id;
+        std::vector<uint8_t> data;
+        /** Format strings are literals, so their address identifies them. */
+        std::unordered_map<const char *, uint32_t> formats;
+        std::unordered_map<std::string, uint32_t> strings;
+    };
+
+    /** Buffer of the calling thread, if it has logged anything. */
+    static thread_local std::unique_ptr<ThreadBuffer> localBuffer;
+
+    /** Get the buffer of the calling thread, creating it if needed. */
+    ThreadBuffer &threadBuffer();
+
+    /** Get the id of a string, adding it to the table if needed. */
+    uint32_t intern(ThreadBuffer &tb, const std::string &str);
+    uint32_t intern(ThreadBuffer &tb, const char *fmt);
+    uint32_t internLocked(const std::string &str);
+
+    /** Hand a thread's buffer over as a completed block. */
+    void completeBlock(ThreadBuffer &tb);
+
+    /** Write the strings that have not been written yet. */
+    void writeStrings();
+
+    /** Write the ring, and the calling thread's buffer, to the output. */
+    void flushLocked();
+
+    /** Flush the active binary logger when the simulator fails. */
+    static std::string flushOnFailure();
+
+    void writeHeader();
+    void writeString(uint32_t id, const std::string &str);
+    void writeBlock(uint32_t thread, const std::vector<uint8_t> &data);
+    void writeVarint(uint64_t value);
+
+    std::ostream &stream;
+    const size_t ringSize;
+    const size_t blockSize;
+
+    /** Protects everything below as well as the output stream. */
+    std::mutex mutex;
+
+    /** Global string table. */
+    std::unordered_map<std::string, uint32_t> stringIds;
+    std::vector<std::string> strings;
+    size_t stringsWritten = 0;
+
+    /** Completed blocks kept in ring mode. */
+    struct Block
+    {
+        uint32_t thread;
+        std::vector<uint8_t> data;
+    };
+    std::deque<Block> ring;
+    size_t ringBytes = 0;
+
+    /** Buffers of all threads that logged through this logger. */
+    std::vector<ThreadBuffer *> threads;
+    uint32_t nextThreadId = 0;
+};
+
+} // namespace trace
+} // namespace gem5
+
+#endif // __BASE_BINARY_TRACE_HH__
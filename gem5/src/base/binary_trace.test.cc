@@ -0,0 +1,337 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <future>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "base/binary_trace.hh"
+#include "base/gtest/cur_tick_fake.hh"
+#include "base/gtest/logging.hh"
+
+using namespace gem5;
+
+// Instantiate the mock class to have a valid curTick of 0
+GTestTickHandler tickHandler;
+
+namespace
+{
+
+/** Minimal decoder for the binary trace format. */
+class TraceReader
+{
+  public:
+    struct Message
+    {
+        uint64_t tick;
+        std::string name;
+        std::string flag;
+        std::string fmt;
+        std::vector<std::string> args;
+    };
+
+    TraceReader(const std::string &data) : data(data) {}
+
+    bool
+    readHeader()
+    {
+        if (data.compare(0, 8, "gem5dbgt") != 0)
+            return false;
+        pos = 12;
+        return true;
+    }
+
+    /** Decode all records, with arguments rendered as strings. */
+    std::vector<Message>
+    readAll()
+    {
+        std::vector<Message> messages;
+        while (pos < data.size()) {
+            const char kind = data[pos++];
+            if (kind == 'T') {
+                const uint64_t id = varint();
+                const uint64_t len = varint();
+                if (strings.size() <= id)
+                    strings.resize(id + 1);
+                strings[id] = data.substr(pos, len);
+                pos += len;
+            } else if (kind == 'B') {
+                varint();
+                const size_t end = varint() + pos;
+                while (pos < end)
+                    messages.push_back(message());
+            } else {
+                ADD_FAILURE() << "Unknown record " << kind;
+                break;
+            }
+        }
+        return messages;
+    }
+
+  private:
+    uint64_t
+    varint()
+    {
+        uint64_t value = 0;
+        for (int shift = 0; ; shift += 7) {
+            const uint8_t byte = data[pos++];
+            value |= uint64_t(byte & 0x7f) << shift;
+            if (!(byte & 0x80))
+                return value;
+        }
+    }
+
+    Message
+    message()
+    {
+        Message msg;
+        msg.tick = varint();
+        msg.name = strings.at(varint());
+        msg.flag = strings.at(varint());
+        msg.fmt = strings.at(varint());
+        const uint64_t num_args = varint();
+        for (uint64_t i = 0; i < num_args; ++i) {
+            const uint8_t type = data[pos++];
+            switch (type) {
+              case trace::RawArgs::Int: {
+                const uint64_t v = varint();
+                msg.args.push_back(std::to_string(
+                    int64_t(v >> 1) ^ -int64_t(v & 1)));
+                break;
+              }
+              case trace::RawArgs::UInt:
+              case trace::RawArgs::Pointer:
+                msg.args.push_back(std::to_string(varint()));
+                break;
+              case trace::RawArgs::Char:
+                msg.args.push_back(std::string(1, data[pos++]));
+                break;
+              case trace::RawArgs::Float: {
+                uint64_t bits = 0;
+                for (int b = 0; b < 8; ++b)
+                    bits |= uint64_t(uint8_t(data[pos++])) << (8 * b);
+                double d;
+                std::memcpy(&d, &bits, sizeof(d));
+                msg.args.push_back(std::to_string(d));
+                break;
+              }
+              case trace::RawArgs::String: {
+                const uint64_t len = varint();
+                msg.args.push_back(data.substr(pos, len));
+                pos += len;
+                break;
+              }
+              default:
+                ADD_FAILURE() << "Unknown argument type " << int(type);
+            }
+        }
+        return msg;
+    }
+
+    const std::string data;
+    size_t pos = 0;
+    std::vector<std::string> strings;
+};
+
+struct Printable
+{
+    int value;
+};
+
+std::ostream &
+operator<<(std::ostream &os, const Printable &p)
+{
+    return os << "Printable(" << p.value << ")";
+}
+
+} // anonymous namespace
+
+/** Test that messages are recorded with their raw arguments. */
+TEST(BinaryTraceTest, RawArguments)
+{
+    std::stringstream ss;
+    {
+        trace::BinaryLogger logger(ss);
+        const std::string str("str");
+        logger.dprintf_flag(Tick(100), "Foo", "Bar", "%d %u %c %f %s %s %s",
+                            -5, 7u, 'x', 1.5, "lit", str, Printable{3});
+    }
+
+    TraceReader reader(ss.str());
+    ASSERT_TRUE(reader.readHeader());
+    auto messages = reader.readAll();
+    ASSERT_EQ(messages.size(), 1);
+    const auto &msg = messages[0];
+    EXPECT_EQ(msg.tick, 101);
+    EXPECT_EQ(msg.name, "Foo");
+    EXPECT_EQ(msg.flag, "Bar");
+    EXPECT_EQ(msg.fmt, "%d %u %c %f %s %s %s");
+    std::vector<std::string> expected = {
+        "-5", "7", "x", std::to_string(1.5), "lit", "str", "Printable(3)"};
+    EXPECT_EQ(msg.args, expected);
+}
+
+/** Test that pre-formatted messages and MaxTick are handled. */
+TEST(BinaryTraceTest, LogMessage)
+{
+    std::stringstream ss;
+    {
+        trace::BinaryLogger logger(ss);
+        logger.logMessage(MaxTick, "Foo", "", "Test message");
+    }
+
+    TraceReader reader(ss.str());
+    ASSERT_TRUE(reader.readHeader());
+    auto messages = reader.readAll();
+    ASSERT_EQ(messages.size(), 1);
+    EXPECT_EQ(messages[0].tick, 0);
+    EXPECT_EQ(messages[0].fmt, "%s");
+    EXPECT_EQ(messages[0].args, std::vector<std::string>{"Test message"});
+}
+
+/** Test that ignored objects are not recorded. */
+TEST(BinaryTraceTest, Ignore)
+{
+    std::stringstream ss;
+    {
+        trace::BinaryLogger logger(ss);
+        logger.addIgnore(ObjectMatch("Foo"));
+        logger.dprintf_flag(Tick(1), "Foo", "", "%d", 1);
+        logger.dprintf_flag(Tick(2), "Bar", "", "%d", 2);
+    }
+
+    TraceReader reader(ss.str());
+    ASSERT_TRUE(reader.readHeader());
+    auto messages = reader.readAll();
+    ASSERT_EQ(messages.size(), 1);
+    EXPECT_EQ(messages[0].name, "Bar");
+}
+
+/** Test that full blocks are streamed out and strings are shared. */
+TEST(BinaryTraceTest, StreamBlocks)
+{
+    std::stringstream ss;
+    trace::BinaryLogger logger(ss, 0, 64);
+    for (int i = 0; i < 100; ++i)
+        logger.dprintf_flag(Tick(i), "Foo", "", "value %d", i);
+
+    // Some blocks must have been written before the logger is flushed.
+    EXPECT_GT(ss.str().size(), 12);
+
+    logger.flush();
+    TraceReader reader(ss.str());
+    ASSERT_TRUE(reader.readHeader());
+    auto messages = reader.readAll();
+    ASSERT_EQ(messages.size(), 100);
+    for (int i = 0; i < 100; ++i)
+        EXPECT_EQ(messages[i].args[0], std::to_string(i));
+}
+
+/** Test that ring mode only keeps the most recent blocks in memory. */
+TEST(BinaryTraceTest, Ring)
+{
+    std::stringstream ss;
+    trace::BinaryLogger logger(ss, 256, 64);
+    for (int i = 0; i < 1000; ++i)
+        logger.dprintf_flag(Tick(i), "Foo", "", "value %d", i);
+
+    // Nothing but the header is written until the ring is flushed.
+    EXPECT_EQ(ss.str().size(), 12);
+
+    logger.flush();
+    TraceReader reader(ss.str());
+    ASSERT_TRUE(reader.readHeader());
+    auto messages = reader.readAll();
+    ASSERT_FALSE(messages.empty());
+    EXPECT_LT(messages.size(), 1000);
+    EXPECT_EQ(messages.back().args[0], "999");
+    EXPECT_EQ(messages.back().tick, 1000);
+
+    // The surviving messages are the most recent, in order.
+    const int first = std::stoi(messages.front().args[0]);
+    for (size_t i = 0; i < messages.size(); ++i)
+        EXPECT_EQ(messages[i].args[0], std::to_string(first + int(i)));
+}
+
+/**
+ * Test that destroying the logger, as happens when gem5 exits, writes
+ * out the partial buffers of all threads, including threads that are
+ * still alive but no longer logging.
+ */
+TEST(BinaryTraceTest, DestroyWritesAllThreads)
+{
+    std::stringstream ss;
+    std::promise<void> logged, release;
+    std::thread other;
+    {
+        trace::BinaryLogger logger(ss, 0, 1 << 20);
+        logger.dprintf_flag(Tick(1), "Foo", "", "value %d", 1);
+        other = std::thread([&]() {
+            logger.dprintf_flag(Tick(2), "Bar", "", "value %d", 2);
+            logged.set_value();
+            release.get_future().wait();
+        });
+        logged.get_future().wait();
+
+        // Nothing fills a block, so only the header has been written.
+        EXPECT_EQ(ss.str().size(), 12);
+    }
+    release.set_value();
+    other.join();
+
+    TraceReader reader(ss.str());
+    ASSERT_TRUE(reader.readHeader());
+    auto messages = reader.readAll();
+    ASSERT_EQ(messages.size(), 2);
+    EXPECT_EQ(messages[0].name, "Foo");
+    EXPECT_EQ(messages[1].name, "Bar");
+}
+
+/** Test that destroying the logger in ring mode writes out the ring. */
+TEST(BinaryTraceTest, DestroyWritesRing)
+{
+    std::stringstream ss;
+    {
+        trace::BinaryLogger logger(ss, 256, 64);
+        for (int i = 0; i < 1000; ++i)
+            logger.dprintf_flag(Tick(i), "Foo", "", "value %d", i);
+        EXPECT_EQ(ss.str().size(), 12);
+    }
+
+    TraceReader reader(ss.str());
+    ASSERT_TRUE(reader.readHeader());
+    auto messages = reader.readAll();
+    ASSERT_FALSE(messages.empty());
+    EXPECT_LT(messages.size(), 1000);
+    EXPECT_EQ(messages.back().args[0], "999");
+}
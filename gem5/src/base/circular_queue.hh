@@ -73,7 +73,7 @@ class CircularQueue
 
     using reference = typename std::vector<T>::reference;
     using const_reference = typename std::vector<T>::const_reference;
-    const size_t _capacity;
+    size_t _capacity;
     size_t _size = 0;
     size_t _head = 1;
 
@@ -426,6 +426,25 @@ class CircularQueue
         _size = 0;
     }
 
+    /**
+     * Increase the capacity of the queue to at least new_capacity. The
+     * elements keep their indices, so iterators remain valid.
+     *
+     * @ingroup api_base_utils
+     */
+    void
+    reserve(size_t new_capacity)
+    {
+        if (new_capacity <= _capacity)
+            return;
+
+        std::vector<T> new_data(new_capacity);
+        for (size_t idx = _head; idx < _head + _size; ++idx)
+            new_data[idx % new_capacity] = std::move(data[idx % _capacity]);
+        data = std::move(new_data);
+        _capacity = new_capacity;
+    }
+
     /**
      * Test if the index is in the range of valid elements.
      */
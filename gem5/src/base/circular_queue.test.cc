@@ -265,3 +265,34 @@ TEST(CircularQueueTest, MultipleRound)
 
     ASSERT_EQ(ending_it - starting_it, cq_size);
 }
+
+/** Testing that growing the queue keeps the elements and iterators. */
+TEST(CircularQueueTest, Reserve)
+{
+    const auto cq_size = 4;
+    CircularQueue<uint32_t> cq(cq_size);
+
+    // Wrap around the underlying storage before growing
+    for (uint32_t idx = 0; idx < 6; idx++)
+        cq.push_back(idx);
+    cq.pop_front();
+    auto it = cq.begin();
+    ASSERT_EQ(*it, 3);
+
+    cq.reserve(2 * cq_size);
+    ASSERT_EQ(cq.capacity(), 2 * cq_size);
+    ASSERT_EQ(cq.size(), 3);
+    ASSERT_EQ(*it, 3);
+    ASSERT_TRUE(it == cq.begin());
+
+    for (uint32_t idx = 6; idx < 11; idx++)
+        cq.push_back(idx);
+    ASSERT_TRUE(cq.full());
+    uint32_t expected = 3;
+    for (auto elem : cq)
+        ASSERT_EQ(elem, expected++);
+
+    // Shrinking is ignored
+    cq.reserve(cq_size);
+    ASSERT_EQ(cq.capacity(), 2 * cq_size);
+}
@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __BASE_POOL_ALLOCATOR_HH__
+#define __BASE_POOL_ALLOCATOR_HH__
+
+#include <cstddef>
+#include <memory>
+#include <new>
+
+namespace gem5
+{
+
+/**
+ * A standard allocator that recycles single objects through a free list
+ * per thread and per object type, instead of going to the heap for
+ * every allocation. It is meant for objects that are created and
+ * destroyed at a high rate, such as packets and requests, and can be
+ * used with std::allocate_shared to pool the object together with its
+ * shared_ptr control block.
+ *
+ * An object may be released by a different thread than the one that
+ * allocated it, in which case its storage moves to the free list of the
+ * releasing thread. Allocations of more than one object, which the
+ * pool is not meant for, go straight to the heap.
+ */
+template <typename T>
+class PoolAllocator
+{
+  public:
+    typedef T value_type;
+
+    /** Maximum number of free objects kept per thread. */
+    static constexpr size_t MaxFree = 4096;
+
+    PoolAllocator() = default;
+
+    template <typename U>
+    PoolAllocator(const PoolAllocator<U> &) {}
+
+    T *
+    allocate(size_t n)
+    {
+        if (n != 1)
+            return std::allocator<T>().allocate(n);
+
+        FreeList &list = freeList;
+        if (!list.head)
+            return static_cast<T *>(::operator new(BlockSize));
+
+        Block *block = list.head;
+        list.head = block->next;
+        --list.size;
+        return reinterpret_cast<T *>(block);
+    }
+
+    void
+    deallocate(T *p, size_t n)
+    {
+        if (n != 1) {
+            std::allocator<T>().deallocate(p, n);
+            return;
+        }
+
+        FreeList &list = freeList;
+        if (list.size == MaxFree) {
+            ::operator delete(p);
+            return;
+        }
+
+        Block *block = reinterpret_cast<Block *>(p);
+        block->next = list.head;
+        list.head = block;
+        ++list.size;
+    }
+
+    /** Number of free objects kept by the calling thread. */
+    static size_t freeCount() { return freeList.size; }
+
+    template <typename U>
+    bool operator==(const PoolAllocator<U> &) const { return true; }
+
+    template <typename U>
+    bool operator!=(const PoolAllocator<U> &) const { return false; }
+
+  private:
+    /** Free objects are linked through their own storage. */
+    struct Block
+    {
+        Block *next;
+    };
+
+    static constexpr size_t BlockSize =
+        sizeof(T) > sizeof(Block) ? sizeof(T) : sizeof(Block);
+
+    static_assert(alignof(T) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__,
+                  "PoolAllocator does not support over-aligned types");
+
+    /**
+     * The free list is trivially destructible, so that objects released
+     * by the destructors of other thread locals or statics can still be
+     * recycled. The objects left on it when a thread exits are not
+     * returned to the heap.
+     */
+    struct FreeList
+    {
+        Block *head;
+        size_t size;
+    };
+
+    static inline thread_local FreeList freeList = {nullptr, 0};
+};
+
+} // namespace gem5
+
+#endif // __BASE_POOL_ALLOCATOR_HH__
@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "base/pool_allocator.hh"
+
+using namespace gem5;
+
+namespace {
+
+struct Object
+{
+    uint64_t a;
+    uint64_t b;
+    uint64_t c;
+};
+
+struct Counted
+{
+    static int live;
+    int value;
+
+    Counted(int value) : value(value) { ++live; }
+    ~Counted() { --live; }
+};
+
+int Counted::live = 0;
+
+} // anonymous namespace
+
+/** A released object is handed out again by the next allocation. */
+TEST(PoolAllocatorTest, Recycle)
+{
+    PoolAllocator<Object> alloc;
+    const size_t free_before = PoolAllocator<Object>::freeCount();
+
+    Object *first = alloc.allocate(1);
+    alloc.deallocate(first, 1);
+    EXPECT_EQ(PoolAllocator<Object>::freeCount(), free_before + 1);
+
+    Object *second = alloc.allocate(1);
+    EXPECT_EQ(first, second);
+    EXPECT_EQ(PoolAllocator<Object>::freeCount(), free_before);
+    alloc.deallocate(second, 1);
+}
+
+/** Objects are recycled in last-in first-out order. */
+TEST(PoolAllocatorTest, LastInFirstOut)
+{
+    PoolAllocator<Object> alloc;
+
+    Object *a = alloc.allocate(1);
+    Object *b = alloc.allocate(1);
+    EXPECT_NE(a, b);
+
+    alloc.deallocate(a, 1);
+    alloc.deallocate(b, 1);
+    EXPECT_EQ(alloc.allocate(1), b);
+    EXPECT_EQ(alloc.allocate(1), a);
+
+    alloc.deallocate(a, 1);
+    alloc.deallocate(b, 1);
+}
+
+/** The free list does not grow beyond its limit. */
+TEST(PoolAllocatorTest, Bounded)
+{
+    PoolAllocator<Object> alloc;
+    const size_t count = PoolAllocator<Object>::MaxFree + 16;
+
+    std::vector<Object *> objects;
+    for (size_t i = 0; i < count; i++)
+        objects.push_back(alloc.allocate(1));
+    for (auto obj : objects)
+        alloc.deallocate(obj, 1);
+
+    EXPECT_EQ(PoolAllocator<Object>::freeCount(),
+              PoolAllocator<Object>::MaxFree);
+}
+
+/** Arrays bypass the pool. */
+TEST(PoolAllocatorTest, Array)
+{
+    PoolAllocator<Object> alloc;
+    const size_t free_before = PoolAllocator<Object>::freeCount();
+
+    Object *array = alloc.allocate(4);
+    for (int i = 0; i < 4; i++)
+        array[i].a = i;
+    alloc.deallocate(array, 4);
+
+    EXPECT_EQ(PoolAllocator<Object>::freeCount(), free_before);
+}
+
+/** Shared objects made with the allocator are recycled with their count. */
+TEST(PoolAllocatorTest, AllocateShared)
+{
+    PoolAllocator<Counted> alloc;
+
+    auto first = std::allocate_shared<Counted>(alloc, 1);
+    auto copy = first;
+    EXPECT_EQ(Counted::live, 1);
+    EXPECT_EQ(copy->value, 1);
+    const Counted *first_ptr = first.get();
+
+    first.reset();
+    EXPECT_EQ(Counted::live, 1);
+    copy.reset();
+    EXPECT_EQ(Counted::live, 0);
+
+    auto second = std::allocate_shared<Counted>(alloc, 2);
+    EXPECT_EQ(second.get(), first_ptr);
+    EXPECT_EQ(second->value, 2);
+}
+
+/** An object released by another thread moves to that thread's pool. */
+TEST(PoolAllocatorTest, CrossThread)
+{
+    PoolAllocator<Object> alloc;
+    Object *obj = alloc.allocate(1);
+    const size_t free_before = PoolAllocator<Object>::freeCount();
+
+    size_t other_free = 0;
+    std::thread other([&]() {
+        PoolAllocator<Object>().deallocate(obj, 1);
+        other_free = PoolAllocator<Object>::freeCount();
+    });
+    other.join();
+
+    EXPECT_EQ(other_free, 1);
+    EXPECT_EQ(PoolAllocator<Object>::freeCount(), free_before);
+}
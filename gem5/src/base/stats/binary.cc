@@ -0,0 +1,383 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "base/stats/binary.hh"
+
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+
+#include "base/logging.hh"
+#include "base/stats/info.hh"
+#include "sim/cur_tick.hh"
+
+namespace gem5
+{
+
+namespace statistics
+{
+
+namespace
+{
+
+/** Number of summary values that precede the buckets of a dist. */
+constexpr size_type distSummaryValues = 7;
+
+const char *const distSummaryNames[distSummaryValues] = {
+    "samples", "sum", "squares", "min_value", "max_value",
+    "underflows", "overflows",
+};
+
+} // anonymous namespace
+
+Binary::Binary(const std::string &file)
+    : outputStream(simout.create(file, true)),
+      stream(outputStream->stream())
+{
+    if (!valid())
+        fatal("Unable to open statistics file for writing\n");
+
+    stream->write("gem5stat", 8);
+    for (int i = 0; i < 4; ++i)
+        stream->put(static_cast<char>((Version >> (8 * i)) & 0xff));
+}
+
+Binary::~Binary()
+{
+    simout.close(outputStream);
+}
+
+void
+Binary::begin()
+{
+    changed.clear();
+}
+
+void
+Binary::end()
+{
+    assert(valid());
+
+    if (!newColumns.empty()) {
+        stream->put('S');
+        writeVarint(newColumns.size());
+        for (auto column : newColumns) {
+            const std::string &name = columnNames[column];
+            writeVarint(column);
+            writeVarint(name.size());
+            stream->write(name.data(), name.size());
+        }
+        newColumns.clear();
+    }
+
+    std::sort(changed.begin(), changed.end());
+
+    stream->put('D');
+    writeVarint(curTick());
+    writeVarint(changed.size());
+    uint64_t next = 0;
+    for (const auto &[column, value] : changed) {
+        writeVarint(column - next);
+        writeDouble(value);
+        next = column + 1;
+    }
+    changed.clear();
+
+    stream->flush();
+}
+
+bool
+Binary::valid() const
+{
+    return stream != nullptr && stream->good();
+}
+
+void
+Binary::beginGroup(const char *name)
+{
+    if (path.empty()) {
+        path.push(name);
+    } else {
+        path.push(csprintf("%s.%s", path.top(), name));
+    }
+}
+
+void
+Binary::endGroup()
+{
+    assert(!path.empty());
+    path.pop();
+}
+
+bool
+Binary::noOutput(const Info &info) const
+{
+    if (!info.flags.isSet(display))
+        return true;
+
+    if (info.prereq && info.prereq->zero())
+        return true;
+
+    return false;
+}
+
+std::string
+Binary::statName(const std::string &name) const
+{
+    if (path.empty())
+        return name;
+    else
+        return csprintf("%s.%s", path.top(), name);
+}
+
+uint32_t
+Binary::newColumn(const std::string &name)
+{
+    uint32_t column = columnNames.size();
+    columnNames.push_back(name);
+    lastValues.push_back(0);
+    written.push_back(false);
+    newColumns.push_back(column);
+    return column;
+}
+
+void
+Binary::update(uint32_t column, Result value)
+{
+    // Compare bit patterns rather than values so that NaNs that stay
+    // NaNs are not rewritten on every dump.
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    if (written[column] && lastValues[column] == bits)
+        return;
+
+    written[column] = true;
+    lastValues[column] = bits;
+    changed.emplace_back(column, value);
+}
+
+void
+Binary::record(const Info &info, const VResult &values,
+               const std::function<std::string(size_type)> &name)
+{
+    auto &columns = infoColumns[info.id];
+    while (columns.size() < values.size())
+        columns.push_back(newColumn(statName(name(columns.size()))));
+
+    for (size_type i = 0; i < values.size(); ++i)
+        update(columns[i], values[i]);
+}
+
+void
+Binary::record(const std::string &name, Result value)
+{
+    auto it = namedColumns.find(name);
+    if (it == namedColumns.end())
+        it = namedColumns.emplace(name, newColumn(name)).first;
+
+    update(it->second, value);
+}
+
+void
+Binary::distValues(const DistData &data, VResult &values)
+{
+    values.push_back(data.samples);
+    values.push_back(data.sum);
+    values.push_back(data.squares);
+    values.push_back(data.min_val);
+    values.push_back(data.max_val);
+    values.push_back(data.underflow);
+    values.push_back(data.overflow);
+    values.insert(values.end(), data.cvec.begin(), data.cvec.end());
+}
+
+std::string
+Binary::distLabel(const DistData &data, size_type i)
+{
+    if (i < distSummaryValues)
+        return distSummaryNames[i];
+
+    // Buckets are labelled by their lower bound.
+    std::ostringstream label;
+    label << data.min + (i - distSummaryValues) * data.bucket_size;
+    return label.str();
+}
+
+void
+Binary::writeVarint(uint64_t value)
+{
+    do {
+        uint8_t byte = value & 0x7f;
+        value >>= 7;
+        if (value)
+            byte |= 0x80;
+        stream->put(static_cast<char>(byte));
+    } while (value);
+}
+
+void
+Binary::writeDouble(Result value)
+{
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    char bytes[sizeof(bits)];
+    for (int i = 0; i < sizeof(bits); ++i)
+        bytes[i] = static_cast<char>((bits >> (8 * i)) & 0xff);
+    stream->write(bytes, sizeof(bytes));
+}
+
+void
+Binary::visit(const ScalarInfo &info)
+{
+    if (noOutput(info))
+        return;
+
+    record(info, VResult(1, info.result()),
+           [&info](size_type) { return info.name; });
+}
+
+void
+Binary::visit(const VectorInfo &info)
+{
+    if (noOutput(info))
+        return;
+
+    VResult values = info.result();
+    const size_type size = values.size();
+    if (info.flags.isSet(total) && size > 1)
+        values.push_back(info.total());
+
+    record(info, values,
+        [&info, size](size_type i) {
+            std::string sub;
+            if (i == size)
+                sub = "total";
+            else if (i < info.subnames.size() && !info.subnames[i].empty())
+                sub = info.subnames[i];
+            else
+                sub = std::to_string(i);
+            return info.name + info.separatorString + sub;
+        });
+}
+
+void
+Binary::visit(const DistInfo &info)
+{
+    if (noOutput(info))
+        return;
+
+    VResult values;
+    distValues(info.data, values);
+
+    record(info, values,
+        [&info](size_type i) {
+            return info.name + info.separatorString +
+                distLabel(info.data, i);
+        });
+}
+
+void
+Binary::visit(const VectorDistInfo &info)
+{
+    if (noOutput(info))
+        return;
+
+    if (info.data.empty())
+        return;
+
+    // All elements of a vector distribution share the same layout.
+    const size_type per_dist =
+        distSummaryValues + info.data.front().cvec.size();
+
+    VResult values;
+    for (const auto &data : info.data)
+        distValues(data, values);
+
+    record(info, values,
+        [&info, per_dist](size_type i) {
+            const size_type d = i / per_dist;
+            const std::string sub =
+                d < info.subnames.size() && !info.subnames[d].empty() ?
+                info.subnames[d] : std::to_string(d);
+            return info.name + "_" + sub + info.separatorString +
+                distLabel(info.data[d], i % per_dist);
+        });
+}
+
+void
+Binary::visit(const Vector2dInfo &info)
+{
+    if (noOutput(info))
+        return;
+
+    VResult values(info.cvec.begin(), info.cvec.end());
+    record(info, values,
+        [&info](size_type i) {
+            const size_type x = i / info.y;
+            const size_type y = i % info.y;
+            const std::string x_sub =
+                x < info.subnames.size() && !info.subnames[x].empty() ?
+                info.subnames[x] : std::to_string(x);
+            const std::string y_sub =
+                y < info.y_subnames.size() && !info.y_subnames[y].empty() ?
+                info.y_subnames[y] : std::to_string(y);
+            return info.name + "_" + x_sub + info.separatorString + y_sub;
+        });
+}
+
+void
+Binary::visit(const FormulaInfo &info)
+{
+    visit((const VectorInfo &)info);
+}
+
+void
+Binary::visit(const SparseHistInfo &info)
+{
+    if (noOutput(info))
+        return;
+
+    // The set of buckets of a sparse histogram changes over time, so
+    // its columns are looked up by name.
+    const std::string base = statName(info.name) + info.separatorString;
+    record(base + "samples", info.data.samples);
+    for (const auto &[key, count] : info.data.cmap) {
+        std::ostringstream name;
+        name << base << key;
+        record(name.str(), count);
+    }
+}
+
+std::unique_ptr<Output>
+initBinary(const std::string &filename)
+{
+    return std::unique_ptr<Output>(new Binary(filename));
+}
+
+} // namespace statistics
+} // namespace gem5
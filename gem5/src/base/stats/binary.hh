@@ -0,0 +1,170 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __BASE_STATS_BINARY_HH__
+#define __BASE_STATS_BINARY_HH__
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <stack>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "base/compiler.hh"
+#include "base/output.hh"
+#include "base/stats/output.hh"
+#include "base/stats/types.hh"
+
+namespace gem5
+{
+
+namespace statistics
+{
+
+class Info;
+
+/**
+ * Streaming, columnar binary stat output.
+ *
+ * Every stat is flattened into one or more scalar columns (e.g., one
+ * per vector element or histogram bucket). The name of a column is
+ * written once, the first time it is seen, and each dump then only
+ * records the columns whose value changed since the previous dump. If
+ * the file name ends in ".gz" the stream is also gzip compressed.
+ *
+ * The file starts with the 8-byte magic "gem5stat" followed by a
+ * little-endian 32-bit format version. It is then a sequence of
+ * records, each starting with a one-byte record type:
+ *   - 'S' (schema): count, then count x (column id, name length, name)
+ *   - 'D' (dump): tick, count, then count x (column id gap, value)
+ * All integers in records are unsigned LEB128 varints. Column ids in a
+ * dump record are increasing; each is stored as the gap to the previous
+ * id plus one. Values are little-endian IEEE 754 doubles.
+ *
+ * @see src/python/m5/stats/binary_reader.py
+ */
+class Binary : public Output
+{
+  public:
+    static constexpr uint32_t Version = 1;
+
+    Binary(const std::string &file);
+    ~Binary();
+
+    Binary() = delete;
+    Binary(const Binary &other) = delete;
+
+  public: // Output interface
+    void begin() override;
+    void end() override;
+    bool valid() const override;
+
+    void beginGroup(const char *name) override;
+    void endGroup() override;
+
+    void visit(const ScalarInfo &info) override;
+    void visit(const VectorInfo &info) override;
+    void visit(const DistInfo &info) override;
+    void visit(const VectorDistInfo &info) override;
+    void visit(const Vector2dInfo &info) override;
+    void visit(const FormulaInfo &info) override;
+    void visit(const SparseHistInfo &info) override;
+
+  protected:
+    bool noOutput(const Info &info) const;
+    std::string statName(const std::string &name) const;
+
+    /**
+     * Record the current values of a stat with a fixed layout.
+     *
+     * Column names are only generated the first time a value index is
+     * seen for this stat.
+     *
+     * @param info Stat info structure.
+     * @param values Flattened stat values.
+     * @param name Generates the (unqualified) name of value i.
+     */
+    void record(const Info &info, const VResult &values,
+                const std::function<std::string(size_type)> &name);
+
+    /** Record a value for a column identified by its full name. */
+    void record(const std::string &name, Result value);
+
+    /** Record a value for a known column if it changed. */
+    void update(uint32_t column, Result value);
+
+    /** Allocate a new column. */
+    uint32_t newColumn(const std::string &name);
+
+    /** Append the flattened values of a distribution to a vector. */
+    static void distValues(const DistData &data, VResult &values);
+
+    /** Name suffix of the i-th flattened value of a distribution. */
+    static std::string distLabel(const DistData &data, size_type i);
+
+    void writeVarint(uint64_t value);
+    void writeDouble(Result value);
+
+  protected:
+    OutputStream *outputStream;
+    std::ostream *stream;
+
+    /** Object/group path */
+    std::stack<std::string> path;
+
+    /** Columns of fixed-layout stats, indexed by stat id. */
+    std::unordered_map<int, std::vector<uint32_t>> infoColumns;
+
+    /** Columns of variable-layout stats, indexed by full name. */
+    std::unordered_map<std::string, uint32_t> namedColumns;
+
+    /** Column names, indexed by column id. */
+    std::vector<std::string> columnNames;
+
+    /** Last value written for each column. */
+    std::vector<uint64_t> lastValues;
+
+    /** Whether a value has been written for each column yet. */
+    std::vector<bool> written;
+
+    /** Columns created since the last schema record. */
+    std::vector<uint32_t> newColumns;
+
+    /** Values that changed in the current dump. */
+    std::vector<std::pair<uint32_t, Result>> changed;
+};
+
+std::unique_ptr<Output> initBinary(const std::string &filename);
+
+} // namespace statistics
+} // namespace gem5
+
+#endif // __BASE_STATS_BINARY_HH__
@@ -31,8 +31,11 @@
 
 #include "base/trace.hh"
 
+#include <array>
+#include <atomic>
 #include <cctype>
 #include <fstream>
+#include <functional>
 #include <iostream>
 #include <sstream>
 
@@ -83,10 +86,12 @@ output()
 void
 setDebugLogger(Logger *logger)
 {
-    if (!logger)
+    if (!logger) {
         warn("Trying to set debug logger to NULL\n");
-    else
+    } else {
         debug_logger = logger;
+        Logger::filtersChanged();
+    }
 }
 
 void
@@ -103,6 +108,66 @@ disable()
 
 ObjectMatch ignore;
 
+RangeFilter addrFilter;
+RangeFilter pcFilter;
+
+namespace
+{
+
+/**
+ * Version of the ignore and activate expressions of all loggers, cached
+ * name matches of older versions are stale.
+ */
+std::atomic<uint64_t> filterVersion{1};
+
+} // anonymous namespace
+
+void
+Logger::filtersChanged()
+{
+    filterVersion++;
+}
+
+bool
+Logger::matchName(const std::string &name) const
+{
+    bool ignore_match = ignore.match(name);
+    bool activate_match = activate.match(name);
+    if (ignore_match && activate_match)
+        panic("%s in both ignore and activate.\n", name);
+    if (ignore_match)
+        return false;
+    if (!activate.empty() && !activate_match)
+        return false;
+    return true;
+}
+
+bool
+Logger::lookupEnabled(const std::string &name) const
+{
+    struct Entry
+    {
+        const Logger *logger = nullptr;
+        uint64_t version = 0;
+        std::string name;
+        bool enabled = false;
+    };
+    // Direct mapped, the number of distinct names that are traced at the
+    // same time is usually small.
+    static thread_local std::array<Entry, 256> cache;
+
+    const uint64_t version = filterVersion.load(std::memory_order_relaxed);
+    Entry &entry = cache[std::hash<std::string>()(name) % cache.size()];
+    if (entry.logger != this || entry.version != version ||
+            entry.name != name) {
+        entry.enabled = matchName(name);
+        entry.logger = this;
+        entry.version = version;
+        entry.name = name;
+    }
+    return entry.enabled;
+}
+
 
 void
 Logger::dump(Tick when, const std::string &name,
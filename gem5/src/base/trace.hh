@@ -32,9 +32,13 @@
 #ifndef __BASE_TRACE_HH__
 #define __BASE_TRACE_HH__
 
+#include <cstdint>
+#include <cstring>
 #include <ostream>
 #include <string>
 #include <sstream>
+#include <type_traits>
+#include <vector>
 
 #include "base/compiler.hh"
 #include "base/cprintf.hh"
@@ -54,6 +58,99 @@ namespace gem5
 
 namespace trace {
 
+/**
+ * Encoder for the arguments of a message that is recorded without being
+ * formatted (see BinaryLogger). Each argument is stored as a type tag
+ * followed by its raw value. Arguments that have no raw representation
+ * are formatted on their own and stored as strings.
+ */
+class RawArgs
+{
+  public:
+    enum Type : uint8_t
+    {
+        Int,     // zigzag varint
+        UInt,    // varint
+        Float,   // little-endian IEEE 754 double
+        Char,    // one byte
+        String,  // varint length followed by the bytes
+        Pointer, // varint
+    };
+
+    RawArgs(std::vector<uint8_t> &_buf) : buf(_buf) {}
+
+    template <typename T>
+    void
+    add(const T &arg)
+    {
+        if constexpr (std::is_same_v<T, char>) {
+            buf.push_back(Char);
+            buf.push_back(static_cast<uint8_t>(arg));
+        } else if constexpr (std::is_same_v<T, bool>) {
+            buf.push_back(UInt);
+            putVarint(arg);
+        } else if constexpr (std::is_floating_point_v<T>) {
+            buf.push_back(Float);
+            putDouble(arg);
+        } else if constexpr (std::is_integral_v<T> || std::is_enum_v<T>) {
+            using U = std::conditional_t<std::is_enum_v<T>,
+                  std::underlying_type<T>, std::common_type<T>>;
+            const auto value = static_cast<typename U::type>(arg);
+            if constexpr (std::is_signed_v<typename U::type>) {
+                buf.push_back(Int);
+                const int64_t v = value;
+                putVarint((uint64_t(v) << 1) ^ uint64_t(v >> 63));
+            } else {
+                buf.push_back(UInt);
+                putVarint(value);
+            }
+        } else if constexpr (std::is_convertible_v<T, const char *>) {
+            const char *str = arg;
+            putString(str, str ? std::strlen(str) : 0);
+        } else if constexpr (std::is_same_v<T, std::string>) {
+            putString(arg.data(), arg.size());
+        } else if constexpr (std::is_pointer_v<T>) {
+            buf.push_back(Pointer);
+            putVarint(reinterpret_cast<uintptr_t>(arg));
+        } else {
+            std::ostringstream str;
+            ccprintf(str, "%s", arg);
+            const std::string s = str.str();
+            putString(s.data(), s.size());
+        }
+    }
+
+    void
+    putVarint(uint64_t value)
+    {
+        do {
+            uint8_t byte = value & 0x7f;
+            value >>= 7;
+            buf.push_back(value ? byte | 0x80 : byte);
+        } while (value);
+    }
+
+  private:
+    void
+    putDouble(double value)
+    {
+        uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        for (int i = 0; i < sizeof(bits); ++i)
+            buf.push_back((bits >> (8 * i)) & 0xff);
+    }
+
+    void
+    putString(const char *str, size_t len)
+    {
+        buf.push_back(String);
+        putVarint(len);
+        buf.insert(buf.end(), str, str + len);
+    }
+
+    std::vector<uint8_t> &buf;
+};
+
 /** Debug logging base class.  Handles formatting and outputting
  *  time/name/message messages */
 class Logger
@@ -64,22 +161,57 @@ class Logger
     /** Name match for objects to activate log */
     ObjectMatch activate;
 
-    bool isEnabled(const std::string &name) const
+    /**
+     * Set by loggers that record messages without formatting them. The
+     * arguments of such messages are encoded with RawArgs into the
+     * buffer returned by beginRaw() instead of being formatted.
+     */
+    bool recordsRaw = false;
+
+    /**
+     * Start recording an unformatted message.
+     *
+     * @return Buffer to encode the message arguments into. It must be
+     * passed to endRaw() once all arguments have been added.
+     */
+    virtual std::vector<uint8_t> &
+    beginRaw(Tick when, const std::string &name, const std::string &flag,
+             const char *fmt, unsigned num_args)
+    {
+        panic("Logger does not support raw messages.\n");
+    }
+
+    /** Finish recording an unformatted message. */
+    virtual void endRaw(std::vector<uint8_t> &buf) {}
+
+    /** Match a name against the ignore and activate expressions. */
+    bool matchName(const std::string &name) const;
+
+    /**
+     * Look up the result of matchName() in a per-thread cache, so that
+     * names are only matched against the expressions once per change of
+     * the expressions.
+     */
+    bool lookupEnabled(const std::string &name) const;
+
+  public:
+    /** Note a change of the ignore or activate expressions. */
+    static void filtersChanged();
+
+    /**
+     * Check if messages of the named object should be logged. This is
+     * checked by the DPRINTF macros before their arguments are evaluated.
+     */
+    bool
+    isEnabled(const std::string &name) const
     {
         if (name.empty()) // Enable the logger with a empty name.
             return true;
-        bool ignore_match = ignore.match(name);
-        bool activate_match = activate.match(name);
-        if (ignore_match && activate_match)
-            panic("%s in both ignore and activate.\n", name);
-        if (ignore_match)
-            return false;
-        if (!activate.empty() && !activate_match)
-            return false;
-        return true;
+        if (ignore.empty() && activate.empty())
+            return true;
+        return lookupEnabled(name);
     }
 
-  public:
     /** Log a single message */
     template <typename ...Args>
     void dprintf(Tick when, const std::string &name, const char *fmt,
@@ -96,6 +228,13 @@ class Logger
     {
         if (!isEnabled(name))
             return;
+        if (recordsRaw) {
+            auto &buf = beginRaw(when, name, flag, fmt, sizeof...(args));
+            RawArgs raw(buf);
+            (raw.add(args), ...);
+            endRaw(buf);
+            return;
+        }
         std::ostringstream line;
         ccprintf(line, fmt, args...);
         logMessage(when, name, flag, line.str());
@@ -117,16 +256,36 @@ class Logger
     virtual std::ostream &getOstream() = 0;
 
     /** Set objects to ignore */
-    void setIgnore(ObjectMatch &ignore_) { ignore = ignore_; }
+    void
+    setIgnore(ObjectMatch &ignore_)
+    {
+        ignore = ignore_;
+        filtersChanged();
+    }
 
     /** Add objects to ignore */
-    void addIgnore(const ObjectMatch &ignore_) { ignore.add(ignore_); }
+    void
+    addIgnore(const ObjectMatch &ignore_)
+    {
+        ignore.add(ignore_);
+        filtersChanged();
+    }
 
     /** Set objects to activate */
-    void setActivate(ObjectMatch &activate_) { activate = activate_; }
+    void
+    setActivate(ObjectMatch &activate_)
+    {
+        activate = activate_;
+        filtersChanged();
+    }
 
     /** Add objects to activate */
-    void addActivate(const ObjectMatch &activate_) { activate.add(activate_); }
+    void
+    addActivate(const ObjectMatch &activate_)
+    {
+        activate.add(activate_);
+        filtersChanged();
+    }
 
     virtual ~Logger() { }
 };
@@ -148,6 +307,41 @@ class OstreamLogger : public Logger
     std::ostream &getOstream() override { return stream; }
 };
 
+/**
+ * Filter on a half-open range [start, end) of addresses. An inactive
+ * filter matches everything. The filters below are checked by the
+ * DPRINTF_ADDR and DPRINTF_PC macros before the arguments of a message
+ * are evaluated.
+ */
+struct RangeFilter
+{
+    bool active = false;
+    Addr start = 0;
+    Addr end = 0;
+
+    bool
+    match(Addr addr) const
+    {
+        return !active || (addr >= start && addr < end);
+    }
+
+    void
+    set(Addr _start, Addr _end)
+    {
+        active = true;
+        start = _start;
+        end = _end;
+    }
+
+    void clear() { active = false; }
+};
+
+/** Addresses traced by DPRINTF_ADDR, e.g., cache lines. */
+extern RangeFilter addrFilter;
+
+/** Instruction addresses traced by DPRINTF_PC and instruction tracers. */
+extern RangeFilter pcFilter;
+
 /** Get the current global debug logger.  This takes ownership of the given
  *  logger which should be allocated using 'new' */
 Logger *getDebugLogger();
@@ -188,11 +382,20 @@ struct StringWrap
  * debug::Flag some_flag = debug::DMA;
  * DPRINTFV(some_flag, ...);
  *
+ * DPRINTF_ADDR and DPRINTF_PC take an address or a PC after the flag,
+ * and only print when it is within the range of trace::addrFilter or
+ * trace::pcFilter respectively.
+ *
+ * All of the flagged macros check the flag and the object name filters
+ * (and the range filters) before evaluating the message arguments.
+ *
  * \def DDUMP(x, data, count)
  * \def DPRINTF(x, ...)
  * \def DPRINTFS(x, s, ...)
  * \def DPRINTFR(x, ...)
  * \def DPRINTFV(x, ...)
+ * \def DPRINTF_ADDR(x, addr, ...)
+ * \def DPRINTF_PC(x, pc, ...)
  * \def DPRINTFN(...)
  * \def DPRINTFNR(...)
  *
@@ -206,18 +409,26 @@ struct StringWrap
             ::gem5::curTick(), name(), data, count, #x); \
 } while (0)
 
-#define DPRINTF(x, ...) do {                     \
-    if (GEM5_UNLIKELY(TRACING_ON && ::gem5::debug::x)) {   \
-        ::gem5::trace::getDebugLogger()->dprintf_flag(   \
-            ::gem5::curTick(), name(), #x, __VA_ARGS__); \
-    }                                            \
+#define DPRINTF(x, ...) do {                                      \
+    if (GEM5_UNLIKELY(TRACING_ON && ::gem5::debug::x)) {          \
+        auto *_trace_logger = ::gem5::trace::getDebugLogger();    \
+        const std::string &_trace_name = name();                  \
+        if (_trace_logger->isEnabled(_trace_name)) {              \
+            _trace_logger->dprintf_flag(                          \
+                ::gem5::curTick(), _trace_name, #x, __VA_ARGS__); \
+        }                                                         \
+    }                                                             \
 } while (0)
 
-#define DPRINTFS(x, s, ...) do {                        \
+#define DPRINTFS(x, s, ...) do {                                  \
     if (GEM5_UNLIKELY(TRACING_ON && ::gem5::debug::x)) {          \
-        ::gem5::trace::getDebugLogger()->dprintf_flag(          \
-                ::gem5::curTick(), (s)->name(), #x, __VA_ARGS__); \
-    }                                                   \
+        auto *_trace_logger = ::gem5::trace::getDebugLogger();    \
+        const std::string &_trace_name = (s)->name();             \
+        if (_trace_logger->isEnabled(_trace_name)) {              \
+            _trace_logger->dprintf_flag(                          \
+                ::gem5::curTick(), _trace_name, #x, __VA_ARGS__); \
+        }                                                         \
+    }                                                             \
 } while (0)
 
 #define DPRINTFR(x, ...) do {                          \
@@ -227,11 +438,39 @@ struct StringWrap
     }                                                  \
 } while (0)
 
-#define DPRINTFV(x, ...) do {                          \
-    if (GEM5_UNLIKELY(TRACING_ON && (x))) {              \
-        ::gem5::trace::getDebugLogger()->dprintf_flag(         \
-            ::gem5::curTick(), name(), x.name(), __VA_ARGS__); \
-    }                                                  \
+#define DPRINTFV(x, ...) do {                                           \
+    if (GEM5_UNLIKELY(TRACING_ON && (x))) {                             \
+        auto *_trace_logger = ::gem5::trace::getDebugLogger();          \
+        const std::string &_trace_name = name();                        \
+        if (_trace_logger->isEnabled(_trace_name)) {                    \
+            _trace_logger->dprintf_flag(                                \
+                ::gem5::curTick(), _trace_name, x.name(), __VA_ARGS__); \
+        }                                                               \
+    }                                                                   \
+} while (0)
+
+#define DPRINTF_ADDR(x, addr, ...) do {                           \
+    if (GEM5_UNLIKELY(TRACING_ON && ::gem5::debug::x) &&          \
+            ::gem5::trace::addrFilter.match(addr)) {              \
+        auto *_trace_logger = ::gem5::trace::getDebugLogger();    \
+        const std::string &_trace_name = name();                  \
+        if (_trace_logger->isEnabled(_trace_name)) {              \
+            _trace_logger->dprintf_flag(                          \
+                ::gem5::curTick(), _trace_name, #x, __VA_ARGS__); \
+        }                                                         \
+    }                                                             \
+} while (0)
+
+#define DPRINTF_PC(x, pc, ...) do {                               \
+    if (GEM5_UNLIKELY(TRACING_ON && ::gem5::debug::x) &&          \
+            ::gem5::trace::pcFilter.match(pc)) {                  \
+        auto *_trace_logger = ::gem5::trace::getDebugLogger();    \
+        const std::string &_trace_name = name();                  \
+        if (_trace_logger->isEnabled(_trace_name)) {              \
+            _trace_logger->dprintf_flag(                          \
+                ::gem5::curTick(), _trace_name, #x, __VA_ARGS__); \
+        }                                                         \
+    }                                                             \
 } while (0)
 
 #define DPRINTFN(...) do {                                                \
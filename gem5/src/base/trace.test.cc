@@ -657,3 +657,103 @@ TEST(TraceTest, GlobalName)
     DPRINTF(TraceTestDebugFlag, "Test message");
     ASSERT_EQ(getString(trace::output()), "");
 }
+
+/** Test that the arguments of ignored objects are not evaluated. */
+TEST(TraceTest, MacroDPRINTFIgnoreArgs)
+{
+    StringWrap name("Foo");
+    int evaluated = 0;
+    auto arg = [&]() { return ++evaluated; };
+
+    trace::enable();
+    EXPECT_TRUE(debug::changeFlag("TraceTestDebugFlag", true));
+    EXPECT_TRUE(debug::changeFlag("FmtFlag", true));
+    ObjectMatch ignore_foo("Foo");
+    trace::getDebugLogger()->setIgnore(ignore_foo);
+    DPRINTF(TraceTestDebugFlag, "Test %d", arg());
+    ASSERT_EQ(getString(trace::output()), "");
+    ASSERT_EQ(evaluated, 0);
+
+    // Changing the expressions must invalidate the cached match
+    ObjectMatch ignore_none;
+    trace::getDebugLogger()->setIgnore(ignore_none);
+    DPRINTF(TraceTestDebugFlag, "Test %d", arg());
+#if TRACING_ON
+    ASSERT_EQ(getString(trace::output()),
+        "      0: TraceTestDebugFlag: Foo: Test 1");
+    ASSERT_EQ(evaluated, 1);
+#endif
+
+    trace::disable();
+    EXPECT_TRUE(debug::changeFlag("TraceTestDebugFlag", false));
+}
+
+/** Test that cached name matches are per logger. */
+TEST(TraceTest, IgnorePerLogger)
+{
+    std::stringstream ss, ss_ignore;
+    trace::OstreamLogger logger(ss);
+    trace::OstreamLogger logger_ignore(ss_ignore);
+
+    ObjectMatch ignore_foo("Foo");
+    logger_ignore.setIgnore(ignore_foo);
+    ObjectMatch ignore_bar("Bar");
+    logger.setIgnore(ignore_bar);
+
+    ASSERT_TRUE(logger.isEnabled("Foo"));
+    ASSERT_FALSE(logger_ignore.isEnabled("Foo"));
+    ASSERT_FALSE(logger.isEnabled("Bar"));
+    ASSERT_TRUE(logger_ignore.isEnabled("Bar"));
+}
+
+/** Test the address and PC range filters. */
+TEST(TraceTest, RangeFilter)
+{
+    trace::RangeFilter filter;
+    ASSERT_TRUE(filter.match(0));
+    ASSERT_TRUE(filter.match(MaxAddr));
+
+    filter.set(0x1000, 0x2000);
+    ASSERT_FALSE(filter.match(0xfff));
+    ASSERT_TRUE(filter.match(0x1000));
+    ASSERT_TRUE(filter.match(0x1fff));
+    ASSERT_FALSE(filter.match(0x2000));
+
+    filter.clear();
+    ASSERT_TRUE(filter.match(0x2000));
+}
+
+/** Test DPRINTF_ADDR and DPRINTF_PC with tracing on. */
+TEST(TraceTest, MacroDPRINTFRange)
+{
+    StringWrap name("Foo");
+    int evaluated = 0;
+    auto arg = [&]() { return ++evaluated; };
+
+    trace::enable();
+    EXPECT_TRUE(debug::changeFlag("TraceTestDebugFlag", true));
+    EXPECT_TRUE(debug::changeFlag("FmtFlag", true));
+    trace::addrFilter.set(0x1000, 0x2000);
+    trace::pcFilter.set(0x400, 0x500);
+
+    DPRINTF_ADDR(TraceTestDebugFlag, 0x2000, "Test %d", arg());
+    DPRINTF_PC(TraceTestDebugFlag, 0x3ff, "Test %d", arg());
+    ASSERT_EQ(getString(trace::output()), "");
+    ASSERT_EQ(evaluated, 0);
+
+    DPRINTF_ADDR(TraceTestDebugFlag, 0x1040, "Addr %d", arg());
+#if TRACING_ON
+    ASSERT_EQ(getString(trace::output()),
+        "      0: TraceTestDebugFlag: Foo: Addr 1");
+#endif
+    DPRINTF_PC(TraceTestDebugFlag, 0x400, "PC %d", arg());
+#if TRACING_ON
+    ASSERT_EQ(getString(trace::output()),
+        "      0: TraceTestDebugFlag: Foo: PC 2");
+#endif
+
+    trace::addrFilter.clear();
+    trace::pcFilter.clear();
+    trace::disable();
+    EXPECT_TRUE(debug::changeFlag("TraceTestDebugFlag", false));
+}
@@ -391,6 +391,8 @@ BaseCPU::regProbePoints()
     ppRetiredLoads = pmuProbePoint("RetiredLoads");
     ppRetiredStores = pmuProbePoint("RetiredStores");
     ppRetiredBranches = pmuProbePoint("RetiredBranches");
+    ppRetiredBranchInsts = new ProbePointArg<StaticInstPtr>(
+        getProbeManager(), "RetiredBranchInsts");
 
     ppSleeping = new ProbePointArg<bool>(this->getProbeManager(),
                                          "Sleeping");
@@ -410,8 +412,10 @@ BaseCPU::probeInstCommit(const StaticInstPtr &inst, Addr pc)
     if (inst->isStore() || inst->isAtomic())
         ppRetiredStores->notify(1);
 
-    if (inst->isControl())
+    if (inst->isControl()) {
         ppRetiredBranches->notify(1);
+        ppRetiredBranchInsts->notify(inst);
+    }
 }
 
 BaseCPU::
@@ -556,6 +556,12 @@ class BaseCPU : public ClockedObject
     /** Retired branches (any type) */
     probing::PMUUPtr ppRetiredBranches;
 
+    /**
+     * Retired branches, carrying the branch instruction. It is notified
+     * after RetiredInstsPC for the same instruction.
+     */
+    ProbePointArg<StaticInstPtr> *ppRetiredBranchInsts;
+
     /** CPU cycle counter even if any thread Context is suspended*/
     probing::PMUUPtr ppAllCycles;
 
@@ -45,6 +45,71 @@ namespace decode_cache
 template <typename EMI>
 using InstMap = std::unordered_map<EMI, StaticInstPtr>;
 
+/**
+ * A table of decoded instructions shared by every decoder of an ISA
+ * running on the same host thread, so that cores running the same binary
+ * and CPU models switched in part way through a run reuse each other's
+ * work instead of decoding the same text again.
+ *
+ * Entries are keyed by the machine instruction and by a context value
+ * which captures any decoder state that decodeInst() depends on but
+ * which is not part of the machine instruction itself. Since the key is
+ * the instruction encoding rather than its address, entries never go
+ * stale when code is overwritten.
+ *
+ * There is one table per host thread, so each event queue of a parallel
+ * simulation gets its own. StaticInst reference counts are not atomic,
+ * and decoders may update the instructions they get (e.g., their size),
+ * so instruction objects must never be handed to decoders serviced by
+ * another thread.
+ *
+ * @tparam Owner The decoder class, which keeps ISAs that happen to use
+ *         the same ExtMachInst type apart.
+ * @tparam EMI The ISA's ExtMachInst type.
+ */
+template <typename Owner, typename EMI>
+class SharedInstMap
+{
+  private:
+    std::unordered_map<uint64_t, InstMap<EMI>> contexts;
+
+    SharedInstMap() = default;
+
+  public:
+    SharedInstMap(const SharedInstMap &) = delete;
+    SharedInstMap &operator=(const SharedInstMap &) = delete;
+
+    /** The table of the calling host thread. */
+    static SharedInstMap &
+    instance()
+    {
+        thread_local SharedInstMap map;
+        return map;
+    }
+
+    /**
+     * Find a decoded instruction, decoding it if no decoder has yet.
+     *
+     * @param context Decoder state which affects decoding.
+     * @param mach_inst The machine instruction to look up.
+     * @param decode_inst Called to decode mach_inst on a miss.
+     * @return The instruction object shared by the thread's decoders.
+     */
+    template <typename DecodeFn>
+    StaticInstPtr
+    lookup(uint64_t context, const EMI &mach_inst, DecodeFn &&decode_inst)
+    {
+        auto &insts = contexts[context];
+        auto it = insts.find(mach_inst);
+        if (it != insts.end())
+            return it->second;
+
+        StaticInstPtr si = decode_inst();
+        insts.emplace(mach_inst, si);
+        return si;
+    }
+};
+
 /// A sparse map from an Addr to a Value, stored in page chunks.
 template<class Value, Addr CacheChunkShift = 12>
 class AddrMap
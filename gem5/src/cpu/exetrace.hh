@@ -90,7 +90,7 @@ class ExeTracer : public InstTracer
             const StaticInstPtr staticInst, const PCStateBase &pc,
             const StaticInstPtr macroStaticInst=nullptr) override
     {
-        if (!debug::ExecEnable)
+        if (!debug::ExecEnable || !pcFilter.match(pc.instAddr()))
             return NULL;
 
         return new ExeTracerRecord(when, tc,
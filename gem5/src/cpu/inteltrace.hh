@@ -68,7 +68,7 @@ class IntelTrace : public InstTracer
             const StaticInstPtr staticInst, const PCStateBase &pc,
             const StaticInstPtr macroStaticInst = NULL)
     {
-        if (!debug::ExecEnable)
+        if (!debug::ExecEnable || !pcFilter.match(pc.instAddr()))
             return NULL;
 
         return new IntelTraceRecord(when, tc, staticInst, pc, macroStaticInst);
@@ -62,6 +62,10 @@ class CommitPolicy(ScopedEnum):
     vals = ["RoundRobin", "OldestReady"]
 
 
+class IQSelectPolicy(ScopedEnum):
+    vals = ["AgeList", "AgeMatrix", "Checked"]
+
+
 class BaseO3CPU(BaseCPU):
     type = "BaseO3CPU"
     cxx_class = "gem5::o3::CPU"
@@ -177,6 +181,11 @@ class BaseO3CPU(BaseCPU):
     )
 
     numRobs = Param.Unsigned(1, "Number of Reorder Buffers")
+    numRenameCheckpoints = Param.Unsigned(
+        0,
+        "Number of rename map checkpoints per thread, taken at control "
+        "instructions to recover from their squashes (0 disables them)",
+    )
 
     numPhysIntRegs = Param.Unsigned(
         256, "Number of physical integer registers"
@@ -202,6 +211,11 @@ class BaseO3CPU(BaseCPU):
     smtLSQThreshold = Param.Int(100, "SMT LSQ Threshold Sharing Parameter")
     smtIQPolicy = Param.SMTQueuePolicy("Partitioned", "SMT IQ Sharing Policy")
     smtIQThreshold = Param.Int(100, "SMT IQ Threshold Sharing Parameter")
+    iqSelectPolicy = Param.IQSelectPolicy(
+        "AgeList",
+        "How the IQ selects ready instructions: age ordered ready lists, "
+        "an age matrix, or both, checking that they agree",
+    )
     smtROBPolicy = Param.SMTQueuePolicy(
         "Partitioned", "SMT ROB Sharing Policy"
     )
@@ -212,6 +226,11 @@ class BaseO3CPU(BaseCPU):
         TournamentBP(numThreads=Parent.numThreads), "Branch Predictor"
     )
     needsTSO = Param.Bool(False, "Enable TSO Memory model")
+    poisonFreedInsts = Param.Bool(
+        False,
+        "Fill the storage of freed dynamic instructions with a pattern "
+        "to catch dangling references to them",
+    )
 
     recvRespThrottling = Param.Bool(
         False, "Enable load receive response throttling in the LSQ"
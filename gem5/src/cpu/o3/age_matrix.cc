@@ -0,0 +1,227 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cpu/o3/age_matrix.hh"
+
+#include <algorithm>
+#include <cassert>
+
+#include "base/bitfield.hh"
+#include "base/intmath.hh"
+#include "cpu/o3/dyn_inst.hh"
+
+namespace gem5
+{
+
+namespace o3
+{
+
+AgeMatrix::AgeMatrix(size_t size)
+    : numSlots(0), numWords(0)
+{
+    // Use every bit of the words the requested size needs.
+    numWords = std::max<size_t>(divCeil(size, WordBits), 1);
+    numSlots = numWords * WordBits;
+
+    older.resize(numSlots * numWords, 0);
+    valid.resize(numWords, 0);
+    ready.resize(Num_OpClasses * numWords, 0);
+    excluded.resize(numWords, 0);
+    candidates.resize(numWords, 0);
+
+    insts.resize(numSlots);
+    seqNums.resize(numSlots, 0);
+    opClasses.resize(numSlots, No_OpClass);
+
+    clear();
+}
+
+void
+AgeMatrix::insert(const DynInstPtr &inst, OpClass op_class)
+{
+    if (freeSlots.empty())
+        grow();
+
+    const int slot = freeSlots.back();
+    freeSlots.pop_back();
+
+    const InstSeqNum seq_num = inst->seqNum;
+    insts[slot] = inst;
+    seqNums[slot] = seq_num;
+    opClasses[slot] = op_class;
+
+    // Order the new instruction against every other one, in both
+    // directions, since the slot may hold stale bits from a previous
+    // occupant.
+    Word *new_row = row(slot);
+    std::fill(new_row, new_row + numWords, 0);
+    for (size_t w = 0; w < numWords; w++) {
+        for (Word v = valid[w]; v; v &= v - 1) {
+            const int other = w * WordBits + findLsbSet(v);
+            if (seqNums[other] < seq_num) {
+                setBit(new_row, other);
+                clearBit(row(other), slot);
+            } else {
+                setBit(row(other), slot);
+            }
+        }
+    }
+
+    setBit(valid.data(), slot);
+    setBit(readyRow(op_class), slot);
+    if (blocked[op_class])
+        setBit(excluded.data(), slot);
+    numValid++;
+}
+
+void
+AgeMatrix::remove(int slot)
+{
+    assert(insts[slot]);
+
+    clearBit(valid.data(), slot);
+    clearBit(readyRow(opClasses[slot]), slot);
+    clearBit(excluded.data(), slot);
+    insts[slot] = nullptr;
+    freeSlots.push_back(slot);
+    numValid--;
+}
+
+int
+AgeMatrix::select()
+{
+    for (size_t w = 0; w < numWords; w++)
+        candidates[w] = valid[w] & ~excluded[w];
+
+    // The oldest candidate is the one no other candidate is older than.
+    for (size_t w = 0; w < numWords; w++) {
+        for (Word v = candidates[w]; v; v &= v - 1) {
+            const int slot = w * WordBits + findLsbSet(v);
+            const Word *slot_row = row(slot);
+            bool oldest = true;
+            for (size_t k = 0; k < numWords; k++) {
+                if (slot_row[k] & candidates[k]) {
+                    oldest = false;
+                    break;
+                }
+            }
+            if (oldest)
+                return slot;
+        }
+    }
+
+    return NoSlot;
+}
+
+void
+AgeMatrix::block(OpClass op_class)
+{
+    if (blocked[op_class])
+        return;
+
+    blocked[op_class] = true;
+    const Word *class_row = readyRow(op_class);
+    for (size_t w = 0; w < numWords; w++)
+        excluded[w] |= class_row[w];
+}
+
+void
+AgeMatrix::unblockAll()
+{
+    if (blocked.none())
+        return;
+
+    blocked.reset();
+    std::fill(excluded.begin(), excluded.end(), 0);
+}
+
+size_t
+AgeMatrix::size(OpClass op_class) const
+{
+    const Word *class_row = readyRow(op_class);
+    size_t count = 0;
+    for (size_t w = 0; w < numWords; w++)
+        count += popCount(class_row[w]);
+    return count;
+}
+
+void
+AgeMatrix::clear()
+{
+    std::fill(valid.begin(), valid.end(), 0);
+    std::fill(ready.begin(), ready.end(), 0);
+    std::fill(excluded.begin(), excluded.end(), 0);
+    blocked.reset();
+
+    std::fill(insts.begin(), insts.end(), nullptr);
+    numValid = 0;
+
+    // Hand out the lowest slots first.
+    freeSlots.clear();
+    for (int slot = numSlots - 1; slot >= 0; slot--)
+        freeSlots.push_back(slot);
+}
+
+void
+AgeMatrix::grow()
+{
+    const size_t new_words = numWords * 2;
+    const size_t new_slots = new_words * WordBits;
+
+    std::vector<Word> new_older(new_slots * new_words, 0);
+    for (size_t slot = 0; slot < numSlots; slot++) {
+        std::copy(row(slot), row(slot) + numWords,
+                  &new_older[slot * new_words]);
+    }
+    older.swap(new_older);
+
+    std::vector<Word> new_ready(Num_OpClasses * new_words, 0);
+    for (int op_class = 0; op_class < Num_OpClasses; op_class++) {
+        std::copy(readyRow((OpClass)op_class),
+                  readyRow((OpClass)op_class) + numWords,
+                  &new_ready[op_class * new_words]);
+    }
+    ready.swap(new_ready);
+
+    valid.resize(new_words, 0);
+    excluded.resize(new_words, 0);
+    candidates.resize(new_words, 0);
+
+    insts.resize(new_slots);
+    seqNums.resize(new_slots, 0);
+    opClasses.resize(new_slots, No_OpClass);
+
+    for (int slot = new_slots - 1; slot >= (int)numSlots; slot--)
+        freeSlots.push_back(slot);
+
+    numSlots = new_slots;
+    numWords = new_words;
+}
+
+} // namespace o3
+} // namespace gem5
@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_O3_AGE_MATRIX_HH__
+#define __CPU_O3_AGE_MATRIX_HH__
+
+#include <bitset>
+#include <cstdint>
+#include <vector>
+
+#include "cpu/inst_seq.hh"
+#include "cpu/o3/dyn_inst_ptr.hh"
+#include "cpu/op_class.hh"
+
+namespace gem5
+{
+
+namespace o3
+{
+
+/**
+ * Ready instruction selection modelled the way hardware schedulers do it.
+ * Each ready instruction occupies a slot, readiness is a bit vector over
+ * the slots per op class, and an age matrix holds, for every slot, the set
+ * of slots with older instructions. Selecting the oldest ready instruction
+ * is then a bit scan for a candidate with no older candidate.
+ *
+ * Op classes whose functional units are all busy can be blocked for the
+ * rest of the cycle, which removes their instructions from the candidates.
+ * This picks instructions in the same order as the age ordered ready lists
+ * of the InstructionQueue.
+ *
+ * The matrix is sized for the IQ, but it grows if squashed instructions
+ * that have not been selected yet keep more slots busy than that.
+ */
+class AgeMatrix
+{
+  public:
+    /** Returned by select() when no instruction can be picked. */
+    static constexpr int NoSlot = -1;
+
+    AgeMatrix(size_t size);
+
+    /** Add a ready instruction. */
+    void insert(const DynInstPtr &inst, OpClass op_class);
+
+    /** Remove the instruction in a slot. */
+    void remove(int slot);
+
+    /**
+     * Find the oldest ready instruction whose op class is not blocked.
+     * @return Its slot, or NoSlot.
+     */
+    int select();
+
+    const DynInstPtr &inst(int slot) const { return insts[slot]; }
+    OpClass opClass(int slot) const { return opClasses[slot]; }
+
+    /** Skip the instructions of an op class until unblockAll(). */
+    void block(OpClass op_class);
+    void unblockAll();
+
+    bool empty() const { return numValid == 0; }
+    size_t size() const { return numValid; }
+
+    /** Number of ready instructions of an op class. */
+    size_t size(OpClass op_class) const;
+
+    /** Remove all the instructions. */
+    void clear();
+
+  private:
+    typedef uint64_t Word;
+    static constexpr size_t WordBits = 64;
+
+    Word *row(int slot) { return &older[slot * numWords]; }
+    const Word *row(int slot) const { return &older[slot * numWords]; }
+
+    Word *readyRow(OpClass op_class) { return &ready[op_class * numWords]; }
+    const Word *
+    readyRow(OpClass op_class) const
+    {
+        return &ready[op_class * numWords];
+    }
+
+    static void
+    setBit(Word *v, int i)
+    {
+        v[i / WordBits] |= 1ULL << (i % WordBits);
+    }
+
+    static void
+    clearBit(Word *v, int i)
+    {
+        v[i / WordBits] &= ~(1ULL << (i % WordBits));
+    }
+
+    /** Double the number of slots. */
+    void grow();
+
+    size_t numSlots;
+    size_t numWords;
+    size_t numValid = 0;
+
+    /** Row i has bit j set if slot j holds an older instruction. */
+    std::vector<Word> older;
+    /** Slots holding an instruction. */
+    std::vector<Word> valid;
+    /** Slots holding a ready instruction, per op class. */
+    std::vector<Word> ready;
+    /** Slots of blocked op classes. */
+    std::vector<Word> excluded;
+    /** Scratch space for select(). */
+    std::vector<Word> candidates;
+
+    std::bitset<Num_OpClasses> blocked;
+
+    std::vector<DynInstPtr> insts;
+    std::vector<InstSeqNum> seqNums;
+    std::vector<OpClass> opClasses;
+    std::vector<int> freeSlots;
+};
+
+} // namespace o3
+} // namespace gem5
+
+#endif // __CPU_O3_AGE_MATRIX_HH__
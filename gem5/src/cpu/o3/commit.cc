@@ -564,7 +564,8 @@ Commit::squashFromSquashAfter(ThreadID tid)
 void
 Commit::squashAfter(ThreadID tid, const DynInstPtr &head_inst)
 {
-    DPRINTF(Commit, "Executing squash after for [tid:%i] inst [sn:%llu]\n",
+    DPRINTF_PC(Commit, head_inst->pcState().instAddr(),
+            "Executing squash after for [tid:%i] inst [sn:%llu]\n",
             tid, head_inst->seqNum);
 
     assert(!squashAfterInst[tid] || squashAfterInst[tid] == head_inst);
@@ -614,7 +615,8 @@ Commit::tick()
 
             [[maybe_unused]] const DynInstPtr &inst = rob->readHeadInst(tid);
 
-            DPRINTF(Commit,"[tid:%i] Instruction [sn:%llu] PC %s is head of"
+            DPRINTF_PC(Commit, inst->pcState().instAddr(),
+                    "[tid:%i] Instruction [sn:%llu] PC %s is head of"
                     " ROB and ready to commit\n",
                     tid, inst->seqNum, inst->pcState());
 
@@ -623,7 +625,8 @@ Commit::tick()
 
             ppCommitStall->notify(inst);
 
-            DPRINTF(Commit,"[tid:%i] Can't commit, Instruction [sn:%llu] PC "
+            DPRINTF_PC(Commit, inst->pcState().instAddr(),
+                    "[tid:%i] Can't commit, Instruction [sn:%llu] PC "
                     "%s is head of ROB and not ready\n",
                     tid, inst->seqNum, inst->pcState());
         }
@@ -656,7 +659,7 @@ Commit::handleInterrupt()
 
     // Wait until all in flight instructions are finished before enterring
     // the interrupt.
-    if (canHandleInterrupts && cpu->instList.empty()) {
+    if (canHandleInterrupts && cpu->instListsEmpty()) {
         // Squash or record that I need to squash this cycle if
         // an interrupt needed to be handled.
         DPRINTF(Commit, "Interrupt detected.\n");
@@ -690,7 +693,7 @@ Commit::handleInterrupt()
         DPRINTF(Commit, "Interrupt pending: instruction is %sin "
                 "flight, ROB is %sempty\n",
                 canHandleInterrupts ? "not " : "",
-                cpu->instList.empty() ? "" : "not " );
+                cpu->instListsEmpty() ? "" : "not " );
     }
 }
 
@@ -922,7 +925,7 @@ Commit::commitInsts()
 
         assert(tid == commit_thread);
 
-        DPRINTF(Commit,
+        DPRINTF_PC(Commit, head_inst->pcState().instAddr(),
                 "Trying to commit head instruction, [tid:%i] [sn:%llu]\n",
                 tid, head_inst->seqNum);
 
@@ -1066,7 +1069,8 @@ Commit::commitInsts()
                     onInstBoundary && cpu->checkInterrupts(0))
                     squashAfter(tid, head_inst);
             } else {
-                DPRINTF(Commit, "Unable to commit head instruction PC:%s "
+                DPRINTF_PC(Commit, head_inst->pcState().instAddr(),
+                        "Unable to commit head instruction PC:%s "
                         "[tid:%i] [sn:%llu].\n",
                         head_inst->pcState(), tid ,head_inst->seqNum);
                 break;
@@ -1099,14 +1103,14 @@ Commit::commitHead(const DynInstPtr &head_inst, unsigned inst_num)
                || head_inst->isAtomic()
                || (head_inst->isLoad() && head_inst->strictlyOrdered()));
 
-        DPRINTF(Commit,
+        DPRINTF_PC(Commit, head_inst->pcState().instAddr(),
                 "Encountered a barrier or non-speculative "
                 "instruction [tid:%i] [sn:%llu] "
                 "at the head of the ROB, PC %s.\n",
                 tid, head_inst->seqNum, head_inst->pcState());
 
         if (inst_num > 0 || iewStage->hasStoresToWB(tid)) {
-            DPRINTF(Commit,
+            DPRINTF_PC(Commit, head_inst->pcState().instAddr(),
                     "[tid:%i] [sn:%llu] "
                     "Waiting for all stores to writeback.\n",
                     tid, head_inst->seqNum);
@@ -1120,7 +1124,8 @@ Commit::commitHead(const DynInstPtr &head_inst, unsigned inst_num)
         head_inst->clearCanCommit();
 
         if (head_inst->isLoad() && head_inst->strictlyOrdered()) {
-            DPRINTF(Commit, "[tid:%i] [sn:%llu] "
+            DPRINTF_PC(Commit, head_inst->pcState().instAddr(),
+                    "[tid:%i] [sn:%llu] "
                     "Strictly ordered load, PC %s.\n",
                     tid, head_inst->seqNum, head_inst->pcState());
             toIEW->commitInfo[tid].strictlyOrdered = true;
@@ -1141,7 +1146,8 @@ Commit::commitHead(const DynInstPtr &head_inst, unsigned inst_num)
     if (inst_fault != NoFault && head_inst->inHtmTransactionalState()) {
         // There exists a generic HTM fault common to all ISAs
         if (!std::dynamic_pointer_cast<GenericHtmFailureFault>(inst_fault)) {
-            DPRINTF(HtmCpu, "%s - fault (%s) encountered within transaction"
+            DPRINTF_PC(HtmCpu, head_inst->pcState().instAddr(),
+                            "%s - fault (%s) encountered within transaction"
                             " - converting to GenericHtmFailureFault\n",
             head_inst->staticInst->getName(), inst_fault->name());
             inst_fault = std::make_shared<GenericHtmFailureFault>(
@@ -1158,11 +1164,12 @@ Commit::commitHead(const DynInstPtr &head_inst, unsigned inst_num)
     }
 
     if (inst_fault != NoFault) {
-        DPRINTF(Commit, "Inst [tid:%i] [sn:%llu] PC %s has a fault\n",
+        DPRINTF_PC(Commit, head_inst->pcState().instAddr(),
+                "Inst [tid:%i] [sn:%llu] PC %s has a fault\n",
                 tid, head_inst->seqNum, head_inst->pcState());
 
         if (iewStage->hasStoresToWB(tid) || inst_num > 0) {
-            DPRINTF(Commit,
+            DPRINTF_PC(Commit, head_inst->pcState().instAddr(),
                     "[tid:%i] [sn:%llu] "
                     "Stores outstanding, fault must wait.\n",
                     tid, head_inst->seqNum);
@@ -1199,7 +1206,7 @@ Commit::commitHead(const DynInstPtr &head_inst, unsigned inst_num)
 
         commitStatus[tid] = TrapPending;
 
-        DPRINTF(Commit,
+        DPRINTF_PC(Commit, head_inst->pcState().instAddr(),
             "[tid:%i] [sn:%llu] Committing instruction with fault\n",
             tid, head_inst->seqNum);
         if (head_inst->traceData) {
@@ -1224,7 +1231,7 @@ Commit::commitHead(const DynInstPtr &head_inst, unsigned inst_num)
 
     updateComInstStats(head_inst);
 
-    DPRINTF(Commit,
+    DPRINTF_PC(Commit, head_inst->pcState().instAddr(),
             "[tid:%i] [sn:%llu] Committing instruction with PC %s\n",
             tid, head_inst->seqNum, head_inst->pcState());
     if (head_inst->traceData) {
@@ -1235,7 +1242,7 @@ Commit::commitHead(const DynInstPtr &head_inst, unsigned inst_num)
         head_inst->traceData = NULL;
     }
     if (head_inst->isReturn()) {
-        DPRINTF(Commit,
+        DPRINTF_PC(Commit, head_inst->pcState().instAddr(),
                 "[tid:%i] [sn:%llu] Return Instruction Committed PC %s \n",
                 tid, head_inst->seqNum, head_inst->pcState());
     }
@@ -1285,7 +1292,8 @@ Commit::getInsts()
             commitStatus[tid] != TrapPending) {
             changedROBNumEntries[tid] = true;
 
-            DPRINTF(Commit, "[tid:%i] [sn:%llu] Inserting PC %s into ROB.\n",
+            DPRINTF_PC(Commit, inst->pcState().instAddr(),
+                    "[tid:%i] [sn:%llu] Inserting PC %s into ROB.\n",
                     tid, inst->seqNum, inst->pcState());
 
             rob->insertInst(inst);
@@ -1294,7 +1302,8 @@ Commit::getInsts()
 
             youngestSeqNum[tid] = inst->seqNum;
         } else {
-            DPRINTF(Commit, "[tid:%i] [sn:%llu] "
+            DPRINTF_PC(Commit, inst->pcState().instAddr(),
+                    "[tid:%i] [sn:%llu] "
                     "Instruction PC %s was squashed, skipping.\n",
                     tid, inst->seqNum, inst->pcState());
         }
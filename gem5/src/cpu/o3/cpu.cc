@@ -80,6 +80,7 @@ CPU::CPU(const BaseO3CPUParams &params)
 #ifndef NDEBUG
       instcount(0),
 #endif
+      instPool(new DynInstPool(params.poisonFreedInsts)),
       removeInstsThisCycle(false),
       bac(this, params),
       ftq(this, params),
@@ -132,6 +133,10 @@ CPU::CPU(const BaseO3CPUParams &params)
         _status = SwitchedOut;
     }
 
+    // Instructions in flight are in the ROB or in the front end.
+    for (ThreadID tid = 0; tid < params.numThreads; tid++)
+        instList[tid].reserve(params.numROBEntries + params.fetchQueueSize);
+
     if (params.checker) {
         BaseCPU *temp_checker = params.checker;
         checker = dynamic_cast<Checker<DynInstPtr> *>(temp_checker);
@@ -326,6 +331,13 @@ CPU::CPU(const BaseO3CPUParams &params)
     }
 }
 
+CPU::~CPU()
+{
+    // Instructions still referenced by the pipeline return their storage
+    // to the pool as they are destroyed, after this.
+    instPool->close();
+}
+
 void
 CPU::regProbePoints()
 {
@@ -823,7 +835,7 @@ CPU::isCpuDrained() const
 {
     bool drained(true);
 
-    if (!instList.empty() || !removeList.empty()) {
+    if (!instListsEmpty() || !removeList.empty()) {
         DPRINTF(Drain, "Main CPU structures not drained.\n");
         drained = false;
     }
@@ -1151,9 +1163,17 @@ CPU::squashFromTC(ThreadID tid)
 CPU::ListIt
 CPU::addInst(const DynInstPtr &inst)
 {
-    instList.push_back(inst);
+    return instList[inst->threadNumber].push_back(inst);
+}
 
-    return --(instList.end());
+bool
+CPU::instListsEmpty() const
+{
+    for (ThreadID tid = 0; tid < MaxThreads; tid++) {
+        if (!instList[tid].empty())
+            return false;
+    }
+    return true;
 }
 
 void
@@ -1198,11 +1218,11 @@ CPU::removeInstsNotInROB(ThreadID tid)
 
     bool rob_empty = false;
 
-    if (instList.empty()) {
+    if (instList[tid].empty()) {
         return;
     } else if (rob.isEmpty(tid)) {
         DPRINTF(O3CPU, "ROB is empty, squashing all insts.\n");
-        end_it = instList.begin();
+        end_it = instList[tid].begin();
         rob_empty = true;
     } else {
         end_it = (rob.readTailInst(tid))->getInstListIt();
@@ -1211,14 +1231,12 @@ CPU::removeInstsNotInROB(ThreadID tid)
 
     removeInstsThisCycle = true;
 
-    ListIt inst_it = instList.end();
-
-    inst_it--;
+    ListIt inst_it = --instList[tid].end();
 
     // Walk through the instruction list, removing any instructions
     // that were inserted after the given instruction iterator, end_it.
     while (inst_it != end_it) {
-        assert(!instList.empty());
+        assert(!instList[tid].empty());
 
         squashInstIt(inst_it, tid);
 
@@ -1235,35 +1253,32 @@ CPU::removeInstsNotInROB(ThreadID tid)
 void
 CPU::removeInstsUntil(const InstSeqNum &seq_num, ThreadID tid)
 {
-    assert(!instList.empty());
+    assert(!instList[tid].empty());
 
     removeInstsThisCycle = true;
 
-    ListIt inst_iter = instList.end();
-
-    inst_iter--;
+    ListIt inst_iter = --instList[tid].end();
 
     DPRINTF(O3CPU, "Deleting instructions from instruction "
             "list that are from [tid:%i] and above [sn:%lli] (end=%lli).\n",
             tid, seq_num, (*inst_iter)->seqNum);
 
-    while ((*inst_iter)->seqNum > seq_num) {
-
-        bool break_loop = (inst_iter == instList.begin());
+    // Entries that are already removed are left as holes in the list.
+    while (!*inst_iter || (*inst_iter)->seqNum > seq_num) {
 
         squashInstIt(inst_iter, tid);
 
-        inst_iter--;
-
-        if (break_loop)
+        if (inst_iter == instList[tid].begin())
             break;
+
+        inst_iter--;
     }
 }
 
 void
 CPU::squashInstIt(const ListIt &instIt, ThreadID tid)
 {
-    if ((*instIt)->threadNumber == tid) {
+    if (*instIt && (*instIt)->threadNumber == tid) {
         DPRINTF(O3CPU, "Squashing instruction, "
                 "[tid:%i] [sn:%lli] PC %s\n",
                 (*instIt)->threadNumber,
@@ -1290,7 +1305,8 @@ CPU::cleanUpRemovedInsts()
                 (*removeList.front())->seqNum,
                 (*removeList.front())->pcState());
 
-        instList.erase(removeList.front());
+        instList[(*removeList.front())->threadNumber].erase(
+                removeList.front());
 
         removeList.pop();
     }
@@ -1309,19 +1325,25 @@ CPU::dumpInsts()
 {
     int num = 0;
 
-    ListIt inst_list_it = instList.begin();
-
     cprintf("Dumping Instruction List\n");
 
-    while (inst_list_it != instList.end()) {
-        cprintf("Instruction:%i\nPC:%#x\n[tid:%i]\n[sn:%lli]\nIssued:%i\n"
-                "Squashed:%i\n\n",
-                num, (*inst_list_it)->pcState().instAddr(),
-                (*inst_list_it)->threadNumber,
-                (*inst_list_it)->seqNum, (*inst_list_it)->isIssued(),
-                (*inst_list_it)->isSquashed());
-        inst_list_it++;
-        ++num;
+    for (ThreadID tid = 0; tid < numThreads; tid++) {
+        ListIt inst_list_it = instList[tid].begin();
+
+        while (inst_list_it != instList[tid].end()) {
+            if (!*inst_list_it) {
+                inst_list_it++;
+                continue;
+            }
+            cprintf("Instruction:%i\nPC:%#x\n[tid:%i]\n[sn:%lli]\n"
+                    "Issued:%i\nSquashed:%i\n\n",
+                    num, (*inst_list_it)->pcState().instAddr(),
+                    (*inst_list_it)->threadNumber,
+                    (*inst_list_it)->seqNum, (*inst_list_it)->isIssued(),
+                    (*inst_list_it)->isSquashed());
+            inst_list_it++;
+            ++num;
+        }
     }
 }
 /*
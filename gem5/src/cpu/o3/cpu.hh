@@ -56,11 +56,13 @@
 #include "cpu/o3/comm.hh"
 #include "cpu/o3/commit.hh"
 #include "cpu/o3/decode.hh"
+#include "cpu/o3/dyn_inst_pool.hh"
 #include "cpu/o3/dyn_inst_ptr.hh"
 #include "cpu/o3/fetch.hh"
 #include "cpu/o3/free_list.hh"
 #include "cpu/o3/ftq.hh"
 #include "cpu/o3/iew.hh"
+#include "cpu/o3/inst_window.hh"
 #include "cpu/o3/limits.hh"
 #include "cpu/o3/rename.hh"
 #include "cpu/o3/rob.hh"
@@ -96,7 +98,7 @@ class ThreadContext;
 class CPU : public BaseCPU
 {
   public:
-    typedef std::list<DynInstPtr>::iterator ListIt;
+    typedef InstWindow::iterator ListIt;
 
     friend class ThreadContext;
 
@@ -176,6 +178,8 @@ class CPU : public BaseCPU
     /** Constructs a CPU with the given parameters. */
     CPU(const BaseO3CPUParams &params);
 
+    ~CPU();
+
     ProbePointArg<PacketPtr> *ppInstAccessComplete;
     ProbePointArg<std::pair<DynInstPtr, PacketPtr> > *ppDataAccessComplete;
 
@@ -386,8 +390,18 @@ class CPU : public BaseCPU
     int instcount;
 #endif
 
-    /** List of all the instructions in flight. */
-    std::list<DynInstPtr> instList;
+    /** Recycles the storage of this CPU's DynInsts. */
+    DynInstPool *instPool;
+
+    /**
+     * Lists of all the instructions in flight, one per thread so that the
+     * instructions one thread squashes don't leave holes between those of
+     * another thread.
+     */
+    InstWindow instList[MaxThreads];
+
+    /** Whether no thread has instructions in flight. */
+    bool instListsEmpty() const;
 
     /** List of all the instructions that will be removed at the end of this
      *  cycle.
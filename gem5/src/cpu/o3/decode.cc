@@ -301,7 +301,8 @@ Decode::unblock(ThreadID tid)
 void
 Decode::squash(const DynInstPtr &inst, bool control_miss, ThreadID tid)
 {
-    DPRINTF(Decode, "[tid:%i] [sn:%llu] Squashing due to incorrect branch "
+    DPRINTF_PC(Decode, inst->pcState().instAddr(),
+            "[tid:%i] [sn:%llu] Squashing due to incorrect branch "
             "prediction detected at decode.\n", tid, inst->seqNum);
 
     // Send back mispredict information.
@@ -417,7 +418,8 @@ Decode::skidInsert(ThreadID tid)
 
         skidBuffer[tid].push(inst);
 
-        DPRINTF(Decode, "Inserting [tid:%d][sn:%lli] PC: %s into decode "
+        DPRINTF_PC(Decode, inst->pcState().instAddr(),
+                "Inserting [tid:%d][sn:%lli] PC: %s into decode "
                 "skidBuffer %i\n", inst->threadNumber, inst->seqNum,
                 inst->pcState(), skidBuffer[tid].size());
     }
@@ -671,11 +673,13 @@ Decode::decodeInsts(ThreadID tid)
 
         insts_to_decode.pop();
 
-        DPRINTF(Decode, "[tid:%i] Processing instruction [sn:%lli] with "
+        DPRINTF_PC(Decode, inst->pcState().instAddr(),
+                "[tid:%i] Processing instruction [sn:%lli] with "
                 "PC %s\n", tid, inst->seqNum, inst->pcState());
 
         if (inst->isSquashed()) {
-            DPRINTF(Decode, "[tid:%i] Instruction %i with PC %s is "
+            DPRINTF_PC(Decode, inst->pcState().instAddr(),
+                    "[tid:%i] Instruction %i with PC %s is "
                     "squashed, skipping.\n",
                     tid, inst->seqNum, inst->pcState());
 
@@ -740,7 +744,7 @@ Decode::decodeInsts(ThreadID tid)
                 // a check at the end
                 squash(inst, false, inst->threadNumber);
 
-                DPRINTF(Decode,
+                DPRINTF_PC(Decode, inst->pcState().instAddr(),
                         "[tid:%i] [sn:%llu] "
                         "Updating predictions: Wrong predicted target: %s \
                         PredPC: %s\n",
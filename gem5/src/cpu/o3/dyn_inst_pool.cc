@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cpu/o3/dyn_inst_pool.hh"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <new>
+
+#include "base/intmath.hh"
+#include "base/logging.hh"
+
+namespace gem5
+{
+
+namespace o3
+{
+
+DynInstPool::DynInstPool(bool poison) : poison(poison)
+{}
+
+DynInstPool::~DynInstPool()
+{
+    for (auto slab: slabs)
+        ::operator delete(slab);
+}
+
+void *
+DynInstPool::allocate(size_t size)
+{
+    const uint32_t bucket = divCeil(sizeof(Header) + size, Granularity);
+    if (bucket >= freeLists.size())
+        freeLists.resize(bucket + 1);
+
+    auto &free_list = freeLists[bucket];
+    if (free_list.empty())
+        refill(bucket);
+
+    Header *hdr = free_list.back();
+    free_list.pop_back();
+
+    if (poison)
+        checkPoison(hdr);
+
+    hdr->free = false;
+    live++;
+    return hdr + 1;
+}
+
+void *
+DynInstPool::allocateUnpooled(size_t size)
+{
+    Header *hdr = (Header *)::operator new(sizeof(Header) + size);
+    hdr->pool = nullptr;
+    hdr->bucket = 0;
+    hdr->free = false;
+    return hdr + 1;
+}
+
+void
+DynInstPool::release(void *ptr)
+{
+    Header *hdr = (Header *)ptr - 1;
+    panic_if(hdr->free, "DynInst buffer %p was freed twice.", ptr);
+
+    if (hdr->pool)
+        hdr->pool->recycle(hdr);
+    else
+        ::operator delete(hdr);
+}
+
+void
+DynInstPool::close()
+{
+    closed = true;
+    if (live == 0)
+        delete this;
+}
+
+void
+DynInstPool::refill(uint32_t bucket)
+{
+    const size_t buf_size = bucket * Granularity;
+    const size_t count = std::max<size_t>(SlabSize / buf_size, 1);
+
+    uint8_t *slab = (uint8_t *)::operator new(count * buf_size);
+    slabs.push_back(slab);
+
+    auto &free_list = freeLists[bucket];
+    free_list.reserve(free_list.size() + count);
+    // Push in reverse so that buffers are handed out in address order.
+    for (size_t i = count; i > 0; i--) {
+        Header *hdr = (Header *)(slab + (i - 1) * buf_size);
+        hdr->pool = this;
+        hdr->bucket = bucket;
+        hdr->free = true;
+        if (poison)
+            poisonBuffer(hdr);
+        free_list.push_back(hdr);
+    }
+}
+
+void
+DynInstPool::recycle(Header *hdr)
+{
+    hdr->free = true;
+    if (poison)
+        poisonBuffer(hdr);
+    freeLists[hdr->bucket].push_back(hdr);
+
+    assert(live > 0);
+    if (--live == 0 && closed)
+        delete this;
+}
+
+void
+DynInstPool::poisonBuffer(Header *hdr)
+{
+    std::memset(hdr + 1, PoisonByte,
+                hdr->bucket * Granularity - sizeof(Header));
+}
+
+void
+DynInstPool::checkPoison(Header *hdr)
+{
+    const uint8_t *payload = (const uint8_t *)(hdr + 1);
+    const size_t size = hdr->bucket * Granularity - sizeof(Header);
+    for (size_t i = 0; i < size; i++) {
+        panic_if(payload[i] != PoisonByte,
+                 "DynInst buffer %p was written at offset %d after it was "
+                 "freed, there is a dangling DynInstPtr.", payload, i);
+    }
+}
+
+} // namespace o3
+} // namespace gem5
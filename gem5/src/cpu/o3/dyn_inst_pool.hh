@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_O3_DYN_INST_POOL_HH__
+#define __CPU_O3_DYN_INST_POOL_HH__
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace gem5
+{
+
+namespace o3
+{
+
+/**
+ * Recycles the storage of the DynInsts of one CPU. A DynInst and its
+ * operand arrays live in a single buffer whose size depends on the number
+ * of operands, so buffers are bucketed by size, carved out of larger slabs,
+ * and put back on the free list of their bucket once the last reference to
+ * the instruction goes away.
+ *
+ * Every buffer starts with a small header that records the pool and bucket
+ * it came from, which lets DynInst::operator delete find its way back
+ * without knowing the CPU. Buffers allocated without a pool are plain heap
+ * allocations with a header that says so.
+ *
+ * In poison mode freed buffers are filled with a known pattern, so that a
+ * dangling DynInstPtr reads obvious garbage, and the pattern is checked
+ * when the buffer is handed out again to catch writes after free.
+ *
+ * The owner of the pool calls close() instead of deleting it. The pool
+ * then deletes itself once the last instruction it handed out is freed,
+ * since DynInstPtrs may outlive the CPU's pipeline structures.
+ */
+class DynInstPool
+{
+  public:
+    explicit DynInstPool(bool poison);
+
+    /** Get a buffer of at least size bytes. */
+    void *allocate(size_t size);
+
+    /** Get a buffer of at least size bytes that is not recycled. */
+    static void *allocateUnpooled(size_t size);
+
+    /** Return a buffer obtained from either allocation function. */
+    static void release(void *ptr);
+
+    /** Give up ownership of the pool. */
+    void close();
+
+    /** Number of buffers handed out and not released yet. */
+    size_t outstanding() const { return live; }
+
+  private:
+    ~DynInstPool();
+
+    struct alignas(std::max_align_t) Header
+    {
+        DynInstPool *pool;
+        uint32_t bucket;
+        bool free;
+    };
+
+    /** Buffer sizes, header included, are multiples of this. */
+    static constexpr size_t Granularity = 64;
+    /** Target size of the slabs buffers are carved out of. */
+    static constexpr size_t SlabSize = 16 * 1024;
+    /** Byte freed buffers are filled with in poison mode. */
+    static constexpr uint8_t PoisonByte = 0x5a;
+
+    /** Carve a new slab into free buffers for a bucket. */
+    void refill(uint32_t bucket);
+
+    /** Put a buffer back on the free list of its bucket. */
+    void recycle(Header *hdr);
+
+    /** Fill the payload of a buffer with the poison pattern. */
+    void poisonBuffer(Header *hdr);
+
+    /** Check that the payload of a free buffer is still poisoned. */
+    void checkPoison(Header *hdr);
+
+    /** Free buffers, indexed by size in units of Granularity. */
+    std::vector<std::vector<Header *>> freeLists;
+
+    /** All the slabs the pool allocated. */
+    std::vector<void *> slabs;
+
+    size_t live = 0;
+    bool closed = false;
+    const bool poison;
+};
+
+} // namespace o3
+} // namespace gem5
+
+#endif // __CPU_O3_DYN_INST_POOL_HH__
@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstring>
+#include <set>
+#include <vector>
+
+#include "base/gtest/logging.hh"
+#include "cpu/o3/dyn_inst_pool.hh"
+
+using namespace gem5;
+
+/** Test that released buffers are handed out again. */
+TEST(DynInstPoolTest, Reuse)
+{
+    auto *pool = new o3::DynInstPool(false);
+
+    void *a = pool->allocate(200);
+    void *b = pool->allocate(200);
+    EXPECT_NE(a, b);
+    EXPECT_EQ(pool->outstanding(), 2);
+
+    o3::DynInstPool::release(a);
+    EXPECT_EQ(pool->outstanding(), 1);
+    EXPECT_EQ(pool->allocate(200), a);
+
+    o3::DynInstPool::release(a);
+    o3::DynInstPool::release(b);
+    EXPECT_EQ(pool->outstanding(), 0);
+    pool->close();
+}
+
+/** Test that buffers are usable and don't overlap. */
+TEST(DynInstPoolTest, Allocate)
+{
+    auto *pool = new o3::DynInstPool(false);
+
+    // Enough buffers of several sizes to need more than one slab each.
+    std::vector<std::pair<uint8_t *, size_t>> bufs;
+    for (int i = 0; i < 1000; ++i) {
+        const size_t size = 100 + (i % 4) * 300;
+        auto *buf = (uint8_t *)pool->allocate(size);
+        EXPECT_EQ((uintptr_t)buf % alignof(std::max_align_t), 0);
+        std::memset(buf, i & 0xff, size);
+        bufs.emplace_back(buf, size);
+    }
+    EXPECT_EQ(pool->outstanding(), 1000);
+
+    for (int i = 0; i < 1000; ++i) {
+        const auto [buf, size] = bufs[i];
+        for (size_t j = 0; j < size; ++j)
+            ASSERT_EQ(buf[j], i & 0xff);
+    }
+
+    // Buffers of one size only come back for requests of that size.
+    std::set<void *> freed;
+    for (int i = 0; i < 1000; i += 4) {
+        o3::DynInstPool::release(bufs[i].first);
+        freed.insert(bufs[i].first);
+    }
+    std::vector<void *> reused;
+    for (int i = 0; i < 250; ++i) {
+        reused.push_back(pool->allocate(1000));
+        EXPECT_EQ(freed.count(reused.back()), 0);
+    }
+    for (int i = 0; i < 250; ++i) {
+        reused.push_back(pool->allocate(100));
+        EXPECT_EQ(freed.count(reused.back()), 1);
+    }
+    EXPECT_EQ(pool->outstanding(), 1250);
+
+    for (int i = 0; i < 1000; ++i) {
+        if (i % 4)
+            o3::DynInstPool::release(bufs[i].first);
+    }
+    for (auto *buf : reused)
+        o3::DynInstPool::release(buf);
+    EXPECT_EQ(pool->outstanding(), 0);
+    pool->close();
+}
+
+/** Test buffers that don't come from a pool. */
+TEST(DynInstPoolTest, Unpooled)
+{
+    void *buf = o3::DynInstPool::allocateUnpooled(100);
+    std::memset(buf, 0, 100);
+    o3::DynInstPool::release(buf);
+}
+
+/** Test that the pool outlives close() until every buffer is back. */
+TEST(DynInstPoolTest, CloseWithOutstanding)
+{
+    auto *pool = new o3::DynInstPool(true);
+    void *buf = pool->allocate(100);
+    pool->close();
+
+    // The pool is still around, so the buffer can be written and freed.
+    std::memset(buf, 0, 100);
+    o3::DynInstPool::release(buf);
+}
+
+/** Test that freeing a buffer twice is caught. */
+TEST(DynInstPoolDeathTest, DoubleFree)
+{
+    auto *pool = new o3::DynInstPool(false);
+    void *a = pool->allocate(100);
+    void *b = pool->allocate(100);
+    o3::DynInstPool::release(a);
+
+    gtestLogOutput.str("");
+    EXPECT_ANY_THROW(o3::DynInstPool::release(a));
+    EXPECT_NE(gtestLogOutput.str().find("was freed twice"),
+              std::string::npos);
+
+    o3::DynInstPool::release(b);
+    pool->close();
+}
+
+/** Test that freed buffers are poisoned in poison mode. */
+TEST(DynInstPoolTest, Poison)
+{
+    auto *pool = new o3::DynInstPool(true);
+    auto *buf = (uint8_t *)pool->allocate(100);
+    std::memset(buf, 0, 100);
+    o3::DynInstPool::release(buf);
+
+    // A dangling pointer reads the poison pattern.
+    for (size_t i = 0; i < 100; ++i)
+        ASSERT_EQ(buf[i], 0x5a);
+
+    // An intact buffer is handed out again without complaint.
+    EXPECT_EQ(pool->allocate(100), buf);
+    o3::DynInstPool::release(buf);
+    pool->close();
+}
+
+/** Test that writes to a freed buffer are caught when it is reused. */
+TEST(DynInstPoolDeathTest, WriteAfterFree)
+{
+    auto *pool = new o3::DynInstPool(true);
+    auto *buf = (uint8_t *)pool->allocate(100);
+    o3::DynInstPool::release(buf);
+
+    buf[42] = 0;
+    gtestLogOutput.str("");
+    EXPECT_ANY_THROW(pool->allocate(100));
+    EXPECT_NE(gtestLogOutput.str().find("written at offset 42"),
+              std::string::npos);
+    pool->close();
+}
@@ -381,7 +381,7 @@ Fetch::processCacheCompletion(PacketPtr pkt)
         
         if(enableStarvationEMISSARY){
             if(fromDecode->decodeIdle[tid]  && pkt->req->getVaddr() == fetchBufferBlockPC) {
-                RequestPtr mem_req2 = std::make_shared<Request>(
+                RequestPtr mem_req2 = Request::create(
                     pkt->req->getVaddr(), fetchBufferSize,
                     Request::INST_FETCH, cpu->instRequestorId(), pkt->req->getPC(),
                     cpu->thread[tid]->contextId());
@@ -585,7 +585,7 @@ Fetch::fetchCacheLine(Addr vaddr, ThreadID tid, Addr pc)
     // Setup the memReq to do a read of the first instruction's address.
     // Set the appropriate read size and flags as well.
     // Build request here.
-    RequestPtr mem_req = std::make_shared<Request>(
+    RequestPtr mem_req = Request::create(
         fetchBufferBlockPC, fetchBufferSize,
         Request::INST_FETCH, cpu->instRequestorId(), pc,
         cpu->thread[tid]->contextId());
@@ -921,7 +921,8 @@ Fetch::tick()
         if (!stalls[tid].decode && !fetchQueue[tid].empty()) {
             const auto& inst = fetchQueue[tid].front();
             toDecode->insts[toDecode->size++] = inst;
-            DPRINTF(Fetch, "[tid:%i] [sn:%llu] Sending instruction to decode "
+            DPRINTF_PC(Fetch, inst->pcState().instAddr(),
+                    "[tid:%i] [sn:%llu] Sending instruction to decode "
                     "from fetch queue. Fetch queue size: %i.\n",
                     tid, inst->seqNum, fetchQueue[tid].size());
 
@@ -1041,6 +1042,7 @@ Fetch::buildInst(ThreadID tid, StaticInstPtr staticInst,
     DynInst::Arrays arrays;
     arrays.numSrcs = staticInst->numSrcRegs();
     arrays.numDests = staticInst->numDestRegs();
+    arrays.pool = cpu->instPool;
 
     // Create a new DynInst from the instruction fetched.
     DynInstPtr instruction = new (arrays) DynInst(
@@ -1049,10 +1051,12 @@ Fetch::buildInst(ThreadID tid, StaticInstPtr staticInst,
 
     instruction->setThreadState(cpu->thread[tid]);
 
-    DPRINTF(Fetch, "[tid:%i] Instruction PC %s created [sn:%lli].\n",
+    DPRINTF_PC(Fetch, this_pc.instAddr(),
+            "[tid:%i] Instruction PC %s created [sn:%lli].\n",
             tid, this_pc, seq);
 
-    DPRINTF(Fetch, "[tid:%i] Instruction is: %s\n", tid,
+    DPRINTF_PC(Fetch, this_pc.instAddr(),
+            "[tid:%i] Instruction is: %s\n", tid,
             instruction->staticInst->disassemble(this_pc.instAddr()));
 
 #if TRACING_ON
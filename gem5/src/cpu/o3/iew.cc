@@ -444,7 +444,8 @@ IEW::squash(ThreadID tid)
 void
 IEW::squashDueToBranch(const DynInstPtr& inst, ThreadID tid)
 {
-    DPRINTF(IEW, "[tid:%i] [sn:%llu] Squashing from a specific instruction,"
+    DPRINTF_PC(IEW, inst->pcState().instAddr(),
+            "[tid:%i] [sn:%llu] Squashing from a specific instruction,"
             " PC: %s "
             "\n", tid, inst->seqNum, inst->pcState() );
 
@@ -468,7 +469,8 @@ IEW::squashDueToBranch(const DynInstPtr& inst, ThreadID tid)
 void
 IEW::squashDueToMemOrder(const DynInstPtr& inst, ThreadID tid)
 {
-    DPRINTF(IEW, "[tid:%i] Memory violation, squashing violator and younger "
+    DPRINTF_PC(IEW, inst->pcState().instAddr(),
+            "[tid:%i] Memory violation, squashing violator and younger "
             "insts, PC: %s [sn:%llu].\n", tid, inst->pcState(), inst->seqNum);
     // Need to include inst->seqNum in the following comparison to cover the
     // corner case when a branch misprediction and a memory violation for the
@@ -599,7 +601,8 @@ IEW::skidInsert(ThreadID tid)
 
         insts[tid].pop();
 
-        DPRINTF(IEW,"[tid:%i] Inserting [sn:%lli] PC:%s into "
+        DPRINTF_PC(IEW, inst->pcState().instAddr(),
+                "[tid:%i] Inserting [sn:%lli] PC:%s into "
                 "dispatch skidBuffer %i\n",tid, inst->seqNum,
                 inst->pcState(),tid);
 
@@ -888,7 +891,8 @@ IEW::dispatchInsts(ThreadID tid)
         // Make sure there's a valid instruction there.
         assert(inst);
 
-        DPRINTF(IEW, "[tid:%i] Issue: Adding PC %s [sn:%lli] [tid:%i] to "
+        DPRINTF_PC(IEW, inst->pcState().instAddr(),
+                "[tid:%i] Issue: Adding PC %s [sn:%lli] [tid:%i] to "
                 "IQ.\n",
                 tid, inst->pcState(), inst->seqNum, inst->threadNumber);
 
@@ -938,7 +942,8 @@ IEW::dispatchInsts(ThreadID tid)
         if ((inst->isAtomic() && ldstQueue.sqFull(tid)) ||
             (inst->isLoad() && ldstQueue.lqFull(tid)) ||
             (inst->isStore() && ldstQueue.sqFull(tid))) {
-            DPRINTF(IEW, "[tid:%i] Issue: %s has become full.\n",tid,
+            DPRINTF_PC(IEW, inst->pcState().instAddr(),
+                    "[tid:%i] Issue: %s has become full.\n",tid,
                     inst->isLoad() ? "LQ" : "SQ");
 
             // Call function to start blocking.
@@ -1139,7 +1144,8 @@ IEW::executeInsts()
 
         DynInstPtr inst = instQueue.getInstToExecute();
 
-        DPRINTF(IEW, "Execute: Processing PC %s, [tid:%i] [sn:%llu].\n",
+        DPRINTF_PC(IEW, inst->pcState().instAddr(),
+                "Execute: Processing PC %s, [tid:%i] [sn:%llu].\n",
                 inst->pcState(), inst->threadNumber,inst->seqNum);
 
         // Notify potential listeners that this instruction has started
@@ -1148,7 +1154,8 @@ IEW::executeInsts()
 
         // Check if the instruction is squashed; if so then skip it
         if (inst->isSquashed()) {
-            DPRINTF(IEW, "Execute: Instruction was squashed. PC: %s, [tid:%i]"
+            DPRINTF_PC(IEW, inst->pcState().instAddr(),
+                         "Execute: Instruction was squashed. PC: %s, [tid:%i]"
                          " [sn:%llu]\n", inst->pcState(), inst->threadNumber,
                          inst->seqNum);
 
@@ -1277,13 +1284,16 @@ IEW::executeInsts()
             if (inst->mispredicted() && !loadNotExecuted) {
                 fetchRedirect[tid] = true;
 
-                DPRINTF(IEW, "[tid:%i] [sn:%llu] Execute: "
+                DPRINTF_PC(IEW, inst->pcState().instAddr(),
+                        "[tid:%i] [sn:%llu] Execute: "
                         "Branch mispredict detected.\n",
                         tid, inst->seqNum);
-                DPRINTF(IEW, "[tid:%i] [sn:%llu] "
+                DPRINTF_PC(IEW, inst->pcState().instAddr(),
+                        "[tid:%i] [sn:%llu] "
                         "Predicted target was PC: %s\n",
                         tid, inst->seqNum, inst->readPredTarg());
-                DPRINTF(IEW, "[tid:%i] [sn:%llu] Execute: "
+                DPRINTF_PC(IEW, inst->pcState().instAddr(),
+                        "[tid:%i] [sn:%llu] Execute: "
                         "Redirecting fetch to PC: %s\n",
                         tid, inst->seqNum, inst->pcState());
                 // If incorrect, then signal the ROB that it must be squashed.
@@ -1304,7 +1314,8 @@ IEW::executeInsts()
                 DynInstPtr violator;
                 violator = ldstQueue.getMemDepViolator(tid);
 
-                DPRINTF(IEW, "LDSTQ detected a violation. Violator PC: %s "
+                DPRINTF_PC(IEW, inst->pcState().instAddr(),
+                        "LDSTQ detected a violation. Violator PC: %s "
                         "[sn:%lli], inst PC: %s [sn:%lli]. Addr is: %#x.\n",
                         violator->pcState(), violator->seqNum,
                         inst->pcState(), inst->seqNum, inst->physEffAddr);
@@ -1327,7 +1338,8 @@ IEW::executeInsts()
 
                 DynInstPtr violator = ldstQueue.getMemDepViolator(tid);
 
-                DPRINTF(IEW, "LDSTQ detected a violation.  Violator PC: "
+                DPRINTF_PC(IEW, inst->pcState().instAddr(),
+                        "LDSTQ detected a violation.  Violator PC: "
                         "%s, inst PC: %s.  Addr is: %#x.\n",
                         violator->pcState(), inst->pcState(),
                         inst->physEffAddr);
@@ -1370,7 +1382,8 @@ IEW::writebackInsts()
         DynInstPtr inst = toCommit->insts[inst_num];
         ThreadID tid = inst->threadNumber;
 
-        DPRINTF(IEW, "Sending instructions to commit, [sn:%lli] PC %s.\n",
+        DPRINTF_PC(IEW, inst->pcState().instAddr(),
+                "Sending instructions to commit, [sn:%lli] PC %s.\n",
                 inst->seqNum, inst->pcState());
 
         iewStats.instsToCommit[tid]++;
@@ -1391,7 +1404,8 @@ IEW::writebackInsts()
                 // Mark register as ready if not pinned
                 if (inst->renamedDestIdx(i)->
                         getNumPinnedWritesToComplete() == 0) {
-                    DPRINTF(IEW,"Setting Destination Register %i (%s)\n",
+                    DPRINTF_PC(IEW, inst->pcState().instAddr(),
+                            "Setting Destination Register %i (%s)\n",
                             inst->renamedDestIdx(i)->index(),
                             inst->renamedDestIdx(i)->className());
                     scoreboard->setReg(inst->renamedDestIdx(i));
@@ -1571,12 +1585,15 @@ IEW::checkMisprediction(const DynInstPtr& inst)
         if (inst->mispredicted()) {
             fetchRedirect[tid] = true;
 
-            DPRINTF(IEW, "[tid:%i] [sn:%llu] Execute: "
+            DPRINTF_PC(IEW, inst->pcState().instAddr(),
+                    "[tid:%i] [sn:%llu] Execute: "
                     "Branch mispredict detected.\n",
                     tid, inst->seqNum);
-            DPRINTF(IEW, "[tid:%i] [sn:%llu] Predicted target was PC: %s\n",
+            DPRINTF_PC(IEW, inst->pcState().instAddr(),
+                    "[tid:%i] [sn:%llu] Predicted target was PC: %s\n",
                     tid, inst->seqNum, inst->readPredTarg());
-            DPRINTF(IEW, "[tid:%i] [sn:%llu] Execute: "
+            DPRINTF_PC(IEW, inst->pcState().instAddr(),
+                    "[tid:%i] [sn:%llu] Execute: "
                     "Redirecting fetch to PC: %s\n",
                     tid, inst->seqNum, inst->pcState());
             // If incorrect, then signal the ROB that it must be squashed.
@@ -89,7 +89,9 @@ InstructionQueue::InstructionQueue(CPU *cpu_ptr, IEW *iew_ptr,
     : cpu(cpu_ptr),
       iewStage(iew_ptr),
       fuPool(params.fuPool),
+      readyMatrix(params.numIQEntries),
       iqPolicy(params.smtIQPolicy),
+      selectPolicy(params.iqSelectPolicy),
       numThreads(params.numThreads),
       numEntries(params.numIQEntries),
       totalWidth(params.issueWidth),
@@ -124,6 +126,12 @@ InstructionQueue::InstructionQueue(CPU *cpu_ptr, IEW *iew_ptr,
         memDepUnit[tid].setIQ(this);
     }
 
+    // Instructions are kept in the list until they commit, so the list
+    // holds as many instructions as the ROB.
+    for (ThreadID tid = 0; tid < numThreads; tid++) {
+        instList[tid].reserve(params.numROBEntries);
+    }
+
     resetState();
 
     //Figure out resource sharing policy
@@ -423,6 +431,7 @@ InstructionQueue::resetState()
     }
     nonSpecInsts.clear();
     listOrder.clear();
+    readyMatrix.clear();
     deferredMemInsts.clear();
     blockedMemInsts.clear();
     retryMemInsts.clear();
@@ -541,7 +550,7 @@ InstructionQueue::isFull(ThreadID tid)
 bool
 InstructionQueue::hasReadyInsts()
 {
-    if (!listOrder.empty()) {
+    if (!listOrder.empty() || !readyMatrix.empty()) {
         return true;
     }
 
@@ -720,6 +729,28 @@ InstructionQueue::moveToYoungerInst(ListOrderIt list_order_it)
     readyIt[op_class] = listOrder.insert(next_it, queue_entry);
 }
 
+void
+InstructionQueue::removeFromReadyList(OpClass op_class,
+        ListOrderIt &order_it, int slot)
+{
+    if (usesAgeMatrix())
+        readyMatrix.remove(slot);
+
+    if (!usesAgeList())
+        return;
+
+    readyInsts[op_class].pop();
+
+    if (!readyInsts[op_class].empty()) {
+        moveToYoungerInst(order_it);
+    } else {
+        readyIt[op_class] = listOrder.end();
+        queueOnList[op_class] = false;
+    }
+
+    listOrder.erase(order_it++);
+}
+
 void
 InstructionQueue::processFUCompletion(const DynInstPtr &inst, int fu_idx)
 {
@@ -769,16 +800,50 @@ InstructionQueue::scheduleReadyInsts()
     // Increment the iterator.
     // This will avoid trying to schedule a certain op class if there are no
     // FUs that handle it.
+    //
+    // The age matrix picks the same instructions by scanning for the
+    // oldest ready one whose op class has not run out of FUs this cycle.
     int total_issued = 0;
     ListOrderIt order_it = listOrder.begin();
     ListOrderIt order_end_it = listOrder.end();
+    readyMatrix.unblockAll();
+
+    while (total_issued < totalWidth) {
+        OpClass op_class;
+        DynInstPtr issuing_inst;
+        int slot = AgeMatrix::NoSlot;
+
+        if (usesAgeMatrix())
+            slot = readyMatrix.select();
+
+        if (usesAgeList()) {
+            if (order_it == order_end_it) {
+                panic_if(slot != AgeMatrix::NoSlot,
+                         "Age matrix selected [sn:%llu] while no "
+                         "instruction is ready.",
+                         readyMatrix.inst(slot)->seqNum);
+                break;
+            }
 
-    while (total_issued < totalWidth && order_it != order_end_it) {
-        OpClass op_class = (*order_it).queueType;
+            op_class = (*order_it).queueType;
 
-        assert(!readyInsts[op_class].empty());
+            assert(!readyInsts[op_class].empty());
 
-        DynInstPtr issuing_inst = readyInsts[op_class].top();
+            issuing_inst = readyInsts[op_class].top();
+
+            assert(issuing_inst->seqNum == (*order_it).oldestInst);
+
+            panic_if(usesAgeMatrix() && (slot == AgeMatrix::NoSlot ||
+                        readyMatrix.inst(slot) != issuing_inst),
+                     "Age matrix did not select [sn:%llu].",
+                     issuing_inst->seqNum);
+        } else {
+            if (slot == AgeMatrix::NoSlot)
+                break;
+
+            op_class = readyMatrix.opClass(slot);
+            issuing_inst = readyMatrix.inst(slot);
+        }
 
         if (issuing_inst->isFloating()) {
             iqIOStats.fpInstQueueReads++;
@@ -788,19 +853,8 @@ InstructionQueue::scheduleReadyInsts()
             iqIOStats.intInstQueueReads++;
         }
 
-        assert(issuing_inst->seqNum == (*order_it).oldestInst);
-
         if (issuing_inst->isSquashed()) {
-            readyInsts[op_class].pop();
-
-            if (!readyInsts[op_class].empty()) {
-                moveToYoungerInst(order_it);
-            } else {
-                readyIt[op_class] = listOrder.end();
-                queueOnList[op_class] = false;
-            }
-
-            listOrder.erase(order_it++);
+            removeFromReadyList(op_class, order_it, slot);
 
             ++iqStats.squashedInstsIssued;
 
@@ -872,14 +926,7 @@ InstructionQueue::scheduleReadyInsts()
                     tid, issuing_inst->pcState(),
                     issuing_inst->seqNum);
 
-            readyInsts[op_class].pop();
-
-            if (!readyInsts[op_class].empty()) {
-                moveToYoungerInst(order_it);
-            } else {
-                readyIt[op_class] = listOrder.end();
-                queueOnList[op_class] = false;
-            }
+            removeFromReadyList(op_class, order_it, slot);
 
             issuing_inst->setIssued();
             ++total_issued;
@@ -901,13 +948,15 @@ InstructionQueue::scheduleReadyInsts()
                 memDepUnit[tid].issue(issuing_inst);
             }
 
-            listOrder.erase(order_it++);
             iqStats.statIssuedInstType[tid][op_class]++;
         } else {
             assert(idx == FUPool::NoFreeFU);
             iqStats.statFuBusy[op_class]++;
             iqStats.fuBusy[tid]++;
-            ++order_it;
+            if (usesAgeList())
+                ++order_it;
+            if (usesAgeMatrix())
+                readyMatrix.block(op_class);
         }
     }
 
@@ -958,11 +1007,8 @@ InstructionQueue::commit(const InstSeqNum &inst, ThreadID tid)
     DPRINTF(IQ, "[tid:%i] Committing instructions older than [sn:%llu]\n",
             tid,inst);
 
-    ListIt iq_it = instList[tid].begin();
-
-    while (iq_it != instList[tid].end() &&
-           (*iq_it)->seqNum <= inst) {
-        ++iq_it;
+    while (!instList[tid].empty() &&
+           instList[tid].front()->seqNum <= inst) {
         instList[tid].pop_front();
     }
 
@@ -1075,17 +1121,7 @@ InstructionQueue::addReadyMemInst(const DynInstPtr &ready_inst)
 {
     OpClass op_class = ready_inst->opClass();
 
-    readyInsts[op_class].push(ready_inst);
-
-    // Will need to reorder the list if either a queue is not on the list,
-    // or it has an older instruction than last time.
-    if (!queueOnList[op_class]) {
-        addToOrderList(op_class);
-    } else if (readyInsts[op_class].top()->seqNum  <
-               (*readyIt[op_class]).oldestInst) {
-        listOrder.erase(readyIt[op_class]);
-        addToOrderList(op_class);
-    }
+    addToReadyList(ready_inst);
 
     DPRINTF(IQ, "Instruction is ready to issue, putting it onto "
             "the ready list, PC %s opclass:%i [sn:%llu].\n",
@@ -1197,19 +1233,16 @@ InstructionQueue::squash(ThreadID tid)
 void
 InstructionQueue::doSquash(ThreadID tid)
 {
-    // Start at the tail.
-    ListIt squash_it = instList[tid].end();
-    --squash_it;
-
     DPRINTF(IQ, "[tid:%i] Squashing until sequence number %i!\n",
             tid, squashedSeqNum[tid]);
 
     // Squash any instructions younger than the squashed sequence number
-    // given.
-    while (squash_it != instList[tid].end() &&
-           (*squash_it)->seqNum > squashedSeqNum[tid]) {
+    // given. They are all at the tail of the list.
+    while (!instList[tid].empty() &&
+           instList[tid].back()->seqNum > squashedSeqNum[tid]) {
 
-        DynInstPtr squashed_inst = (*squash_it);
+        DynInstPtr squashed_inst = instList[tid].back();
+        instList[tid].pop_back();
         if (squashed_inst->isFloating()) {
             iqIOStats.fpInstQueueWrites++;
         } else if (squashed_inst->isVector()) {
@@ -1219,10 +1252,14 @@ InstructionQueue::doSquash(ThreadID tid)
         }
 
         // Only handle the instruction if it actually is in the IQ and
-        // hasn't already been squashed in the IQ.
+        // hasn't already been squashed in the IQ. Neither can happen for
+        // an instruction in the list: the list is indexed by the thread
+        // of its instructions, and an instruction is only marked as
+        // squashed in the IQ below, right before it leaves the list. So
+        // popping skipped instructions as well does not change what is
+        // left in the list.
         if (squashed_inst->threadNumber != tid ||
             squashed_inst->isSquashedInIQ()) {
-            --squash_it;
             continue;
         }
 
@@ -1331,7 +1368,6 @@ InstructionQueue::doSquash(ThreadID tid)
             assert(dependGraph.empty(dest_reg->flatIndex()));
             dependGraph.clearInst(dest_reg->flatIndex());
         }
-        instList[tid].erase(squash_it--);
         ++iqStats.squashedInstsExamined;
     }
 }
@@ -1450,17 +1486,31 @@ InstructionQueue::addIfReady(const DynInstPtr &inst)
                 "the ready list, PC %s opclass:%i [sn:%llu].\n",
                 inst->pcState(), op_class, inst->seqNum);
 
-        readyInsts[op_class].push(inst);
+        addToReadyList(inst);
+    }
+}
 
-        // Will need to reorder the list if either a queue is not on the list,
-        // or it has an older instruction than last time.
-        if (!queueOnList[op_class]) {
-            addToOrderList(op_class);
-        } else if (readyInsts[op_class].top()->seqNum  <
-                   (*readyIt[op_class]).oldestInst) {
-            listOrder.erase(readyIt[op_class]);
-            addToOrderList(op_class);
-        }
+void
+InstructionQueue::addToReadyList(const DynInstPtr &inst)
+{
+    OpClass op_class = inst->opClass();
+
+    if (usesAgeMatrix())
+        readyMatrix.insert(inst, op_class);
+
+    if (!usesAgeList())
+        return;
+
+    readyInsts[op_class].push(inst);
+
+    // Will need to reorder the list if either a queue is not on the list,
+    // or it has an older instruction than last time.
+    if (!queueOnList[op_class]) {
+        addToOrderList(op_class);
+    } else if (readyInsts[op_class].top()->seqNum  <
+               (*readyIt[op_class]).oldestInst) {
+        listOrder.erase(readyIt[op_class]);
+        addToOrderList(op_class);
     }
 }
 
@@ -1474,7 +1524,8 @@ void
 InstructionQueue::dumpLists()
 {
     for (int i = 0; i < Num_OpClasses; ++i) {
-        cprintf("Ready list %i size: %i\n", i, readyInsts[i].size());
+        cprintf("Ready list %i size: %i\n", i, usesAgeList() ?
+                readyInsts[i].size() : readyMatrix.size((OpClass)i));
 
         cprintf("\n");
     }
@@ -1518,7 +1569,7 @@ InstructionQueue::dumpInsts()
     for (ThreadID tid = 0; tid < numThreads; ++tid) {
         int num = 0;
         int valid_num = 0;
-        ListIt inst_list_it = instList[tid].begin();
+        auto inst_list_it = instList[tid].begin();
 
         while (inst_list_it != instList[tid].end()) {
             cprintf("Instruction:%i\n", num);
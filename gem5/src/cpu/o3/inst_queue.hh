@@ -50,14 +50,17 @@
 #include "base/statistics.hh"
 #include "base/types.hh"
 #include "cpu/inst_seq.hh"
+#include "cpu/o3/age_matrix.hh"
 #include "cpu/o3/comm.hh"
 #include "cpu/o3/dep_graph.hh"
 #include "cpu/o3/dyn_inst_ptr.hh"
+#include "cpu/o3/inst_window.hh"
 #include "cpu/o3/limits.hh"
 #include "cpu/o3/mem_dep_unit.hh"
 #include "cpu/o3/store_set.hh"
 #include "cpu/op_class.hh"
 #include "cpu/timebuf.hh"
+#include "enums/IQSelectPolicy.hh"
 #include "enums/SMTQueuePolicy.hh"
 #include "sim/eventq.hh"
 
@@ -320,8 +323,10 @@ class InstructionQueue
     // Instruction lists, ready queues, and ordering
     //////////////////////////////////////
 
-    /** List of all the instructions in the IQ (some of which may be issued). */
-    std::list<DynInstPtr> instList[MaxThreads];
+    /** List of all the instructions in the IQ (some of which may be issued).
+     *  Instructions stay in the list until they commit.
+     */
+    InstWindow instList[MaxThreads];
 
     /** List of instructions that are ready to be executed. */
     std::list<DynInstPtr> instsToExecute;
@@ -405,6 +410,33 @@ class InstructionQueue
      */
     void moveToYoungerInst(ListOrderIt age_order_it);
 
+    /** Ready instructions kept for the AgeMatrix select policy. */
+    AgeMatrix readyMatrix;
+
+    /** Does the select policy keep the age ordered ready lists? */
+    bool
+    usesAgeList() const
+    {
+        return selectPolicy != IQSelectPolicy::AgeMatrix;
+    }
+
+    /** Does the select policy keep the age matrix? */
+    bool
+    usesAgeMatrix() const
+    {
+        return selectPolicy != IQSelectPolicy::AgeList;
+    }
+
+    /** Put an instruction onto the ready structures of its op class. */
+    void addToReadyList(const DynInstPtr &inst);
+
+    /**
+     * Take the selected instruction off the ready structures, and move
+     * order_it past its age order list entry.
+     */
+    void removeFromReadyList(OpClass op_class, ListOrderIt &order_it,
+                             int slot);
+
     DependencyGraph<DynInstPtr> dependGraph;
 
     //////////////////////////////////////
@@ -414,6 +446,9 @@ class InstructionQueue
     /** IQ sharing policy for SMT. */
     SMTQueuePolicy iqPolicy;
 
+    /** How ready instructions are selected for issue. */
+    const IQSelectPolicy selectPolicy;
+
     /** Number of Total Threads*/
     ThreadID numThreads;
 
@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_O3_INST_WINDOW_HH__
+#define __CPU_O3_INST_WINDOW_HH__
+
+#include <algorithm>
+#include <cstddef>
+
+#include "base/circular_queue.hh"
+#include "cpu/o3/dyn_inst_ptr.hh"
+
+namespace gem5
+{
+
+namespace o3
+{
+
+/**
+ * Program ordered window of in-flight instructions, kept in a circular
+ * buffer instead of a list so that tracking an instruction does not
+ * allocate. Iterators are indices and stay valid until their entry is
+ * removed.
+ *
+ * Entries that are removed from the middle of the window (e.g., when a
+ * memory instruction completes out of order) are left as holes that hold
+ * a null pointer until they reach one of the ends of the window. Removed
+ * entries drop their reference right away. Holes count towards size(),
+ * so a window should only hold the instructions of one thread: another
+ * thread's squashes would otherwise leave holes that can only be trimmed
+ * once this thread's older instructions are gone.
+ *
+ * The window is sized for the structure it models, and grows instead of
+ * overwriting the oldest entry if it ever runs out of space.
+ */
+template <typename InstPtr>
+class BasicInstWindow : public CircularQueue<InstPtr>
+{
+  private:
+    typedef CircularQueue<InstPtr> Base;
+
+  public:
+    typedef typename Base::iterator iterator;
+
+    explicit BasicInstWindow(size_t size=0) : Base(size) {}
+
+    /** Append an instruction, returns an iterator to its entry. */
+    iterator
+    push_back(const InstPtr &inst)
+    {
+        if (this->full())
+            this->reserve(std::max<size_t>(2 * this->capacity(), 16));
+        Base::push_back(inst);
+        return --this->end();
+    }
+
+    /** Remove the oldest entry. */
+    void
+    pop_front()
+    {
+        this->front() = nullptr;
+        Base::pop_front();
+        trimFront();
+    }
+
+    /** Remove the youngest entry. */
+    void
+    pop_back()
+    {
+        this->back() = nullptr;
+        Base::pop_back();
+        trimBack();
+    }
+
+    /** Remove an entry anywhere in the window. */
+    void
+    erase(iterator it)
+    {
+        *it = nullptr;
+        trimFront();
+        trimBack();
+    }
+
+    /** Remove all the entries. */
+    void
+    clear()
+    {
+        while (!this->empty()) {
+            this->back() = nullptr;
+            Base::pop_back();
+        }
+        this->flush();
+    }
+
+  private:
+    /** Drop holes at the head, so that front() is always valid. */
+    void
+    trimFront()
+    {
+        while (!this->empty() && !this->front())
+            Base::pop_front();
+    }
+
+    /** Drop holes at the tail, so that back() is always valid. */
+    void
+    trimBack()
+    {
+        while (!this->empty() && !this->back())
+            Base::pop_back();
+    }
+};
+
+/**
+ * The window is a template only so that it can be named before DynInst
+ * is a complete type.
+ */
+typedef BasicInstWindow<DynInstPtr> InstWindow;
+
+} // namespace o3
+} // namespace gem5
+
+#endif // __CPU_O3_INST_WINDOW_HH__
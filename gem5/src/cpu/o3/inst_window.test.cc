@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <vector>
+
+#include "cpu/o3/inst_window.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+typedef std::shared_ptr<int> Inst;
+typedef o3::BasicInstWindow<Inst> Window;
+
+Inst
+makeInst(int seq_num)
+{
+    return std::make_shared<int>(seq_num);
+}
+
+} // anonymous namespace
+
+/** Test that iterators stay valid while other entries are removed. */
+TEST(InstWindowTest, StableIterators)
+{
+    Window window(8);
+    std::vector<Window::iterator> its;
+    for (int i = 0; i < 6; ++i)
+        its.push_back(window.push_back(makeInst(i)));
+
+    window.erase(its[2]);
+    window.pop_front();
+    window.pop_back();
+
+    for (int i : {1, 3, 4})
+        EXPECT_EQ(**its[i], i);
+    EXPECT_EQ(*window.front(), 1);
+    EXPECT_EQ(*window.back(), 4);
+    // The hole left by the erased entry is still in the window.
+    EXPECT_EQ(window.size(), 4);
+    EXPECT_FALSE(*its[2]);
+}
+
+/** Test that holes are trimmed once they reach an end of the window. */
+TEST(InstWindowTest, TrimHoles)
+{
+    Window window(8);
+    std::vector<Window::iterator> its;
+    for (int i = 0; i < 5; ++i)
+        its.push_back(window.push_back(makeInst(i)));
+
+    // Out of order removals from the middle.
+    window.erase(its[1]);
+    window.erase(its[3]);
+    EXPECT_EQ(window.size(), 5);
+
+    // Removing the ends drops the holes next to them.
+    window.erase(its[0]);
+    EXPECT_EQ(window.size(), 3);
+    EXPECT_EQ(*window.front(), 2);
+    window.erase(its[4]);
+    EXPECT_EQ(window.size(), 1);
+    EXPECT_EQ(*window.back(), 2);
+
+    window.erase(its[2]);
+    EXPECT_TRUE(window.empty());
+}
+
+/** Test that removed entries drop their reference right away. */
+TEST(InstWindowTest, ReleaseOnRemove)
+{
+    Window window(4);
+    Inst inst = makeInst(0);
+    auto it = window.push_back(inst);
+    window.push_back(makeInst(1));
+    EXPECT_EQ(inst.use_count(), 2);
+    window.erase(it);
+    EXPECT_EQ(inst.use_count(), 1);
+}
+
+/** Test that a full window grows and keeps its iterators valid. */
+TEST(InstWindowTest, Grow)
+{
+    Window window(4);
+    std::vector<Window::iterator> its;
+    // Move the head so that the entries wrap around.
+    window.push_back(makeInst(-1));
+    window.pop_front();
+    for (int i = 0; i < 10; ++i)
+        its.push_back(window.push_back(makeInst(i)));
+
+    EXPECT_GE(window.capacity(), 10);
+    EXPECT_EQ(window.size(), 10);
+    for (int i = 0; i < 10; ++i)
+        EXPECT_EQ(**its[i], i);
+}
+
+/**
+ * Test the access pattern of a per-thread window: entries retire from
+ * the front and are squashed from the back. As long as no more entries
+ * than the reserved size are in flight the window never grows.
+ */
+TEST(InstWindowTest, NoGrowthWithinReservedSize)
+{
+    const size_t size = 16;
+    Window window(size);
+    std::vector<Window::iterator> its;
+    int seq_num = 0;
+    for (int round = 0; round < 1000; ++round) {
+        while (window.size() < size)
+            its.push_back(window.push_back(makeInst(seq_num++)));
+
+        // Squash the youngest few, then retire the oldest few.
+        for (int i = 0; i < round % 5 + 1; ++i) {
+            window.erase(its.back());
+            its.pop_back();
+        }
+        for (int i = 0; i < round % 3 + 1; ++i) {
+            window.erase(its.front());
+            its.erase(its.begin());
+        }
+    }
+    EXPECT_EQ(window.capacity(), size);
+}
+
+/** Test that clear() removes the entries and their references. */
+TEST(InstWindowTest, Clear)
+{
+    Window window(4);
+    Inst inst = makeInst(0);
+    window.push_back(inst);
+    window.push_back(makeInst(1));
+    window.clear();
+    EXPECT_TRUE(window.empty());
+    EXPECT_EQ(inst.use_count(), 1);
+}
@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cpu/o3/lsq_addr_index.hh"
+
+#include <algorithm>
+#include <cassert>
+
+#include "base/bitfield.hh"
+#include "base/intmath.hh"
+
+namespace gem5
+{
+
+namespace o3
+{
+
+void
+LSQAddrIndex::init(unsigned block_shift, size_t num_entries)
+{
+    blockShift = block_shift;
+
+    // A couple of buckets per entry keeps chains short even for accesses
+    // that straddle blocks.
+    const size_t num_buckets = std::max<size_t>(
+        2ULL << ceilLog2(std::max<size_t>(num_entries, 1)), 16);
+    buckets.assign(num_buckets, {});
+    bucketMask = num_buckets - 1;
+
+    slots.assign(std::max<size_t>(num_entries, 1), Slot());
+}
+
+uint64_t
+LSQAddrIndex::byteMask(Addr block, Addr addr, Addr end) const
+{
+    // Blocks wider than the mask only match at block granularity.
+    if (blockShift > 6)
+        return ~0ULL;
+
+    const Addr block_start = block << blockShift;
+    const Addr block_end = block_start + (1ULL << blockShift);
+    const unsigned first = std::max(addr, block_start) - block_start;
+    const unsigned last = std::min(end, block_end) - block_start;
+    return mask(last) & ~mask(first);
+}
+
+void
+LSQAddrIndex::insert(ssize_t idx, Addr addr, unsigned size)
+{
+    remove(idx);
+
+    const Addr end = addr + std::max(size, 1U);
+    Slot &slot = slots[idx % slots.size()];
+    assert(!slot.valid);
+    slot.valid = true;
+    slot.idx = idx;
+    slot.firstBlock = addr >> blockShift;
+    slot.lastBlock = (end - 1) >> blockShift;
+
+    for (Addr block = slot.firstBlock; block <= slot.lastBlock; block++)
+        bucket(block).push_back({block, idx, byteMask(block, addr, end)});
+}
+
+void
+LSQAddrIndex::remove(ssize_t idx)
+{
+    Slot &slot = slots[idx % slots.size()];
+    if (!slot.valid || slot.idx != idx)
+        return;
+
+    for (Addr block = slot.firstBlock; block <= slot.lastBlock; block++) {
+        auto &records = bucket(block);
+        for (auto it = records.begin(); it != records.end(); ++it) {
+            if (it->idx == idx && it->block == block) {
+                *it = records.back();
+                records.pop_back();
+                break;
+            }
+        }
+    }
+    slot.valid = false;
+}
+
+void
+LSQAddrIndex::clear()
+{
+    for (auto &records: buckets)
+        records.clear();
+    for (auto &slot: slots)
+        slot.valid = false;
+}
+
+void
+LSQAddrIndex::lookup(Addr addr, unsigned size, bool exact, ssize_t min_idx,
+                     ssize_t max_idx, std::vector<ssize_t> &matches) const
+{
+    matches.clear();
+
+    const Addr end = addr + std::max(size, 1U);
+    const Addr first_block = addr >> blockShift;
+    const Addr last_block = (end - 1) >> blockShift;
+
+    for (Addr block = first_block; block <= last_block; block++) {
+        const uint64_t access_mask =
+            exact ? byteMask(block, addr, end) : ~0ULL;
+        for (const auto &record: bucket(block)) {
+            if (record.block == block && (record.mask & access_mask) &&
+                record.idx >= min_idx && record.idx < max_idx) {
+                matches.push_back(record.idx);
+            }
+        }
+    }
+
+    // Entries that span several blocks of the access show up once per
+    // block.
+    std::sort(matches.begin(), matches.end());
+    if (first_block != last_block) {
+        matches.erase(std::unique(matches.begin(), matches.end()),
+                      matches.end());
+    }
+}
+
+} // namespace o3
+} // namespace gem5
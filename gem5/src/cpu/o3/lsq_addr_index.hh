@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_O3_LSQ_ADDR_INDEX_HH__
+#define __CPU_O3_LSQ_ADDR_INDEX_HH__
+
+#include <cstdint>
+#include <vector>
+
+#include "base/types.hh"
+
+namespace gem5
+{
+
+namespace o3
+{
+
+/**
+ * Address index over the entries of a load or store queue, so that
+ * forwarding and memory order checks only look at the entries that may
+ * overlap an access instead of walking the whole queue.
+ *
+ * The address space is cut into blocks of 2^blockShift bytes. Every entry
+ * is recorded in a hash bucket for each block it touches, together with
+ * a mask of the bytes it covers within that block. Entries are identified
+ * by their (absolute) queue index, and at most one record per queue slot
+ * is kept, so inserting an entry again moves it.
+ */
+class LSQAddrIndex
+{
+  public:
+    LSQAddrIndex() = default;
+
+    /**
+     * @param block_shift Log2 of the block size.
+     * @param num_entries Size of the queue being indexed.
+     */
+    void init(unsigned block_shift, size_t num_entries);
+
+    /** Record the access of a queue entry. */
+    void insert(ssize_t idx, Addr addr, unsigned size);
+
+    /** Forget a queue entry, if it is in the index. */
+    void remove(ssize_t idx);
+
+    /** Forget all the entries. */
+    void clear();
+
+    /**
+     * Collect the queue indices of the entries that overlap an access, in
+     * ascending order and without duplicates.
+     *
+     * @param addr Start of the access.
+     * @param size Size of the access; zero sized accesses cover one byte.
+     * @param exact Match bytes rather than blocks.
+     * @param min_idx Ignore entries below this index.
+     * @param max_idx Ignore entries at or above this index.
+     * @param matches Filled with the indices.
+     */
+    void lookup(Addr addr, unsigned size, bool exact, ssize_t min_idx,
+                ssize_t max_idx, std::vector<ssize_t> &matches) const;
+
+  private:
+    /** Record of an entry for one block. */
+    struct Record
+    {
+        Addr block;
+        ssize_t idx;
+        uint64_t mask;
+    };
+
+    /** Blocks touched by an indexed queue slot. */
+    struct Slot
+    {
+        bool valid = false;
+        ssize_t idx = 0;
+        Addr firstBlock = 0;
+        Addr lastBlock = 0;
+    };
+
+    /** Mask of the bytes of a block that [addr, addr + size) covers. */
+    uint64_t byteMask(Addr block, Addr addr, Addr end) const;
+
+    std::vector<Record> &
+    bucket(Addr block)
+    {
+        return buckets[(block ^ (block >> 13)) & bucketMask];
+    }
+
+    const std::vector<Record> &
+    bucket(Addr block) const
+    {
+        return buckets[(block ^ (block >> 13)) & bucketMask];
+    }
+
+    unsigned blockShift = 3;
+    std::vector<std::vector<Record>> buckets;
+    Addr bucketMask = 0;
+    std::vector<Slot> slots;
+};
+
+} // namespace o3
+} // namespace gem5
+
+#endif // __CPU_O3_LSQ_ADDR_INDEX_HH__
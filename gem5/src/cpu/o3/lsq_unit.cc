@@ -218,6 +218,9 @@ LSQUnit::init(CPU *cpu_ptr, IEW *iew_ptr, const BaseO3CPUParams &params,
     checkLoads = params.LSQCheckLoads;
     needsTSO = params.needsTSO;
 
+    storeIndex.init(3, storeQueue.capacity());
+    loadIndex.init(depCheckShift, loadQueue.capacity());
+
     resetState();
 }
 
@@ -236,6 +239,9 @@ LSQUnit::resetState()
     retryPkt = NULL;
     memDepViolator = NULL;
 
+    storeIndex.clear();
+    loadIndex.clear();
+
     stalled = false;
 
     cacheBlockMask = ~(cpu->cacheLineSize() - 1);
@@ -521,11 +527,16 @@ LSQUnit::checkViolations(typename LoadQueue::iterator& loadIt,
      * however, there isn't a good way in the pipeline at the moment to check
      * all instructions that will execute before the store writes back. Thus,
      * like the implementation that came before it, we're overly conservative.
+     *
+     * Only the younger loads the index finds in the same blocks as this
+     * access can conflict with it, so visit those, oldest first.
      */
-    while (loadIt != loadQueue.end()) {
+    loadIndex.lookup(inst->effAddr, inst->effSize, false, loadIt.idx(),
+                     loadQueue.end().idx(), loadMatches);
+    for (ssize_t load_idx: loadMatches) {
+        loadIt = loadQueue.getIterator(load_idx);
         DynInstPtr ld_inst = loadIt->instruction();
         if (!ld_inst->effAddrValid() || ld_inst->strictlyOrdered()) {
-            ++loadIt;
             continue;
         }
 
@@ -581,8 +592,6 @@ LSQUnit::checkViolations(typename LoadQueue::iterator& loadIt,
                     inst->seqNum, ld_inst->seqNum, ld_eff_addr1);
             }
         }
-
-        ++loadIt;
     }
     return NoFault;
 }
@@ -743,6 +752,7 @@ LSQUnit::commitLoad()
                     inst->lastWakeDependents - inst->firstIssue));
     }
 
+    loadIndex.remove(loadQueue.head());
     loadQueue.front().clear();
     loadQueue.pop_front();
 }
@@ -964,6 +974,7 @@ LSQUnit::squash(const InstSeqNum &squashed_num)
         // Clear the smart pointer to make sure it is decremented.
         loadQueue.back().instruction()->setSquashed();
         loadQueue.back().clear();
+        loadIndex.remove(loadQueue.tail());
 
         loadQueue.pop_back();
         ++stats.squashedLoads;
@@ -1035,6 +1046,7 @@ LSQUnit::squash(const InstSeqNum &squashed_num)
         // memory.  This is quite ugly.  @todo: Figure out the proper
         // place to really handle request deletes.
         storeQueue.back().clear();
+        storeIndex.remove(storeQueue.tail());
 
         storeQueue.pop_back();
         ++stats.squashedStores;
@@ -1158,6 +1170,7 @@ LSQUnit::completeStore(typename StoreQueue::iterator store_idx)
     DynInstPtr store_inst = store_idx->instruction();
     if (store_idx == storeQueue.begin()) {
         do {
+            storeIndex.remove(storeQueue.head());
             storeQueue.front().clear();
             storeQueue.pop_front();
         } while (storeQueue.front().completed() &&
@@ -1328,6 +1341,9 @@ LSQUnit::read(LSQRequest *request, ssize_t load_idx)
     LQEntry& load_entry = loadQueue[load_idx];
     const DynInstPtr& load_inst = load_entry.instruction();
 
+    // The load has a valid address from now on, until it's rescheduled.
+    loadIndex.insert(load_idx, load_inst->effAddr, load_inst->effSize);
+
     load_entry.setRequest(request);
     assert(load_inst);
 
@@ -1345,6 +1361,7 @@ LSQUnit::read(LSQRequest *request, ssize_t load_idx)
         iewStage->rescheduleMemInst(load_inst);
         load_inst->clearIssued();
         load_inst->effAddrValid(false);
+        loadIndex.remove(load_idx);
         ++stats.rescheduledLoads;
         DPRINTF(LSQUnit, "Strictly ordered load [sn:%lli] PC %s\n",
                 load_inst->seqNum, load_inst->pcState());
@@ -1391,13 +1408,27 @@ LSQUnit::read(LSQRequest *request, ssize_t load_idx)
         return NoFault;
     }
 
-    // Check the SQ for any previous stores that might lead to forwarding
+    // Check the SQ for any previous stores that might lead to forwarding.
+    // The index gives the older stores that overlap the load, and down to
+    // the top of the LSQ they are visited youngest first.
     auto store_it = load_inst->sqIt;
     assert (store_it >= storeWBIt);
-    // End once we've reached the top of the LSQ
-    while (store_it != storeWBIt && !load_inst->isDataPrefetch()) {
-        // Move the index to one younger
-        store_it--;
+    storeMatches.clear();
+    if (!load_inst->isDataPrefetch()) {
+        Addr req_s = request->mainReq()->getVaddr();
+        unsigned req_size = request->mainReq()->getSize();
+        // A zero sized load is also covered by a store that ends right
+        // where it starts.
+        if (req_size == 0) {
+            req_s--;
+            req_size = 2;
+        }
+        storeIndex.lookup(req_s, req_size, true, storeWBIt.idx(),
+                          store_it.idx(), storeMatches);
+    }
+    for (auto match = storeMatches.rbegin(); match != storeMatches.rend();
+         ++match) {
+        store_it = storeQueue.getIterator(*match);
         assert(store_it->valid());
         assert(store_it->instruction()->seqNum < load_inst->seqNum);
         int store_size = store_it->size();
@@ -1560,6 +1591,7 @@ LSQUnit::read(LSQRequest *request, ssize_t load_idx)
                 iewStage->rescheduleMemInst(load_inst);
                 load_inst->clearIssued();
                 load_inst->effAddrValid(false);
+                loadIndex.remove(load_idx);
                 ++stats.rescheduledLoads;
 
                 // Do not generate a writeback event as this instruction is not
@@ -1630,6 +1662,14 @@ LSQUnit::write(LSQRequest *request, uint8_t *data, ssize_t store_idx)
     storeQueue[store_idx].setRequest(request);
     unsigned size = request->_size;
     storeQueue[store_idx].size() = size;
+
+    // Loads can only forward from stores that have data.
+    if (size != 0) {
+        storeIndex.insert(store_idx,
+                storeQueue[store_idx].instruction()->effAddr, size);
+    } else {
+        storeIndex.remove(store_idx);
+    }
     bool store_no_data =
         request->mainReq()->getFlags() & Request::STORE_NO_DATA;
     storeQueue[store_idx].isAllZeros() = store_no_data;
@@ -57,6 +57,7 @@
 #include "cpu/o3/cpu.hh"
 #include "cpu/o3/dyn_inst_ptr.hh"
 #include "cpu/o3/lsq.hh"
+#include "cpu/o3/lsq_addr_index.hh"
 #include "cpu/timebuf.hh"
 #include "debug/HtmCpu.hh"
 #include "debug/LSQUnit.hh"
@@ -460,6 +461,20 @@ class LSQUnit
     /** Should loads be checked for dependency issues */
     bool checkLoads;
 
+    /** Index of the stores with data, at 8 byte granularity, used to find
+     * the stores a load may forward from.
+     */
+    LSQAddrIndex storeIndex;
+
+    /** Index of the loads with a valid address, at depCheckShift
+     * granularity, used to find memory order violations.
+     */
+    LSQAddrIndex loadIndex;
+
+    /** Scratch space for index lookups. */
+    std::vector<ssize_t> storeMatches;
+    std::vector<ssize_t> loadMatches;
+
     /** The number of store instructions in the SQ waiting to writeback. */
     int storesToWB;
 
@@ -26,6 +26,7 @@
  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
+#include <algorithm>
 #include <map>
 #include <memory>
 #include <vector>
@@ -68,18 +69,16 @@ MemDepUnit::~MemDepUnit()
 {
     for (ThreadID tid = 0; tid < MaxThreads; tid++) {
 
-        ListIt inst_list_it = instList[tid].begin();
-
         MemDepHashIt hash_it;
 
         while (!instList[tid].empty()) {
-            hash_it = memDepHash.find((*inst_list_it)->seqNum);
+            hash_it = memDepHash.find(instList[tid].front()->seqNum);
 
             assert(hash_it != memDepHash.end());
 
             memDepHash.erase(hash_it);
 
-            instList[tid].erase(inst_list_it++);
+            instList[tid].pop_front();
         }
     }
 
@@ -101,6 +100,9 @@ MemDepUnit::init(const BaseO3CPUParams &params, ThreadID tid, CPU *cpu)
                  params.SSITSize, params.SSITAssoc, params.SSITReplPolicy,
                  params.SSITIndexingPolicy, params.LFSTSize);
 
+    // All the tracked instructions are in the LSQ.
+    instList[tid].reserve(params.LQEntries + params.SQEntries);
+
     std::string stats_group_name = csprintf("MemDepUnit__%i", tid);
     cpu->addStatGroup(stats_group_name.c_str(), &stats);
 }
@@ -202,9 +204,7 @@ MemDepUnit::insert(const DynInstPtr &inst)
     MemDepEntry::memdep_insert++;
 #endif
 
-    instList[tid].push_back(inst);
-
-    inst_entry->listIt = --(instList[tid].end());
+    inst_entry->listIt = instList[tid].push_back(inst);
 
     // Check any barriers and the dependence predictor for any
     // producing memrefs/stores.
@@ -336,9 +336,7 @@ MemDepUnit::insertBarrier(const DynInstPtr &barr_inst)
 #endif
 
     // Add the instruction to the instruction list.
-    instList[tid].push_back(barr_inst);
-
-    inst_entry->listIt = --(instList[tid].end());
+    inst_entry->listIt = instList[tid].push_back(barr_inst);
 
     insertBarrierSN(barr_inst);
 }
@@ -389,8 +387,8 @@ MemDepUnit::replay()
     DynInstPtr temp_inst;
 
     // For now this replay function replays all waiting memory ops.
-    while (!instsToReplay.empty()) {
-        temp_inst = instsToReplay.front();
+    for (size_t idx = 0; idx < instsToReplay.size(); ++idx) {
+        temp_inst = instsToReplay[idx];
 
         MemDepEntryPtr inst_entry = findInHash(temp_inst);
 
@@ -398,9 +396,8 @@ MemDepUnit::replay()
                 temp_inst->pcState(), temp_inst->seqNum);
 
         moveToReady(inst_entry);
-
-        instsToReplay.pop_front();
     }
+    instsToReplay.clear();
 }
 
 void
@@ -522,34 +519,29 @@ MemDepUnit::MemDepEntry::~MemDepEntry()
 void
 MemDepUnit::squash(const InstSeqNum &squashed_num, ThreadID tid)
 {
-    if (!instsToReplay.empty()) {
-        ListIt replay_it = instsToReplay.begin();
-        while (replay_it != instsToReplay.end()) {
-            if ((*replay_it)->threadNumber == tid &&
-                (*replay_it)->seqNum > squashed_num) {
-                instsToReplay.erase(replay_it++);
-            } else {
-                ++replay_it;
-            }
-        }
-    }
-
-    ListIt squash_it = instList[tid].end();
-    --squash_it;
+    instsToReplay.erase(
+        std::remove_if(instsToReplay.begin(), instsToReplay.end(),
+            [tid, squashed_num](const DynInstPtr &inst) {
+                return inst->threadNumber == tid &&
+                    inst->seqNum > squashed_num;
+            }),
+        instsToReplay.end());
 
     MemDepHashIt hash_it;
 
+    // Completed instructions leave holes in the list, but the list never
+    // ends in one.
     while (!instList[tid].empty() &&
-           (*squash_it)->seqNum > squashed_num) {
+           instList[tid].back()->seqNum > squashed_num) {
+        const InstSeqNum seq_num = instList[tid].back()->seqNum;
 
-        DPRINTF(MemDepUnit, "Squashing inst [sn:%lli]\n",
-                (*squash_it)->seqNum);
+        DPRINTF(MemDepUnit, "Squashing inst [sn:%lli]\n", seq_num);
 
-        loadBarrierSNs.erase((*squash_it)->seqNum);
+        loadBarrierSNs.erase(seq_num);
 
-        storeBarrierSNs.erase((*squash_it)->seqNum);
+        storeBarrierSNs.erase(seq_num);
 
-        hash_it = memDepHash.find((*squash_it)->seqNum);
+        hash_it = memDepHash.find(seq_num);
 
         assert(hash_it != memDepHash.end());
 
@@ -562,7 +554,7 @@ MemDepUnit::squash(const InstSeqNum &squashed_num, ThreadID tid)
         MemDepEntry::memdep_erase++;
 #endif
 
-        instList[tid].erase(squash_it--);
+        instList[tid].pop_back();
     }
 
     // Tell the dependency predictor to squash as well.
@@ -623,6 +615,10 @@ MemDepUnit::dumpLists()
         int num = 0;
 
         while (inst_list_it != instList[tid].end()) {
+            if (!*inst_list_it) {
+                inst_list_it++;
+                continue;
+            }
             cprintf("Instruction:%i\nPC: %s\n[sn:%llu]\n[tid:%i]\nIssued:%i\n"
                     "Squashed:%i\n\n",
                     num, (*inst_list_it)->pcState(),
@@ -65,6 +65,7 @@ Rename::Rename(CPU *_cpu, const BaseO3CPUParams &params)
       commitToRenameDelay(params.commitToRenameDelay),
       renameWidth(params.renameWidth),
       numThreads(params.numThreads),
+      numCheckpoints(params.numRenameCheckpoints),
       stats(_cpu)
 {
     if (renameWidth > MaxWidth)
@@ -85,6 +86,8 @@ Rename::Rename(CPU *_cpu, const BaseO3CPUParams &params)
         stalls[tid] = {false, false};
         serializeInst[tid] = nullptr;
         serializeOnNextInst[tid] = false;
+        checkpoints[tid].reserve(numCheckpoints);
+        liveHistory[tid] = historyBuffer[tid].end();
     }
 }
 
@@ -140,6 +143,10 @@ Rename::RenameStats::RenameStats(statistics::Group *parent)
                "Number of HB maps that are committed"),
       ADD_STAT(undoneMaps, statistics::units::Count::get(),
                "Number of HB maps that are undone due to squashing"),
+      ADD_STAT(checkpointRestores, statistics::units::Count::get(),
+               "Number of squashes that restored a rename map checkpoint"),
+      ADD_STAT(checkpointsUnavailable, statistics::units::Count::get(),
+               "Number of control insts renamed with no free checkpoint"),
       ADD_STAT(serializing, statistics::units::Count::get(),
                "count of serializing insts renamed"),
       ADD_STAT(tempSerializing, statistics::units::Count::get(),
@@ -178,6 +185,8 @@ Rename::RenameStats::RenameStats(statistics::Group *parent)
 
     committedMaps.prereq(committedMaps);
     undoneMaps.prereq(undoneMaps);
+    checkpointRestores.prereq(checkpointRestores);
+    checkpointsUnavailable.prereq(checkpointsUnavailable);
     serializing.flags(statistics::total);
     tempSerializing.flags(statistics::total);
     skidInsts.flags(statistics::total);
@@ -299,6 +308,9 @@ Rename::resetStage()
         storesInProgress[tid] = 0;
 
         serializeOnNextInst[tid] = false;
+
+        checkpoints[tid].flush();
+        liveHistory[tid] = historyBuffer[tid].end();
     }
 }
 
@@ -647,14 +659,14 @@ Rename::renameInsts(ThreadID tid)
         insts_to_rename.pop_front();
 
         if (renameStatus[tid] == Unblocking) {
-            DPRINTF(Rename,
+            DPRINTF_PC(Rename, inst->pcState().instAddr(),
                     "[tid:%i] "
                     "Removing [sn:%llu] PC:%s from rename skidBuffer\n",
                     tid, inst->seqNum, inst->pcState());
         }
 
         if (inst->isSquashed()) {
-            DPRINTF(Rename,
+            DPRINTF_PC(Rename, inst->pcState().instAddr(),
                     "[tid:%i] "
                     "instruction %i with PC %s is squashed, skipping.\n",
                     tid, inst->seqNum, inst->pcState());
@@ -667,7 +679,7 @@ Rename::renameInsts(ThreadID tid)
             continue;
         }
 
-        DPRINTF(Rename,
+        DPRINTF_PC(Rename, inst->pcState().instAddr(),
                 "[tid:%i] "
                 "Processing instruction [sn:%llu] with PC %s.\n",
                 tid, inst->seqNum, inst->pcState());
@@ -729,6 +741,9 @@ Rename::renameInsts(ThreadID tid)
 
         renameDestRegs(inst, inst->threadNumber);
 
+        if (numCheckpoints && inst->isControl())
+            takeCheckpoint(inst, tid);
+
         if (inst->isAtomic() || inst->isStore()) {
             storesInProgress[tid]++;
         } else if (inst->isLoad()) {
@@ -783,7 +798,8 @@ Rename::skidInsert(ThreadID tid)
 
         assert(tid == inst->threadNumber);
 
-        DPRINTF(Rename, "[tid:%i] Inserting [sn:%llu] PC: %s into Rename "
+        DPRINTF_PC(Rename, inst->pcState().instAddr(),
+                "[tid:%i] Inserting [sn:%llu] PC: %s into Rename "
                 "skidBuffer\n", tid, inst->seqNum, inst->pcState());
 
         ++stats.skidInsts;
@@ -919,46 +935,97 @@ Rename::unblock(ThreadID tid)
 void
 Rename::doSquash(const InstSeqNum &squashed_seq_num, ThreadID tid)
 {
-    auto hb_it = historyBuffer[tid].begin();
+    auto hb_it = liveHistory[tid];
+
+    // Drop the checkpoints of squashed instructions. If the squashing
+    // instruction has one, it already holds the mappings to go back to,
+    // as well as the position of the youngest history buffer entry to
+    // keep, so that recovery does not depend on the number of squashed
+    // instructions.
+    auto &ckpts = checkpoints[tid];
+    while (!ckpts.empty() && ckpts.back().instSeqNum > squashed_seq_num)
+        ckpts.pop_back();
+
+    if (!ckpts.empty() && ckpts.back().instSeqNum == squashed_seq_num) {
+        DPRINTF(Rename, "[tid:%i] Restoring rename map checkpoint of "
+                "[sn:%llu].\n", tid, squashed_seq_num);
+        renameMap[tid]->restore(ckpts.back().map);
+        hb_it = ckpts.back().history;
+        ++stats.checkpointRestores;
+    } else {
+        // After a syscall squashes everything, the history buffer may be
+        // empty but the ROB may still be squashing instructions.
+        // Go through the most recent instructions, undoing the mappings
+        // they did.
+        while (hb_it != historyBuffer[tid].end() &&
+               hb_it->instSeqNum > squashed_seq_num) {
+            DPRINTF(Rename, "[tid:%i] Undoing history entry with sequence "
+                    "number %i (archReg: %d, newPhysReg: %d, "
+                    "prevPhysReg: %d).\n",
+                    tid, hb_it->instSeqNum, hb_it->archReg.index(),
+                    hb_it->newPhysReg->index(), hb_it->prevPhysReg->index());
+
+            // Undo the rename mapping only if it was really a change.
+            // Special regs that are not really renamed (like misc regs
+            // and the zero reg) can be recognized because the new mapping
+            // is the same as the old one.
+            if (hb_it->newPhysReg != hb_it->prevPhysReg) {
+                // Tell the rename map to set the architected register to
+                // the previous physical register that it was renamed to.
+                renameMap[tid]->setEntry(hb_it->archReg, hb_it->prevPhysReg);
+            }
 
-    // After a syscall squashes everything, the history buffer may be empty
-    // but the ROB may still be squashing instructions.
-    // Go through the most recent instructions, undoing the mappings
-    // they did and freeing up the registers.
-    while (!historyBuffer[tid].empty() &&
-           hb_it->instSeqNum > squashed_seq_num) {
-        assert(hb_it != historyBuffer[tid].end());
+            // Without checkpoints every squashed entry is walked here, so
+            // listeners are told about the squashed mapping right away, as
+            // they were before the entries were kept until commit.
+            if (!numCheckpoints) {
+                ppSquashInRename->notify(std::make_pair(hb_it->instSeqNum,
+                                                        hb_it->newPhysReg));
+            }
+            ++hb_it;
+        }
+    }
+
+    // The live entries are ordered youngest first, so the first one that
+    // is kept is not squashed.
+    assert(hb_it == historyBuffer[tid].end() ||
+           hb_it->instSeqNum <= squashed_seq_num);
+
+    // The phys regs can still be owned by squashing but executing
+    // instructions in IEW at this moment. To avoid ownership hazard in
+    // SMT CPU, the squashed entries stay in the history buffer until
+    // they are indeed squashed in the commit stage, see
+    // freeSquashedHistory().
+    liveHistory[tid] = hb_it;
+}
+
+void
+Rename::freeSquashedHistory(ThreadID tid)
+{
+    auto &hb = historyBuffer[tid];
+    while (hb.begin() != liveHistory[tid]) {
+        auto hb_it = hb.begin();
 
         DPRINTF(Rename, "[tid:%i] Removing history entry with sequence "
                 "number %i (archReg: %d, newPhysReg: %d, prevPhysReg: %d).\n",
                 tid, hb_it->instSeqNum, hb_it->archReg.index(),
                 hb_it->newPhysReg->index(), hb_it->prevPhysReg->index());
 
-        // Undo the rename mapping only if it was really a change.
-        // Special regs that are not really renamed (like misc regs
-        // and the zero reg) can be recognized because the new mapping
-        // is the same as the old one.  While it would be merely a
-        // waste of time to update the rename table, we definitely
-        // don't want to put these on the free list.
-        if (hb_it->newPhysReg != hb_it->prevPhysReg) {
-            // Tell the rename map to set the architected register to the
-            // previous physical register that it was renamed to.
-            renameMap[tid]->setEntry(hb_it->archReg, hb_it->prevPhysReg);
-
-            // The phys regs can still be owned by squashing but
-            // executing instructions in IEW at this moment. To avoid
-            // ownership hazard in SMT CPU, we delay the freelist update
-            // until they are indeed squashed in the commit stage.
-            freeingInProgress[tid].push_back(hb_it->newPhysReg);
-        }
+        // Put the renamed physical register back on the free list, unless
+        // it is one of the special regs that are not really renamed. We
+        // definitely don't want to put these on the free list.
+        if (hb_it->newPhysReg != hb_it->prevPhysReg)
+            freeList->addReg(hb_it->newPhysReg);
 
         // Notify potential listeners that the register mapping needs to be
-        // removed because the instruction it was mapped to got squashed. Note
-        // that this is done before hb_it is incremented.
-        ppSquashInRename->notify(std::make_pair(hb_it->instSeqNum,
-                                                hb_it->newPhysReg));
+        // removed because the instruction it was mapped to got squashed.
+        // Without checkpoints, doSquash() already did.
+        if (numCheckpoints) {
+            ppSquashInRename->notify(std::make_pair(hb_it->instSeqNum,
+                                                    hb_it->newPhysReg));
+        }
 
-        historyBuffer[tid].erase(hb_it++);
+        hb.erase(hb_it);
 
         ++stats.undoneMaps;
     }
@@ -971,6 +1038,12 @@ Rename::removeFromHistory(InstSeqNum inst_seq_num, ThreadID tid)
             "history buffer %u (size=%i), until [sn:%llu].\n",
             tid, tid, historyBuffer[tid].size(), inst_seq_num);
 
+    // Checkpoints of committed instructions can't be restored any more.
+    while (!checkpoints[tid].empty() &&
+           checkpoints[tid].front().instSeqNum <= inst_seq_num) {
+        checkpoints[tid].pop_front();
+    }
+
     auto hb_it = historyBuffer[tid].end();
 
     --hb_it;
@@ -1016,10 +1089,40 @@ Rename::removeFromHistory(InstSeqNum inst_seq_num, ThreadID tid)
 
         ++stats.committedMaps;
 
+        // This entry is the oldest one, so anything pointing at it is now
+        // younger than every entry left in the history buffer.
+        if (liveHistory[tid] == hb_it)
+            liveHistory[tid] = historyBuffer[tid].end();
+        for (auto &ckpt : checkpoints[tid]) {
+            if (ckpt.history != hb_it)
+                break;
+            ckpt.history = historyBuffer[tid].end();
+        }
+
         historyBuffer[tid].erase(hb_it--);
     }
 }
 
+void
+Rename::takeCheckpoint(const DynInstPtr &inst, ThreadID tid)
+{
+    auto &ckpts = checkpoints[tid];
+    if (ckpts.full()) {
+        ++stats.checkpointsUnavailable;
+        return;
+    }
+
+    // Reuse the storage of the slot, it still holds an old checkpoint.
+    ckpts.advance_tail();
+    ckpts.back().instSeqNum = inst->seqNum;
+    ckpts.back().history = liveHistory[tid];
+    renameMap[tid]->checkpoint(ckpts.back().map);
+
+    DPRINTF_PC(Rename, inst->pcState().instAddr(),
+            "[tid:%i] [sn:%llu] Checkpointed the rename map "
+            "(%i checkpoints).\n", tid, inst->seqNum, ckpts.size());
+}
+
 void
 Rename::renameSrcRegs(const DynInstPtr &inst, ThreadID tid)
 {
@@ -1063,7 +1166,7 @@ Rename::renameSrcRegs(const DynInstPtr &inst, ThreadID tid)
             panic("Invalid register class: %d.", flat_reg.classValue());
         }
 
-        DPRINTF(Rename,
+        DPRINTF_PC(Rename, inst->pcState().instAddr(),
                 "[tid:%i] "
                 "Looking up %s arch reg %i, got phys reg %i (%s)\n",
                 tid, flat_reg.className(),
@@ -1074,7 +1177,7 @@ Rename::renameSrcRegs(const DynInstPtr &inst, ThreadID tid)
 
         // See if the register is ready or not.
         if (scoreboard->getReg(renamed_reg)) {
-            DPRINTF(Rename,
+            DPRINTF_PC(Rename, inst->pcState().instAddr(),
                     "[tid:%i] "
                     "Register %d (flat: %d) (%s) is ready.\n",
                     tid, renamed_reg->index(), renamed_reg->flatIndex(),
@@ -1082,7 +1185,7 @@ Rename::renameSrcRegs(const DynInstPtr &inst, ThreadID tid)
 
             inst->markSrcRegReady(src_idx);
         } else {
-            DPRINTF(Rename,
+            DPRINTF_PC(Rename, inst->pcState().instAddr(),
                     "[tid:%i] "
                     "Register %d (flat: %d) (%s) is not ready.\n",
                     tid, renamed_reg->index(), renamed_reg->flatIndex(),
@@ -1115,7 +1218,7 @@ Rename::renameDestRegs(const DynInstPtr &inst, ThreadID tid)
 
         scoreboard->unsetReg(rename_result.first);
 
-        DPRINTF(Rename,
+        DPRINTF_PC(Rename, inst->pcState().instAddr(),
                 "[tid:%i] "
                 "Renaming arch reg %i (%s) to physical reg %i (%i).\n",
                 tid, dest_reg.index(), dest_reg.className(),
@@ -1127,11 +1230,17 @@ Rename::renameDestRegs(const DynInstPtr &inst, ThreadID tid)
                                rename_result.first,
                                rename_result.second);
 
-        historyBuffer[tid].push_front(hb_entry);
+        // Keep the entries of squashed instructions in front, and the
+        // live ones youngest first.
+        assert(liveHistory[tid] == historyBuffer[tid].end() ||
+               liveHistory[tid]->instSeqNum <= inst->seqNum);
+        liveHistory[tid] = historyBuffer[tid].insert(liveHistory[tid],
+                                                     hb_entry);
 
-        DPRINTF(Rename, "[tid:%i] [sn:%llu] "
+        DPRINTF_PC(Rename, inst->pcState().instAddr(),
+                "[tid:%i] [sn:%llu] "
                 "Adding instruction to history buffer (size=%i).\n",
-                tid,(*historyBuffer[tid].begin()).instSeqNum,
+                tid, liveHistory[tid]->instSeqNum,
                 historyBuffer[tid].size());
 
         // Tell the instruction to rename the appropriate destination
@@ -1309,17 +1418,11 @@ Rename::checkSignalsAndUpdate(ThreadID tid)
 
         return true;
     } else if (!fromCommit->commitInfo[tid].robSquashing &&
-            !freeingInProgress[tid].empty()) {
+            historyBuffer[tid].begin() != liveHistory[tid]) {
         DPRINTF(Rename, "[tid:%i] Freeing phys regs of misspeculated "
                 "instructions.\n", tid);
 
-        auto reg_it = freeingInProgress[tid].cbegin();
-        while ( reg_it != freeingInProgress[tid].cend()){
-            // Put the renamed physical register back on the free list.
-            freeList->addReg(*reg_it);
-            ++reg_it;
-        }
-        freeingInProgress[tid].clear();
+        freeSquashedHistory(tid);
     }
 
     if (checkStall(tid)) {
@@ -1371,7 +1474,8 @@ Rename::checkSignalsAndUpdate(ThreadID tid)
 
         unblock(tid);
 
-        DPRINTF(Rename, "[tid:%i] Processing instruction [%lli] with "
+        DPRINTF_PC(Rename, serial_inst->pcState().instAddr(),
+                "[tid:%i] Processing instruction [%lli] with "
                 "PC %s.\n", tid, serial_inst->seqNum, serial_inst->pcState());
 
         // Put instruction into queue here.
@@ -45,6 +45,7 @@
 #include <list>
 #include <utility>
 
+#include "base/circular_queue.hh"
 #include "base/statistics.hh"
 #include "cpu/o3/comm.hh"
 #include "cpu/o3/commit.hh"
@@ -52,6 +53,7 @@
 #include "cpu/o3/free_list.hh"
 #include "cpu/o3/iew.hh"
 #include "cpu/o3/limits.hh"
+#include "cpu/o3/rename_map.hh"
 #include "cpu/timebuf.hh"
 #include "sim/probe/probe.hh"
 
@@ -320,6 +322,41 @@ class Rename
      */
     std::list<RenameHistory> historyBuffer[MaxThreads];
 
+    /** Per-thread first entry of the history buffer that has not been
+     * squashed. The entries in front of it belong to squashed instructions,
+     * and wait for commit to finish the squash before their physical
+     * registers are freed. The entries from it to the end are live and
+     * ordered youngest first, which doSquash() and removeFromHistory()
+     * rely on. The squashed entries are in no particular order.
+     */
+    std::list<RenameHistory>::iterator liveHistory[MaxThreads];
+
+    /** A copy of the rename map taken right after renaming a control
+     * instruction. Squashing back to that instruction restores it instead
+     * of undoing the younger history buffer entries one by one.
+     */
+    struct RenameCheckpoint
+    {
+        /** The sequence number of the control instruction. */
+        InstSeqNum instSeqNum;
+        /** The mappings after the instruction was renamed. */
+        UnifiedRenameMap::Checkpoint map;
+        /** The first live history buffer entry when the checkpoint was
+         * taken. The live entries in front of it are younger than the
+         * checkpoint, so a squash restoring it just moves liveHistory
+         * here.
+         */
+        std::list<RenameHistory>::iterator history;
+    };
+
+    /** Per-thread rename map checkpoints, oldest first. */
+    CircularQueue<RenameCheckpoint> checkpoints[MaxThreads];
+
+    /** Checkpoint the rename map after renaming a control instruction, if
+     * a checkpoint is available.
+     */
+    void takeCheckpoint(const DynInstPtr &inst, ThreadID tid);
+
     /** Pointer to CPU. */
     CPU *cpu;
 
@@ -359,8 +396,10 @@ class Rename
     /** Free list interface. */
     UnifiedFreeList *freeList;
 
-    /** Hold phys regs to be released after squash finish */
-    std::vector<PhysRegIdPtr> freeingInProgress[MaxThreads];
+    /** Free the physical registers of the squashed history buffer entries,
+     * once commit is done squashing.
+     */
+    void freeSquashedHistory(ThreadID tid);
 
     /** Pointer to the list of active threads. */
     std::list<ThreadID> *activeThreads;
@@ -459,6 +498,9 @@ class Rename
     /** The number of threads active in rename. */
     ThreadID numThreads;
 
+    /** Maximum number of rename map checkpoints per thread. */
+    const unsigned numCheckpoints;
+
     /** The maximum skid buffer size. */
     unsigned skidBufferMax;
 
@@ -530,6 +572,12 @@ class Rename
         /** Stat for total number of mappings that were undone due to a
          *  squash. */
         statistics::Scalar undoneMaps;
+        /** Stat for total number of squashes that restored a rename map
+         *  checkpoint. */
+        statistics::Scalar checkpointRestores;
+        /** Stat for total number of control instructions that found no
+         *  free checkpoint. */
+        statistics::Scalar checkpointsUnavailable;
         /** Number of serialize instructions handled. */
         statistics::Scalar serializing;
         /** Number of instructions marked as temporarily serializing. */
@@ -184,6 +184,9 @@ class UnifiedRenameMap
 
     typedef std::array<UnifiedRenameMap, MaxThreads> PerThreadUnifiedRenameMap;
 
+    /** A copy of the mappings of every register class. */
+    typedef std::array<std::vector<PhysRegIdPtr>, CCRegClass + 1> Checkpoint;
+
     /** Default constructor.  init() must be called prior to use. */
     UnifiedRenameMap() : regFile(nullptr) {};
 
@@ -261,6 +264,33 @@ class UnifiedRenameMap
         return renameMaps[arch_reg.classValue()].setEntry(arch_reg, phys_reg);
     }
 
+    /**
+     * Save all the current mappings. The storage of the checkpoint is
+     * reused if it is big enough.
+     * @param ckpt The checkpoint to fill in.
+     */
+    void
+    checkpoint(Checkpoint &ckpt) const
+    {
+        for (size_t i = 0; i < renameMaps.size(); i++)
+            ckpt[i].assign(renameMaps[i].cbegin(), renameMaps[i].cend());
+    }
+
+    /**
+     * Roll all the mappings back to a checkpoint, instead of undoing the
+     * renames one at a time with setEntry().
+     * @param ckpt A checkpoint taken by this rename map.
+     */
+    void
+    restore(const Checkpoint &ckpt)
+    {
+        for (size_t i = 0; i < renameMaps.size(); i++) {
+            assert(ckpt[i].size() == renameMaps[i].numArchRegs());
+            std::copy(ckpt[i].begin(), ckpt[i].end(),
+                      renameMaps[i].begin());
+        }
+    }
+
     /**
      * Return the minimum number of free entries across all of the
      * register classes.  The minimum is used so we guarantee that
@@ -29,6 +29,7 @@
 #ifndef __PC_EVENT_HH__
 #define __PC_EVENT_HH__
 
+#include <algorithm>
 #include <vector>
 
 #include "base/logging.hh"
@@ -125,6 +126,18 @@ class PCEventQueue : public PCEventScope
     range_t equal_range(Addr pc);
     range_t equal_range(PCEvent *event) { return equal_range(event->pc()); }
 
+    /** Check if any event is scheduled at a PC in [start, end). */
+    bool
+    hasEvents(Addr start, Addr end) const
+    {
+        if (pcMap.empty())
+            return false;
+
+        auto it = std::lower_bound(pcMap.begin(), pcMap.end(), start,
+                                   MapCompare());
+        return it != pcMap.end() && (*it)->pc() < end;
+    }
+
     void dump() const;
 };
 
@@ -183,6 +183,10 @@ MultiperspectivePerceptron::init()
                                        modpath_indices, modpath_lengths,
                                        table_sizes, n_sign_bits);
     }
+
+    featureIndices.resize(specs.size());
+    featureValues.resize(specs.size());
+    bestMask.resize(specs.size());
 }
 
 void
@@ -317,6 +321,15 @@ MultiperspectivePerceptron::getIndex(ThreadID tid, const MPPBranchInfo &bi,
     return h;
 }
 
+void
+MultiperspectivePerceptron::computeIndices(ThreadID tid,
+                                           const MPPBranchInfo &bi)
+{
+    for (int i = 0; i < specs.size(); i += 1) {
+        featureIndices[i] = getIndex(tid, bi, *specs[i], i);
+    }
+}
+
 int
 MultiperspectivePerceptron::computeOutput(ThreadID tid, MPPBranchInfo &bi)
 {
@@ -343,38 +356,47 @@ MultiperspectivePerceptron::computeOutput(ThreadID tid, MPPBranchInfo &bi)
     // branch
     findBest(tid, best_preds);
 
-    // begin computation of the sum for low-confidence branch
-    int bestval = 0;
+    // mark the good features so that their values are also added to
+    // bestval
+    std::fill(bestMask.begin(), bestMask.end(), 0);
+    if (threshold >= 0) {
+        for (int j = 0; j < std::min(nbest, (int) best_preds.size()); j += 1) {
+            if (best_preds[j] >= 0) {
+                bestMask[best_preds[j]] = -1;
+            }
+        }
+    }
 
+    // get the hashes to index the tables
+    computeIndices(tid, bi);
+
+    // read the weights of all the features
+    const unsigned int sign_idx = bi.getHPC() % n_sign_bits;
     for (int i = 0; i < specs.size(); i += 1) {
         HistorySpec const &spec = *specs[i];
-        // get the hash to index the table
-        unsigned int hashed_idx = getIndex(tid, bi, spec, i);
+        unsigned int hashed_idx = featureIndices[i];
         // add the weight; first get the weight's magnitude
         int counter = threadData[tid]->tables[i][hashed_idx];
         // get the sign
-        bool sign =
-          threadData[tid]->sign_bits[i][hashed_idx][bi.getHPC() % n_sign_bits];
+        bool sign = threadData[tid]->sign_bits[i][hashed_idx][sign_idx];
         // apply the transfer function and multiply by a coefficient
         int weight = spec.coeff * ((spec.width == 5) ?
                                    xlat4[counter] : xlat[counter]);
         // apply the sign
-        int val = sign ? -weight : weight;
-        // add the value
-        bi.yout += val;
-        // if this is one of those good features, add the value to bestval
-        if (threshold >= 0) {
-            for (int j = 0;
-                 j < std::min(nbest, (int) best_preds.size());
-                 j += 1)
-            {
-                if (best_preds[j] == i) {
-                    bestval += val;
-                    break;
-                }
-            }
-        }
+        featureValues[i] = sign ? -weight : weight;
     }
+
+    // compute the sum for all the features and for the low-confidence
+    // subset; the loop has no branches so that it can be vectorized
+    int yout = 0;
+    int bestval = 0;
+    const int *values = featureValues.data();
+    const int *mask = bestMask.data();
+    for (int i = 0; i < specs.size(); i += 1) {
+        yout += values[i];
+        bestval += values[i] & mask[i];
+    }
+    bi.yout += yout;
     // apply a fudge factor to affect when training is triggered
     bi.yout *= fudge;
     return bestval;
@@ -428,16 +450,25 @@ MultiperspectivePerceptron::train(ThreadID tid, MPPBranchInfo &bi, bool taken)
     bool correct = (bi.yout >= 1) == taken;
     // what is the magnitude of yout?
     int abs_yout = abs(bi.yout);
+    bool do_tune = threshold >= 0 && (!tuneonly || (abs_yout <= threshold));
+    // if the branch was predicted incorrectly or the correct
+    // prediction was weak, update the weights
+    bool do_train = !correct || (abs_yout <= theta);
+    if (!do_tune && !do_train) return;
+
+    // get the hashes to index the tables, shared by all the steps below
+    computeIndices(tid, bi);
+    const unsigned int sign_idx = bi.getHPC() % n_sign_bits;
+
     // keep track of mispredictions per table
-    if (threshold >= 0) if (!tuneonly || (abs_yout <= threshold)) {
+    if (do_tune) {
         bool halve = false;
 
         // for each table, figure out if there was a misprediction
         for (int i = 0; i < specs.size(); i += 1) {
             HistorySpec const &spec = *specs[i];
-            // get the hash to index the table
-            unsigned int hashed_idx = getIndex(tid, bi, spec, i);
-            bool sign = sign_bits[i][hashed_idx][bi.getHPC() % n_sign_bits];
+            unsigned int hashed_idx = featureIndices[i];
+            bool sign = sign_bits[i][hashed_idx][sign_idx];
             int counter = tables[i][hashed_idx];
             int weight = spec.coeff * ((spec.width == 5) ?
                                        xlat4[counter] : xlat[counter]);
@@ -457,9 +488,6 @@ MultiperspectivePerceptron::train(ThreadID tid, MPPBranchInfo &bi, bool taken)
             }
         }
     }
-    // if the branch was predicted incorrectly or the correct
-    // prediction was weak, update the weights
-    bool do_train = !correct || (abs_yout <= theta);
     if (!do_train) return;
 
     // adaptive theta training, adapted from O-GEHL
@@ -484,15 +512,15 @@ MultiperspectivePerceptron::train(ThreadID tid, MPPBranchInfo &bi, bool taken)
     for (int i = 0; i < specs.size(); i += 1) {
         HistorySpec const &spec = *specs[i];
         // get the magnitude
-        unsigned int hashed_idx = getIndex(tid, bi, spec, i);
+        unsigned int hashed_idx = featureIndices[i];
         int counter = tables[i][hashed_idx];
         // get the sign
-        bool sign = sign_bits[i][hashed_idx][bi.getHPC() % n_sign_bits];
+        bool sign = sign_bits[i][hashed_idx][sign_idx];
         // increment/decrement if taken/not taken
         satIncDec(taken, sign, counter, (1 << (spec.width - 1)) - 1);
         // update the magnitude and sign
         tables[i][hashed_idx] = counter;
-        sign_bits[i][hashed_idx][bi.getHPC() % n_sign_bits] = sign;
+        sign_bits[i][hashed_idx][sign_idx] = sign;
         int weight = ((spec.width == 5) ? xlat4[counter] : xlat[counter]);
         // update the new version of yout
         if (sign) {
@@ -518,10 +546,9 @@ MultiperspectivePerceptron::train(ThreadID tid, MPPBranchInfo &bi, bool taken)
                 for (int j = 0; j < specs.size(); j += 1) {
                     int i = (nrand + j) % specs.size();
                     HistorySpec const &spec = *specs[i];
-                    unsigned int hashed_idx = getIndex(tid, bi, spec, i);
+                    unsigned int hashed_idx = featureIndices[i];
                     int counter = tables[i][hashed_idx];
-                    bool sign =
-                        sign_bits[i][hashed_idx][bi.getHPC() % n_sign_bits];
+                    bool sign = sign_bits[i][hashed_idx][sign_idx];
                     int weight = ((spec.width == 5) ?
                             xlat4[counter] : xlat[counter]);
                     int signed_weight = sign ? -weight : weight;
@@ -536,10 +563,9 @@ MultiperspectivePerceptron::train(ThreadID tid, MPPBranchInfo &bi, bool taken)
                 if (besti != -1) {
                     int i = besti;
                     HistorySpec const &spec = *specs[i];
-                    unsigned int hashed_idx = getIndex(tid, bi, spec, i);
+                    unsigned int hashed_idx = featureIndices[i];
                     int counter = tables[i][hashed_idx];
-                    bool sign =
-                        sign_bits[i][hashed_idx][bi.getHPC() % n_sign_bits];
+                    bool sign = sign_bits[i][hashed_idx][sign_idx];
                     if (counter > 1) {
                         counter--;
                         tables[i][hashed_idx] = counter;
@@ -809,11 +835,7 @@ MultiperspectivePerceptron::update(ThreadID tid, Addr pc,  bool taken,
         for (int ii = 0; ii < modhist_indices.size(); ii += 1) {
             int i = modhist_indices[ii];
             if (bi->getHPC() % (i + 2) == 0) {
-                for (int j = modhist_lengths[ii] - 1; j > 0; j -= 1) {
-                    threadData[tid]->mod_histories[i][j] =
-                        threadData[tid]->mod_histories[i][j-1];
-                }
-                threadData[tid]->mod_histories[i][0] = hashed_taken;
+                threadData[tid]->mod_histories[i].shiftIn(hashed_taken);
             }
         }
     }
@@ -51,7 +51,9 @@
 #ifndef __CPU_PRED_MULTIPERSPECTIVE_PERCEPTRON_HH__
 #define __CPU_PRED_MULTIPERSPECTIVE_PERCEPTRON_HH__
 
+#include <algorithm>
 #include <array>
+#include <cstdint>
 #include <vector>
 
 #include "base/random.hh"
@@ -232,6 +234,84 @@ class MultiperspectivePerceptron : public BPredUnit
         }
     };
 
+    /**
+     * History of outcomes packed in 64-bit words, bit 0 being the most
+     * recent one. Used instead of std::vector<bool> so that whole blocks
+     * of bits can be shifted and folded at once.
+     */
+    class BitHistory
+    {
+        /** The bits of the history */
+        std::vector<uint64_t> words;
+        /** Number of valid bits */
+        int length = 0;
+
+      public:
+        /** Sets the number of bits, new bits are cleared */
+        void resize(int num_bits)
+        {
+            length = num_bits;
+            words.resize((num_bits + 63) / 64, 0);
+        }
+
+        /** Returns the number of bits of the history */
+        int size() const { return length; }
+
+        /** Obtains the value of a given bit */
+        bool operator[](int i) const
+        {
+            return (words[i >> 6] >> (i & 63)) & 1;
+        }
+
+        /** Sets the value of a given bit */
+        void set(int i, bool value)
+        {
+            const uint64_t mask = 1ULL << (i & 63);
+            words[i >> 6] = value ? (words[i >> 6] | mask) :
+                                    (words[i >> 6] & ~mask);
+        }
+
+        /** Shifts the history by one position and inserts a new bit */
+        void shiftIn(bool value)
+        {
+            if (words.empty()) {
+                return;
+            }
+            for (size_t w = words.size() - 1; w > 0; w -= 1) {
+                words[w] = (words[w] << 1) | (words[w - 1] >> 63);
+            }
+            words[0] = (words[0] << 1) | value;
+            if (length & 63) {
+                words.back() &= (1ULL << (length & 63)) - 1;
+            }
+        }
+
+        /** Obtains num_bits (at most 63) bits starting at a given bit */
+        uint64_t bits(int pos, int num_bits) const
+        {
+            const int w = pos >> 6;
+            const int offset = pos & 63;
+            uint64_t x = words[w] >> offset;
+            if (offset + num_bits > 64) {
+                x |= words[w + 1] << (64 - offset);
+            }
+            return x & ((1ULL << num_bits) - 1);
+        }
+
+        /**
+         * XORs together the consecutive blocks of block_size bits of the
+         * first num_bits bits of the history
+         */
+        unsigned int fold(int num_bits, int block_size) const
+        {
+            unsigned int x = 0;
+            for (int i = 0; i < num_bits; i += block_size) {
+                x ^= bits(i, std::min(block_size, num_bits - i));
+            }
+            return x;
+        }
+    };
+
     /**
      * Base class to implement the predictor tables.
      */
@@ -324,13 +404,13 @@ class MultiperspectivePerceptron : public BPredUnit
             const std::vector<int> &table_sizes, int n_sign_bits);
 
         std::vector<FilterEntry> filterTable;
-        std::vector<std::vector<bool>> acyclic_histories;
+        std::vector<BitHistory> acyclic_histories;
         std::vector<std::vector<unsigned int>> acyclic2_histories;
 
         void updateAcyclic(bool hashed_taken, unsigned int hpc) {
             for (int i = 0; i < acyclic_histories.size(); i += 1) {
                 if (acyclic_histories[i].size() > 0) {
-                    acyclic_histories[i][hpc%(i+2)] = hashed_taken;
+                    acyclic_histories[i].set(hpc%(i+2), hashed_taken);
                     acyclic2_histories[i][hpc%(i+2)] = hpc;
                 }
             }
@@ -339,7 +419,7 @@ class MultiperspectivePerceptron : public BPredUnit
         std::vector<std::vector<unsigned int>> blurrypath_histories;
         std::vector<unsigned int> ghist_words;
         std::vector<std::vector<unsigned short int>> modpath_histories;
-        std::vector<std::vector<bool>> mod_histories;
+        std::vector<BitHistory> mod_histories;
         std::vector<unsigned short int> path_history;
         std::vector<unsigned int> imli_counter;
         LocalHistories localHistories;
@@ -377,6 +457,13 @@ class MultiperspectivePerceptron : public BPredUnit
     std::vector<HistorySpec *> specs;
     std::vector<int> table_sizes;
 
+    /** Index of each predictor table for the branch being processed */
+    std::vector<unsigned int> featureIndices;
+    /** Signed weight read from each predictor table */
+    std::vector<int> featureValues;
+    /** All ones for the tables of the best subset, zero otherwise */
+    std::vector<int> bestMask;
+
     /** runtime values and data used to count the size in bits */
     bool doing_local;
     bool doing_recency;
@@ -462,6 +549,14 @@ class MultiperspectivePerceptron : public BPredUnit
      */
     unsigned int getIndex(ThreadID tid, const MPPBranchInfo &bi,
             const HistorySpec &spec, int index) const;
+
+    /**
+     * Computes the index of every predictor table for a branch and
+     * stores them in featureIndices
+     * @param tid Thread ID of the branch
+     * @param bi branch informaiton data
+     */
+    void computeIndices(ThreadID tid, const MPPBranchInfo &bi);
     /**
      * Finds the best subset of features to use in case of a low-confidence
      * branch, returns the result as an ordered vector of the indices to the
@@ -572,19 +667,14 @@ class MultiperspectivePerceptron : public BPredUnit
             int a = p1;
             int shift = p2;
             int style = p3;
-            std::vector<std::vector<bool>> &acyclic_histories =
+            const std::vector<BitHistory> &acyclic_histories =
                 mpp.threadData[tid]->acyclic_histories;
             std::vector<std::vector<unsigned int>> &acyclic2_histories =
                 mpp.threadData[tid]->acyclic2_histories;
 
             unsigned int x = 0;
             if (style == -1) {
-                unsigned int k = 0;
-                for (int i = 0; i < a + 2; i += 1) {
-                    x ^= acyclic_histories[a][i] << k;
-                    k += 1;
-                    k %= mpp.blockSize;
-                }
+                x = acyclic_histories[a].fold(a + 2, mpp.blockSize);
             } else {
                 for (int i = 0; i < a + 2; i += 1) {
                     x <<= shift;
@@ -620,16 +710,10 @@ class MultiperspectivePerceptron : public BPredUnit
         {
             int a = p1;
             int b = p2;
-            std::vector<std::vector<bool>> &mod_histories =
+            const std::vector<BitHistory> &mod_histories =
                 mpp.threadData[tid]->mod_histories;
 
-            unsigned int x = 0, k = 0;
-            for (int i = 0; i < b; i += 1) {
-                x ^= mod_histories[a][i] << k;
-                k += 1;
-                k %= mpp.blockSize;
-            }
-            return x;
+            return mod_histories[a].fold(b, mpp.blockSize);
         }
         void setBitRequirements() const override
         {
@@ -905,7 +989,7 @@ class MultiperspectivePerceptron : public BPredUnit
             int shift = p3;
             std::vector<std::vector<unsigned short int>> &modpath_histories =
                 mpp.threadData[tid]->modpath_histories;
-            std::vector<std::vector<bool>> &mod_histories =
+            const std::vector<BitHistory> &mod_histories =
                 mpp.threadData[tid]->mod_histories;
 
             unsigned int x = 0;
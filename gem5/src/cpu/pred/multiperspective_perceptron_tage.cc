@@ -489,11 +489,7 @@ MultiperspectivePerceptronTAGE::updateHistories(ThreadID tid,
     for (int ii = 0; ii < modhist_indices.size(); ii += 1) {
         int i = modhist_indices[ii];
         if (hpc % (i + 2) == 0) {
-            for (int j = modhist_lengths[ii] - 1; j > 0; j -= 1) {
-                threadData[tid]->mod_histories[i][j] =
-                    threadData[tid]->mod_histories[i][j-1];
-            }
-            threadData[tid]->mod_histories[i][0] = taken;
+            threadData[tid]->mod_histories[i].shiftIn(taken);
         }
     }
 
@@ -38,6 +38,10 @@
 
 #include "cpu/pred/tage_base.hh"
 
+#include <algorithm>
+#include <cstring>
+#include <new>
+
 #include "base/intmath.hh"
 #include "base/logging.hh"
 #include "debug/Fetch.hh"
@@ -79,6 +83,13 @@ TAGEBase::TAGEBase(const TAGEBaseParams &p)
     }
 }
 
+TAGEBase::~TAGEBase()
+{
+    for (void *storage : tableStorage) {
+        ::operator delete(storage, std::align_val_t(tableAlignment));
+    }
+}
+
 TAGEBase::BranchInfo*
 TAGEBase::makeBranchInfo(Addr pc, bool conditional) {
     return new BranchInfo(*this, pc, conditional);
@@ -139,11 +150,22 @@ TAGEBase::init()
     btableHysteresis.resize(bimodalTableSize >> logRatioBiModalHystEntries,
                             true);
 
-    gtable = new TageEntry*[nHistoryTables + 1];
+    gtable.resize(nHistoryTables + 1);
     buildTageTables();
 
     tableIndices = new int [nHistoryTables+1];
     tableTags = new int [nHistoryTables+1];
+
+    indexPcShifts.resize(nHistoryTables + 1, 0);
+    pathHistLengths.resize(nHistoryTables + 1, 0);
+    indexMasks.resize(nHistoryTables + 1, 0);
+    tagMasks.resize(nHistoryTables + 1, 0);
+    for (int i = 1; i <= nHistoryTables; i++) {
+        indexPcShifts[i] = abs(logTagTableSizes[i] - i) + 1;
+        pathHistLengths[i] = std::min(histLengths[i], (int)pathHistBits);
+        indexMasks[i] = (1ULL << logTagTableSizes[i]) - 1;
+        tagMasks[i] = (1ULL << tagTableTagWidths[i]) - 1;
+    }
     initialized = true;
 }
 
@@ -166,10 +188,32 @@ void
 TAGEBase::buildTageTables()
 {
     for (int i = 1; i <= nHistoryTables; i++) {
-        gtable[i] = new TageEntry[1<<(logTagTableSizes[i])];
+        gtable[i] = allocateTable(1 << logTagTableSizes[i]);
     }
 }
 
+TAGEBase::TageTable
+TAGEBase::allocateTable(size_t num_entries)
+{
+    auto align = [](size_t bytes) {
+        return (bytes + tableAlignment - 1) & ~(tableAlignment - 1);
+    };
+    const size_t tag_bytes = align(num_entries * sizeof(uint16_t));
+    const size_t ctr_bytes = align(num_entries * sizeof(int8_t));
+    const size_t u_bytes = align(num_entries * sizeof(uint8_t));
+
+    uint8_t *storage = static_cast<uint8_t *>(::operator new(
+        tag_bytes + ctr_bytes + u_bytes, std::align_val_t(tableAlignment)));
+    std::memset(storage, 0, tag_bytes + ctr_bytes + u_bytes);
+    tableStorage.push_back(storage);
+
+    TageTable table;
+    table.tag = reinterpret_cast<uint16_t *>(storage);
+    table.ctr = reinterpret_cast<int8_t *>(storage + tag_bytes);
+    table.u = storage + tag_bytes + ctr_bytes;
+    return table;
+}
+
 void
 TAGEBase::calculateParameters()
 {
@@ -342,13 +386,26 @@ void
 TAGEBase::calculateIndicesAndTags(ThreadID tid, Addr branch_pc,
                                   BranchInfo* bi)
 {
-    // computes the table addresses and the partial tags
+    // Computes the table addresses and the partial tags. This is the same
+    // hash as gindex and gtag, with the per table constants precomputed
+    // and the thread state read once.
+    const ThreadHistory &t_hist = threadHistory[tid];
+    const unsigned int shifted_pc = branch_pc >> instShiftAmt;
+    const int path_hist = t_hist.pathHist;
     for (int i = 1; i <= nHistoryTables; i++) {
-        tableIndices[i] = gindex(tid, branch_pc, i);
-        bi->tableIndices[i] = tableIndices[i];
-        tableTags[i] = gtag(tid, branch_pc, i);
-        bi->tableTags[i] = tableTags[i];
-    }
+        const int index = shifted_pc ^ (shifted_pc >> indexPcShifts[i]) ^
+            t_hist.computeIndices[i].comp ^
+            TAGEBase::F(path_hist, pathHistLengths[i], i);
+        tableIndices[i] = index & indexMasks[i];
+
+        const int tag = shifted_pc ^ t_hist.computeTags[0][i].comp ^
+            (t_hist.computeTags[1][i].comp << 1);
+        tableTags[i] = tag & tagMasks[i];
+    }
+    std::copy(tableIndices + 1, tableIndices + nHistoryTables + 1,
+              bi->tableIndices + 1);
+    std::copy(tableTags + 1, tableTags + nHistoryTables + 1,
+              bi->tableTags + 1);
     bi->valid = true;
 }
 
@@ -67,18 +67,33 @@ class TAGEBase : public SimObject
 {
   public:
     TAGEBase(const TAGEBaseParams &p);
+    ~TAGEBase();
     void init() override;
 
   protected:
     // Prediction Structures
 
-    // Tage Entry
-    struct TageEntry
+    // Tagged table. The fields of the entries are kept in separate
+    // arrays so that the tag comparisons of a lookup only touch tags.
+    struct TageTable
     {
-        int8_t ctr;
-        uint16_t tag;
-        uint8_t u;
-        TageEntry() : ctr(0), tag(0), u(0) { }
+        int8_t *ctr = nullptr;
+        uint16_t *tag = nullptr;
+        uint8_t *u = nullptr;
+
+        // References to the fields of one entry
+        struct Entry
+        {
+            int8_t &ctr;
+            uint16_t &tag;
+            uint8_t &u;
+        };
+
+        Entry
+        operator[](size_t idx) const
+        {
+            return Entry{ctr[idx], tag[idx], u[idx]};
+        }
     };
 
     // Folded History Table - compressed history
@@ -412,6 +427,13 @@ class TAGEBase : public SimObject
      */
     virtual void buildTageTables();
 
+    /**
+     * Allocates zeroed storage for a tagged table. The arrays of each
+     * field start on a cache line boundary.
+     * @param num_entries Number of entries of the table.
+     */
+    TageTable allocateTable(size_t num_entries);
+
     /**
      * Calculates the history lengths
      * and some other paramters in derived classes
@@ -420,7 +442,9 @@ class TAGEBase : public SimObject
 
     /**
      * On a prediction, calculates the TAGE indices and tags for
-     * all the different history lengths
+     * all the different history lengths. The base version computes
+     * the hashes of gindex, gtag and F inline, so derived classes
+     * that change those must override this as well.
      */
     virtual void calculateIndicesAndTags(
         ThreadID tid, Addr branch_pc, BranchInfo* bi);
@@ -495,7 +519,9 @@ class TAGEBase : public SimObject
 
     std::vector<bool> btablePrediction;
     std::vector<bool> btableHysteresis;
-    TageEntry **gtable;
+    static constexpr size_t tableAlignment = 64;
+    std::vector<TageTable> gtable;
+    std::vector<void *> tableStorage;
 
     // Keep per-thread histories to
     // support SMT.
@@ -530,6 +556,12 @@ class TAGEBase : public SimObject
     int *tableIndices;
     int *tableTags;
 
+    // Per table constants of the index and tag hashes
+    std::vector<unsigned> indexPcShifts;
+    std::vector<int> pathHistLengths;
+    std::vector<uint64_t> indexMasks;
+    std::vector<uint64_t> tagMasks;
+
     std::vector<int8_t> useAltPredForNewlyAllocated;
     int64_t tCounter;
     uint64_t logUResetPeriod;
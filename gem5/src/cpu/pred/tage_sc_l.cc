@@ -125,9 +125,9 @@ TAGE_SC_L_TAGE::buildTageTables()
     // Trick! We only allocate entries for tables 1 and firstLongTagTable and
     // make the other tables point to these allocated entries
 
-    gtable[1] = new TageEntry[shortTagsTageFactor * (1 << logTagTableSize)];
+    gtable[1] = allocateTable(shortTagsTageFactor * (1 << logTagTableSize));
     gtable[firstLongTagTable] =
-        new TageEntry[longTagsTageFactor * (1 << logTagTableSize)];
+        allocateTable(longTagsTageFactor * (1 << logTagTableSize));
     for (int i = 2; i < firstLongTagTable; ++i) {
         gtable[i] = gtable[1];
     }
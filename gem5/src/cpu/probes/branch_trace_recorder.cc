@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cpu/probes/branch_trace_recorder.hh"
+
+#include "base/callback.hh"
+#include "base/logging.hh"
+#include "base/output.hh"
+#include "cpu/base.hh"
+#include "cpu/pred/branch_type.hh"
+#include "cpu/static_inst.hh"
+
+namespace gem5
+{
+
+BranchTraceRecorder::BranchTraceRecorder(
+        const BranchTraceRecorderParams &params)
+    : ProbeListenerObject(params),
+      traceStream(nullptr),
+      hasPending(false),
+      pendingCond(false),
+      lastPC(0),
+      instsSinceBranch(0)
+{
+    BaseCPU *cpu = dynamic_cast<BaseCPU *>(params.manager);
+    fatal_if(!cpu, "Manager of %s is not a CPU.", name());
+    fatal_if(cpu->numThreads > 1, "%s supports single-threaded cores only.",
+             name());
+    fatal_if(params.traceFile.empty(), "%s needs a trace file name.",
+             name());
+
+    traceStream = new ProtoOutputStream(simout.resolve(params.traceFile));
+
+    ProtoMessage::BranchHeader header;
+    header.set_obj_id(name());
+    header.set_ver(0);
+    traceStream->write(header);
+
+    registerExitCallback([this]() { flushTrace(); });
+}
+
+void
+BranchTraceRecorder::regProbeListeners()
+{
+    typedef ProbeListenerArg<BranchTraceRecorder, Addr> InstListener;
+    typedef ProbeListenerArg<BranchTraceRecorder, StaticInstPtr>
+        BranchListener;
+    connectListener<InstListener>(this, "RetiredInstsPC",
+                                  &BranchTraceRecorder::retireInst);
+    connectListener<BranchListener>(this, "RetiredBranchInsts",
+                                    &BranchTraceRecorder::retireBranch);
+}
+
+void
+BranchTraceRecorder::retireInst(const Addr &pc)
+{
+    if (hasPending) {
+        const Addr fallthrough = pending.pc() + pending.size();
+        if (!pendingCond || pc != fallthrough) {
+            pending.set_target(pc);
+        }
+        traceStream->write(pending);
+        hasPending = false;
+    }
+    lastPC = pc;
+    instsSinceBranch++;
+}
+
+void
+BranchTraceRecorder::retireBranch(const StaticInstPtr &inst)
+{
+    // Only the micro-op that completes a macro-op is reported by
+    // RetiredInstsPC, the branch is recorded at that point
+    if (!traceStream || (inst->isMicroop() && !inst->isLastMicroop())) {
+        return;
+    }
+
+    pending.Clear();
+    pending.set_pc(lastPC);
+    pending.set_type(branch_prediction::getBranchType(inst));
+    pending.set_size(inst->size());
+    pending.set_insts(instsSinceBranch);
+    pendingCond = inst->isCondCtrl();
+    hasPending = true;
+    instsSinceBranch = 0;
+}
+
+void
+BranchTraceRecorder::flushTrace()
+{
+    // The last branch is dropped as its outcome is unknown
+    delete traceStream;
+    traceStream = nullptr;
+    hasPending = false;
+}
+
+} // namespace gem5
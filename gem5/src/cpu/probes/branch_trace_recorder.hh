@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_PROBES_BRANCH_TRACE_RECORDER_HH__
+#define __CPU_PROBES_BRANCH_TRACE_RECORDER_HH__
+
+#include <cstdint>
+
+#include "base/types.hh"
+#include "cpu/static_inst_fwd.hh"
+#include "params/BranchTraceRecorder.hh"
+#include "proto/branch.pb.h"
+#include "proto/protoio.hh"
+#include "sim/probe/probe_listener_object.hh"
+
+namespace gem5
+{
+
+/**
+ * Probe listener that writes the committed control instructions of a
+ * CPU to a protobuf branch trace. A branch is written once the next
+ * instruction commits, as that gives its actual target.
+ */
+class BranchTraceRecorder : public ProbeListenerObject
+{
+  public:
+    BranchTraceRecorder(const BranchTraceRecorderParams &params);
+
+    void regProbeListeners() override;
+
+    /**
+     * Called for every committed instruction. Completes the pending
+     * branch, if any.
+     * @param pc Address of the committed instruction.
+     */
+    void retireInst(const Addr &pc);
+
+    /**
+     * Called for every committed control instruction, right after
+     * retireInst for the same instruction.
+     * @param inst The branch instruction.
+     */
+    void retireBranch(const StaticInstPtr &inst);
+
+  private:
+    /** Writes the remaining data and closes the trace */
+    void flushTrace();
+
+    /** Output stream, null once the trace is closed */
+    ProtoOutputStream *traceStream;
+
+    /** Branch waiting for the next committed instruction */
+    ProtoMessage::Branch pending;
+    bool hasPending;
+
+    /** Whether the pending branch is conditional */
+    bool pendingCond;
+
+    /** Address of the last committed instruction */
+    Addr lastPC;
+
+    /** Instructions committed since the last branch */
+    uint32_t instsSinceBranch;
+};
+
+} // namespace gem5
+
+#endif // __CPU_PROBES_BRANCH_TRACE_RECORDER_HH__
@@ -61,6 +61,13 @@ class BaseAtomicSimpleCPU(BaseSimpleCPU):
     width = Param.Int(1, "CPU width")
     simulate_data_stalls = Param.Bool(False, "Simulate dcache stall cycles")
     simulate_inst_stalls = Param.Bool(False, "Simulate icache stall cycles")
+    basic_block_cache = Param.Bool(
+        False,
+        "Cache decoded basic blocks and execute them without fetching or "
+        "decoding, for fast-forwarding. The code of a cached block is "
+        "read functionally to check it is unchanged instead of being "
+        "fetched.",
+    )
 
     def addSimPointProbe(self, interval):
         simpoint = SimPoint()
@@ -41,7 +41,10 @@
 
 #include "cpu/simple/atomic.hh"
 
+#include <algorithm>
+
 #include "arch/generic/decoder.hh"
+#include "base/intmath.hh"
 #include "base/output.hh"
 #include "cpu/exetrace.hh"
 #include "cpu/utils.hh"
@@ -78,8 +81,12 @@ AtomicSimpleCPU::AtomicSimpleCPU(const BaseAtomicSimpleCPUParams &p)
       width(p.width), locked(false),
       simulate_data_stalls(p.simulate_data_stalls),
       simulate_inst_stalls(p.simulate_inst_stalls),
+      basicBlockCache(p.basic_block_cache), recPaddr(0), recording(false),
+      recEndsBlock(false), atBlockStart(true), inBlock(false),
+      execPage(0), execPageWritten(false),
       icachePort(name() + ".icache_port"),
       dcachePort(name() + ".dcache_port", this),
+      blockProxy(icachePort, cacheLineSize()),
       dcache_access(false), dcache_latency(0),
       ppCommit(nullptr)
 {
@@ -88,6 +95,15 @@ AtomicSimpleCPU::AtomicSimpleCPU(const BaseAtomicSimpleCPUParams &p)
     data_read_req = std::make_shared<Request>();
     data_write_req = std::make_shared<Request>();
     data_amo_req = std::make_shared<Request>();
+    block_req = std::make_shared<Request>();
+
+    fatal_if(basicBlockCache && (numThreads != 1 || width != 1),
+             "%s: The basic block cache needs a single thread and a width "
+             "of 1.\n", name());
+    fatal_if(basicBlockCache && (branchPred || simulate_inst_stalls),
+             "%s: The basic block cache does not fetch instructions and "
+             "cannot be used with a branch predictor or instruction "
+             "stalls.\n", name());
 }
 
 
@@ -148,6 +164,10 @@ AtomicSimpleCPU::drainResume()
     DPRINTF(SimpleCPU, "Resume\n");
     verifyMemoryMode();
 
+    // Memory may have been changed behind our back, e.g. by restoring
+    // a checkpoint, so start again with an empty block cache.
+    flushBlocks();
+
     assert(!threadContexts.empty());
 
     _status = BaseSimpleCPU::Idle;
@@ -192,6 +212,7 @@ void
 AtomicSimpleCPU::switchOut()
 {
     BaseSimpleCPU::switchOut();
+    flushBlocks();
 
     assert(!tickEvent.scheduled());
     assert(_status == BaseSimpleCPU::Running || _status == Idle);
@@ -300,6 +321,11 @@ AtomicSimpleCPU::AtomicCPUDPort::recvAtomicSnoop(PacketPtr pkt)
         }
     }
 
+    if (pkt->isWrite()) {
+        static_cast<AtomicSimpleCPU *>(cpu)->invalidateBlocks(
+                pkt->getAddr(), pkt->getSize());
+    }
+
     return 0;
 }
 
@@ -325,6 +351,11 @@ AtomicSimpleCPU::AtomicCPUDPort::recvFunctionalSnoop(PacketPtr pkt)
                     cacheBlockMask);
         }
     }
+
+    if (pkt->isWrite()) {
+        static_cast<AtomicSimpleCPU *>(cpu)->invalidateBlocks(
+                pkt->getAddr(), pkt->getSize());
+    }
 }
 
 bool
@@ -507,6 +538,7 @@ AtomicSimpleCPU::writeMem(uint8_t *data, unsigned size, Addr addr,
                 dcache_access = true;
                 panic_if(pkt.isError(), "Data write (%s) failed: %s",
                         pkt.getAddrRange().to_string(), pkt.print());
+                invalidateBlocks(req->getPaddr(), req->getSize());
                 if (req->isSwap()) {
                     assert(res && curr_frag_id == 0);
                     memcpy(res, pkt.getConstPtr<uint8_t>(), size);
@@ -596,6 +628,7 @@ AtomicSimpleCPU::amoMem(Addr addr, uint8_t* data, unsigned size,
 
         panic_if(pkt.isError(), "Atomic access (%s) failed: %s",
                 pkt.getAddrRange().to_string(), pkt.print());
+        invalidateBlocks(req->getPaddr(), req->getSize());
         assert(!req->isLLSC());
     }
 
@@ -607,6 +640,322 @@ AtomicSimpleCPU::amoMem(Addr addr, uint8_t* data, unsigned size,
     return fault;
 }
 
+bool
+AtomicSimpleCPU::endsBlock(const StaticInstPtr &inst)
+{
+    auto ends = [](const StaticInstPtr &si) {
+        return si->isControl() || si->isSyscall() || si->isSerializing() ||
+            si->isNonSpeculative() || si->isSquashAfter() ||
+            si->isQuiesce() || si->isPseudo();
+    };
+
+    if (!inst->isMacroop())
+        return ends(inst);
+
+    for (MicroPC upc = 0; ; ++upc) {
+        StaticInstPtr uop = inst->fetchMicroop(upc);
+        if (ends(uop))
+            return true;
+        if (uop->isLastMicroop())
+            return false;
+    }
+}
+
+bool
+AtomicSimpleCPU::translateBlockAddr(Addr vaddr, Addr &paddr)
+{
+    SimpleThread *thread = threadInfo[curThread]->thread;
+    auto &decoder = thread->decoder;
+
+    // Translate the same aligned block the normal path would fetch.
+    Addr fetch_addr = vaddr & decoder->pcMask();
+    block_req->taskId(taskId());
+    block_req->setVirt(fetch_addr, decoder->moreBytesSize(),
+                       Request::INST_FETCH, instRequestorId(), vaddr);
+    Fault fault = thread->mmu->translateAtomic(block_req, thread->getTC(),
+                                               BaseMMU::Execute);
+    if (fault != NoFault)
+        return false;
+
+    paddr = block_req->getPaddr() + (vaddr - fetch_addr);
+    return true;
+}
+
+void
+AtomicSimpleCPU::recordInst()
+{
+    const StaticInstPtr &inst =
+        curMacroStaticInst ? curMacroStaticInst : curStaticInst;
+    recEndsBlock = endsBlock(inst);
+
+    const Addr vaddr = blockFetchPC->instAddr();
+    const Addr page = roundDown(vaddr, blockPageBytes);
+    // The last fetch tells us whether the instruction spills over onto
+    // the next page.
+    const bool one_page =
+        roundDown(ifetch_req->getVaddr(), blockPageBytes) == page;
+    // Without the size of the instruction its bytes cannot be checked.
+    const size_t size = inst->size();
+
+    bool start = atBlockStart;
+    if (recording && (!one_page || size == 0 ||
+                vaddr != recBlock.startAddr + recBlock.bytes.size() ||
+                page != roundDown(recBlock.startAddr, blockPageBytes))) {
+        // Blocks stay within a page and hold contiguous instructions, so
+        // end this one here and try to start a new one with this
+        // instruction.
+        finishRecording();
+        start = true;
+    }
+
+    if (!recording) {
+        if (!start || !one_page || size == 0 ||
+                !translateBlockAddr(vaddr, recPaddr)) {
+            return;
+        }
+        recBlock.insts.clear();
+        recBlock.bytes.clear();
+        recBlock.startAddr = vaddr;
+        recording = true;
+    }
+
+    // Read back the bytes the instruction was just decoded from.
+    const size_t offset = recBlock.bytes.size();
+    recBlock.bytes.resize(offset + size);
+    blockProxy.readBlobPhys(recPaddr + offset, Request::INST_FETCH,
+                            recBlock.bytes.data() + offset, size);
+
+    BasicBlock::Entry entry;
+    entry.fetchPC.reset(blockFetchPC->clone());
+    entry.decodePC.reset(threadInfo[curThread]->thread->pcState().clone());
+    entry.inst = inst;
+    recBlock.insts.push_back(std::move(entry));
+    recBlock.endAddr = vaddr + 1;
+}
+
+void
+AtomicSimpleCPU::recordCommit(const Fault &fault)
+{
+    if (fault != NoFault) {
+        recording = false;
+        atBlockStart = true;
+        return;
+    }
+
+    // Wait for the rest of the macroop.
+    if (curMacroStaticInst)
+        return;
+
+    if (recording && recEndsBlock)
+        finishRecording();
+    // If nothing is being recorded, try to start a block at the next
+    // instruction.
+    atBlockStart = recEndsBlock || !recording;
+}
+
+void
+AtomicSimpleCPU::finishRecording()
+{
+    recording = false;
+    if (recBlock.insts.empty())
+        return;
+
+    DPRINTF(SimpleCPU, "Recorded block of %d instructions at %#x "
+            "(paddr %#x)\n", recBlock.insts.size(), recBlock.startAddr,
+            recPaddr);
+    blockPages[roundDown(recPaddr, blockPageBytes)][recPaddr] =
+        std::move(recBlock);
+    recBlock = BasicBlock();
+}
+
+Tick
+AtomicSimpleCPU::executeBlock()
+{
+    SimpleExecContext &t_info = *threadInfo[curThread];
+    SimpleThread *thread = t_info.thread;
+
+    if (blockPages.empty())
+        return 0;
+
+    Addr paddr;
+    if (!translateBlockAddr(thread->pcState().instAddr(), paddr))
+        return 0;
+
+    auto page_it = blockPages.find(roundDown(paddr, blockPageBytes));
+    if (page_it == blockPages.end())
+        return 0;
+    auto block_it = page_it->second.find(paddr);
+    if (block_it == page_it->second.end())
+        return 0;
+
+    // Events at the first PC have already been serviced by the caller;
+    // the rest of the block must be free of them. A block starting in
+    // microcode ROM would leave the normal path half way through a
+    // macroop, so let it handle those.
+    const BasicBlock &block = block_it->second;
+    const BasicBlock::Entry &first = block.insts.front();
+    if (*first.fetchPC != thread->pcState() ||
+            (first.inst->isMacroop() &&
+             isRomMicroPC(first.decodePC->microPC())) ||
+            thread->pcEventQueue.hasEvents(block.startAddr + 1,
+                                           block.endAddr)) {
+        return 0;
+    }
+
+    // Stores seen by this CPU have already discarded stale blocks, but
+    // not writes that bypassed it.
+    blockCheckBytes.resize(block.bytes.size());
+    blockProxy.readBlobPhys(block_it->first, Request::INST_FETCH,
+                            blockCheckBytes.data(), blockCheckBytes.size());
+    if (blockCheckBytes != block.bytes) {
+        DPRINTF(SimpleCPU, "Code of block at %#x (paddr %#x) changed\n",
+                block.startAddr, block_it->first);
+        page_it->second.erase(block_it);
+        if (page_it->second.empty())
+            blockPages.erase(page_it);
+        return 0;
+    }
+
+    // Stores to this page must not free the block under our feet.
+    inBlock = true;
+    execPage = page_it->first;
+    execPageWritten = false;
+
+    EventQueue &inst_events = thread->comInstEventQueue;
+    Tick latency = 0;
+    Counter ops = 0;
+    for (const auto &entry : block.insts) {
+        if (ops) {
+            // Leave the block if control flow went elsewhere or an
+            // instruction count event is due.
+            if (*entry.fetchPC != thread->pcState())
+                break;
+            if (!inst_events.empty() &&
+                    inst_events.nextTick() <= t_info.numInst) {
+                break;
+            }
+        }
+
+        thread->pcState(*entry.decodePC);
+        t_info.stayAtPC = false;
+
+        Fault fault = NoFault;
+        if (entry.inst->isMacroop()) {
+            curMacroStaticInst = entry.inst;
+            do {
+                MicroPC upc = thread->pcState().microPC();
+                if (isRomMicroPC(upc))
+                    break;
+                curStaticInst = curMacroStaticInst->fetchMicroop(upc);
+                fault = executeBlockInst(latency);
+                ++ops;
+            } while (fault == NoFault && curMacroStaticInst);
+        } else {
+            curStaticInst = entry.inst;
+            fault = executeBlockInst(latency);
+            ++ops;
+        }
+
+        // Code written by the block itself has to be fetched again.
+        if (fault != NoFault || curMacroStaticInst || locked ||
+                execPageWritten) {
+            break;
+        }
+    }
+
+    inBlock = false;
+    if (execPageWritten) {
+        DPRINTF(SimpleCPU, "Block at %#x wrote to its own page %#x\n",
+                block.startAddr, execPage);
+        blockPages.erase(execPage);
+    }
+
+    // The decoder didn't see any of this, so make sure it starts afresh.
+    thread->decoder->reset();
+    atBlockStart = true;
+
+    // The caller has already counted the first cycle.
+    if (ops)
+        baseStats.numCycles += ops - 1;
+    return latency;
+}
+
+Fault
+AtomicSimpleCPU::executeBlockInst(Tick &latency)
+{
+    SimpleExecContext &t_info = *threadInfo[curThread];
+    SimpleThread *thread = t_info.thread;
+
+    t_info.setPredicate(true);
+    t_info.setMemAccPredicate(true);
+
+#if TRACING_ON
+    traceData = tracer->getInstRecord(curTick(), thread->getTC(),
+            curStaticInst, thread->pcState(), curMacroStaticInst);
+#endif // TRACING_ON
+
+    dcache_access = false;
+    Tick stall_ticks = 0;
+
+    Fault fault = curStaticInst->execute(&t_info, traceData);
+    if (fault == NoFault) {
+        countInst();
+        ppCommit->notify(std::make_pair(thread, curStaticInst));
+    } else if (traceData) {
+        traceFault();
+    }
+
+    if (fault != NoFault &&
+        std::dynamic_pointer_cast<SyscallRetryFault>(fault)) {
+        stall_ticks += clockEdge(syscallRetryLatency) - curTick();
+    }
+
+    postExecute();
+
+    if (!curStaticInst->isMicroop() || curStaticInst->isFirstMicroop())
+        instCnt++;
+
+    if (simulate_data_stalls && dcache_access)
+        stall_ticks += dcache_latency;
+
+    // Each instruction takes at least a cycle, as in tick().
+    latency += std::max(clockPeriod(),
+            divCeil(stall_ticks, clockPeriod()) * clockPeriod());
+
+    advancePC(fault);
+    return fault;
+}
+
+void
+AtomicSimpleCPU::invalidateBlocks(Addr paddr, Addr size)
+{
+    if (!basicBlockCache || size == 0)
+        return;
+
+    const Addr first = roundDown(paddr, blockPageBytes);
+    const Addr last = roundDown(paddr + size - 1, blockPageBytes);
+    for (Addr page = first; page <= last; page += blockPageBytes) {
+        if (recording && roundDown(recPaddr, blockPageBytes) == page)
+            recording = false;
+        if (inBlock && page == execPage) {
+            execPageWritten = true;
+            continue;
+        }
+        if (!blockPages.empty() && blockPages.erase(page)) {
+            DPRINTF(SimpleCPU, "Write to %#x discarded blocks of page %#x\n",
+                    paddr, page);
+        }
+    }
+}
+
+void
+AtomicSimpleCPU::flushBlocks()
+{
+    blockPages.clear();
+    recording = false;
+    atBlockStart = true;
+}
+
 void
 AtomicSimpleCPU::tick()
 {
@@ -647,11 +996,20 @@ AtomicSimpleCPU::tick()
 
         serviceInstCountEvents();
 
-        Fault fault = NoFault;
-
         const PCStateBase &pc = thread->pcState();
 
         bool needToFetch = !isRomMicroPC(pc.microPC()) && !curMacroStaticInst;
+
+        if (basicBlockCache && needToFetch && atBlockStart && !locked &&
+                t_info.fetchOffset == 0) {
+            Tick block_latency = executeBlock();
+            if (block_latency) {
+                latency += block_latency;
+                continue;
+            }
+        }
+
+        Fault fault = NoFault;
         if (needToFetch) {
             ifetch_req->taskId(taskId());
             setupFetchRequest(ifetch_req);
@@ -677,8 +1035,14 @@ AtomicSimpleCPU::tick()
                 //}
             }
 
+            if (basicBlockCache && needToFetch)
+                set(blockFetchPC, thread->pcState());
+
             preExecute();
 
+            if (basicBlockCache && needToFetch && !t_info.stayAtPC)
+                recordInst();
+
             Tick stall_ticks = 0;
             if (curStaticInst) {
                 fault = curStaticInst->execute(&t_info, traceData);
@@ -723,8 +1087,11 @@ AtomicSimpleCPU::tick()
             }
 
         }
-        if (fault != NoFault || !t_info.stayAtPC)
+        if (fault != NoFault || !t_info.stayAtPC) {
             advancePC(fault);
+            if (basicBlockCache)
+                recordCommit(fault);
+        }
     }
 
     if (tryCompleteDrain())
@@ -41,8 +41,13 @@
 #ifndef __CPU_SIMPLE_ATOMIC_HH__
 #define __CPU_SIMPLE_ATOMIC_HH__
 
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
 #include "cpu/simple/base.hh"
 #include "cpu/simple/exec_context.hh"
+#include "mem/port_proxy.hh"
 #include "mem/request.hh"
 #include "params/BaseAtomicSimpleCPU.hh"
 #include "sim/probe/probe.hh"
@@ -70,6 +75,129 @@ class AtomicSimpleCPU : public BaseSimpleCPU
     // main simulation loop (one cycle)
     void tick();
 
+    /**
+     * @name Basic block cache
+     *
+     * When enabled, the normal fetch/decode/execute path records the
+     * instructions it decodes into basic blocks, which end at the first
+     * control, serializing, non-speculative or system call instruction
+     * or at a page boundary. When a block is entered again, its
+     * instructions are executed back-to-back without fetching or
+     * decoding them, and interrupts are only checked on block entry.
+     *
+     * Blocks are indexed by the physical address of their first
+     * instruction and are only entered if the thread's PC state matches
+     * the one they were decoded with. PC events and instruction count
+     * events are still honoured exactly, by falling back to the normal
+     * path for blocks containing a PC event and by leaving a block when
+     * an instruction count event becomes due. Writes to a page seen by
+     * this CPU, either from its own stores or through snoops, discard
+     * the blocks recorded from it. Code can also change without this CPU
+     * seeing a write, e.g. through DMA, system call emulation, another
+     * core whose writes only reach the instruction cache, or a page
+     * being mapped again, so the instruction bytes of a block are also
+     * compared with memory every time it is entered.
+     *
+     * @{
+     */
+    struct BasicBlock
+    {
+        struct Entry
+        {
+            /** PC state the instruction was fetched with. */
+            std::unique_ptr<PCStateBase> fetchPC;
+            /** PC state after decoding the instruction. */
+            std::unique_ptr<PCStateBase> decodePC;
+            /** The decoded instruction, possibly a macroop. */
+            StaticInstPtr inst;
+        };
+
+        std::vector<Entry> insts;
+        /** Instruction bytes the block was decoded from. */
+        std::vector<uint8_t> bytes;
+        /** Virtual address range of the block, for PC event checks. */
+        Addr startAddr = 0;
+        Addr endAddr = 0;
+    };
+
+    /** Smallest page size of any ISA, which blocks must not cross. */
+    static constexpr Addr blockPageBytes = 4096;
+
+    const bool basicBlockCache;
+
+    /** Blocks, indexed by physical page and then physical address. */
+    std::unordered_map<Addr, std::unordered_map<Addr, BasicBlock>>
+        blockPages;
+
+    /** The block being recorded by the normal execution path. */
+    BasicBlock recBlock;
+    /** Physical address of the first instruction of recBlock. */
+    Addr recPaddr;
+    /** True while recBlock is valid and being extended. */
+    bool recording;
+    /** True if the instruction being executed ends recBlock. */
+    bool recEndsBlock;
+    /** True if the next instruction starts a new basic block. */
+    bool atBlockStart;
+    /** True while executeBlock() runs a block from execPage. */
+    bool inBlock;
+    /** Physical page of the block executeBlock() is running. */
+    Addr execPage;
+    /**
+     * Set when execPage is written while one of its blocks runs. The
+     * block is then left before its next instruction, and the page is
+     * only discarded once executeBlock() no longer refers to it.
+     */
+    bool execPageWritten;
+    /** PC state of the instruction being fetched by the normal path. */
+    std::unique_ptr<PCStateBase> blockFetchPC;
+    /** Request used to translate block start addresses. */
+    RequestPtr block_req;
+    /** Memory contents read back when entering a block. */
+    std::vector<uint8_t> blockCheckBytes;
+
+    /** Check if an instruction must be the last one in a block. */
+    static bool endsBlock(const StaticInstPtr &inst);
+
+    /**
+     * Translate the address of the instruction at the current PC.
+     *
+     * @return false if the translation faulted.
+     */
+    bool translateBlockAddr(Addr vaddr, Addr &paddr);
+
+    /**
+     * Add the instruction just decoded by the normal path to the block
+     * being recorded, starting a new block if needed.
+     */
+    void recordInst();
+
+    /**
+     * Update the recording state after the normal path has executed an
+     * instruction and advanced the PC.
+     */
+    void recordCommit(const Fault &fault);
+
+    /** Save the block being recorded, if any, to the cache. */
+    void finishRecording();
+
+    /**
+     * Execute the cached block starting at the current PC, if any.
+     *
+     * @return The latency of the block, or 0 if no block was executed.
+     */
+    Tick executeBlock();
+
+    /** Execute curStaticInst on behalf of executeBlock. */
+    Fault executeBlockInst(Tick &latency);
+
+    /** Discard blocks recorded from pages written to. */
+    void invalidateBlocks(Addr paddr, Addr size);
+
+    /** Discard all recorded blocks. */
+    void flushBlocks();
+    /** @} */
+
     /**
      * Check if a system is in a drained state.
      *
@@ -161,6 +289,9 @@ class AtomicSimpleCPU : public BaseSimpleCPU
     AtomicCPUPort icachePort;
     AtomicCPUDPort dcachePort;
 
+    /** Reads the instruction bytes of basic blocks functionally. */
+    PortProxy blockProxy;
+
 
     RequestPtr ifetch_req;
     RequestPtr data_read_req;
@@ -73,6 +73,80 @@ TimingSimpleCPU::TimingCPUPort::TickEvent::schedule(PacketPtr _pkt, Tick t)
     cpu->schedule(this, t);
 }
 
+bool
+TimingSimpleCPU::TimingCPUPort::tryBackdoorAccess(PacketPtr pkt)
+{
+    // anything the memory system has to see, or that comes back in
+    // fragments, goes the normal way
+    if ((pkt->cmd != MemCmd::ReadReq && pkt->cmd != MemCmd::WriteReq) ||
+        pkt->isHtmTransactional() || pkt->senderState) {
+        return false;
+    }
+
+    const AddrRange range = pkt->getAddrRange();
+    auto bd_it = memBackdoors.contains(range);
+    if (bd_it == memBackdoors.end()) {
+        const Addr block = pkt->getAddr() & ~(backdoorBlockSize - 1);
+        if (noBackdoorBlocks.count(block))
+            return false;
+
+        MemBackdoorPtr bd = nullptr;
+        sendMemBackdoorReq(MemBackdoorReq(range, MemBackdoor::Readable), bd);
+        if (bd && bd->latencyOnly() && range.isSubset(bd->range())) {
+            bd_it = memBackdoors.insert(bd->range(), bd);
+        }
+
+        if (bd_it == memBackdoors.end()) {
+            noBackdoorBlocks.insert(block);
+            return false;
+        }
+
+        // forget the back door if it goes away, e.g. as the memory
+        // has to see the accesses to a locked address
+        auto callback = [this](const MemBackdoor &backdoor) {
+                for (auto it = memBackdoors.begin();
+                        it != memBackdoors.end(); it++) {
+                    if (it->second == &backdoor) {
+                        memBackdoors.erase(it);
+                        return;
+                    }
+                }
+                panic("Got invalidation for unknown memory backdoor.");
+            };
+        bd->addInvalidationCallback(callback);
+    }
+
+    MemBackdoorPtr bd = bd_it->second;
+    if (pkt->isWrite() && !bd->writeable())
+        return false;
+
+    DPRINTF(SimpleCPU, "Backdoor access %s\n", pkt->print());
+
+    uint8_t *host_addr = bd->ptr() + (pkt->getAddr() - bd->range().start());
+    if (pkt->isRead())
+        pkt->setData(host_addr);
+    else
+        pkt->writeData(host_addr);
+    pkt->makeResponse();
+
+    // the CPU blocks on the access, so there is only ever one
+    assert(!backdoorPkt);
+    backdoorPkt = pkt;
+    cpu->schedule(backdoorRespEvent, curTick() + bd->latency());
+    return true;
+}
+
+void
+TimingSimpleCPU::TimingCPUPort::recvBackdoorResp()
+{
+    PacketPtr pkt = backdoorPkt;
+    backdoorPkt = nullptr;
+
+    // a single access in flight is never refused
+    [[maybe_unused]] bool success = recvTimingResp(pkt);
+    assert(success);
+}
+
 TimingSimpleCPU::TimingSimpleCPU(const BaseTimingSimpleCPUParams &p)
     : BaseSimpleCPU(p), fetchTranslation(this), icachePort(this),
       dcachePort(this), ifetch_pkt(NULL), dcache_pkt(NULL), previousCycle(0),
@@ -282,7 +356,8 @@ TimingSimpleCPU::handleReadPacket(PacketPtr pkt)
         new IprEvent(pkt, this, clockEdge(delay));
         _status = DcacheWaitResponse;
         dcache_pkt = NULL;
-    } else if (!dcachePort.sendTimingReq(pkt)) {
+    } else if (!dcachePort.tryBackdoorAccess(pkt) &&
+               !dcachePort.sendTimingReq(pkt)) {
         _status = DcacheRetry;
         dcache_pkt = pkt;
     } else {
@@ -463,7 +538,7 @@ TimingSimpleCPU::initiateMemRead(Addr addr, unsigned size,
     if (traceData)
         traceData->setMem(addr, size, flags);
 
-    RequestPtr req = std::make_shared<Request>(
+    RequestPtr req = Request::create(
         addr, size, flags, dataRequestorId(), pc, thread->contextId());
     req->setByteEnable(byte_enable);
 
@@ -511,7 +586,8 @@ TimingSimpleCPU::handleWritePacket()
         new IprEvent(dcache_pkt, this, clockEdge(delay));
         _status = DcacheWaitResponse;
         dcache_pkt = NULL;
-    } else if (!dcachePort.sendTimingReq(dcache_pkt)) {
+    } else if (!dcachePort.tryBackdoorAccess(dcache_pkt) &&
+               !dcachePort.sendTimingReq(dcache_pkt)) {
         _status = DcacheRetry;
     } else {
         _status = DcacheWaitResponse;
@@ -545,7 +621,7 @@ TimingSimpleCPU::writeMem(uint8_t *data, unsigned size,
     if (traceData)
         traceData->setMem(addr, size, flags);
 
-    RequestPtr req = std::make_shared<Request>(
+    RequestPtr req = Request::create(
         addr, size, flags, dataRequestorId(), pc, thread->contextId());
     req->setByteEnable(byte_enable);
 
@@ -601,9 +677,10 @@ TimingSimpleCPU::initiateMemAMO(Addr addr, unsigned size,
     if (traceData)
         traceData->setMem(addr, size, flags);
 
-    RequestPtr req = std::make_shared<Request>(addr, size, flags,
-                            dataRequestorId(), pc, thread->contextId(),
-                            std::move(amo_op));
+    RequestPtr req = Request::create(addr, size, flags,
+                                     dataRequestorId(), pc,
+                                     thread->contextId(),
+                                     std::move(amo_op));
 
     assert(req->hasAtomicOpFunctor());
 
@@ -698,7 +775,7 @@ TimingSimpleCPU::fetch()
 
     if (needToFetch) {
         _status = BaseSimpleCPU::Running;
-        RequestPtr ifetch_req = std::make_shared<Request>();
+        RequestPtr ifetch_req = Request::create();
         ifetch_req->taskId(taskId());
         ifetch_req->setContext(thread->contextId());
         setupFetchRequest(ifetch_req);
@@ -728,7 +805,8 @@ TimingSimpleCPU::sendFetch(const Fault &fault, const RequestPtr &req,
         ifetch_pkt->dataStatic(decoder->moreBytesPtr());
         DPRINTF(SimpleCPU, " -- pkt addr: %#x\n", ifetch_pkt->getAddr());
 
-        if (!icachePort.sendTimingReq(ifetch_pkt)) {
+        if (!icachePort.tryBackdoorAccess(ifetch_pkt) &&
+            !icachePort.sendTimingReq(ifetch_pkt)) {
             // Need to wait for retry
             _status = IcacheRetry;
         } else {
@@ -1244,7 +1322,7 @@ TimingSimpleCPU::initiateMemMgmtCmd(Request::Flags flags)
     if (traceData)
         traceData->setMem(addr, size, flags);
 
-    RequestPtr req = std::make_shared<Request>(
+    RequestPtr req = Request::create(
         addr, size, flags, dataRequestorId());
 
     req->setPC(pc);
@@ -1299,7 +1377,7 @@ TimingSimpleCPU::htmSendAbortSignal(ThreadID tid, uint64_t htm_uid,
 
     // notify l1 d-cache (ruby) that core has aborted transaction
 
-    RequestPtr req = std::make_shared<Request>(
+    RequestPtr req = Request::create(
         addr, size, flags, dataRequestorId());
 
     req->setPC(pc);
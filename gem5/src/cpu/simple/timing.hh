@@ -41,10 +41,14 @@
 #ifndef __CPU_SIMPLE_TIMING_HH__
 #define __CPU_SIMPLE_TIMING_HH__
 
+#include <unordered_set>
+
 #include "arch/generic/mmu.hh"
+#include "base/addr_range_map.hh"
 #include "cpu/simple/base.hh"
 #include "cpu/simple/exec_context.hh"
 #include "cpu/translation.hh"
+#include "mem/backdoor.hh"
 #include "params/BaseTimingSimpleCPU.hh"
 
 namespace gem5
@@ -165,9 +169,21 @@ class TimingSimpleCPU : public BaseSimpleCPU
 
         TimingCPUPort(const std::string& _name, TimingSimpleCPU* _cpu)
             : RequestPort(_name), cpu(_cpu),
-              retryRespEvent([this]{ sendRetryResp(); }, name())
+              retryRespEvent([this]{ sendRetryResp(); }, name()),
+              backdoorRespEvent([this]{ recvBackdoorResp(); }, name())
         { }
 
+        /**
+         * Access a memory that only models its latency through a back
+         * door instead of sending the packet, and receive the response
+         * once the latency has passed. Only plain reads and writes that
+         * are not split are eligible.
+         *
+         * @param pkt Request to access the memory with
+         * @return Whether the access went through a back door
+         */
+        bool tryBackdoorAccess(PacketPtr pkt);
+
       protected:
 
         TimingSimpleCPU* cpu;
@@ -183,6 +199,23 @@ class TimingSimpleCPU : public BaseSimpleCPU
         };
 
         EventFunctionWrapper retryRespEvent;
+
+        /** Back doors to latency-only memories. */
+        AddrRangeMap<MemBackdoorPtr, 1> memBackdoors;
+
+        /**
+         * Aligned blocks of backdoorBlockSize bytes found to have no
+         * latency-only back door, so as to only ask once.
+         */
+        std::unordered_set<Addr> noBackdoorBlocks;
+        static constexpr Addr backdoorBlockSize = 4096;
+
+        /** Request accessed through a back door, waiting for its latency. */
+        PacketPtr backdoorPkt = nullptr;
+
+        /** Receive the response of the access through a back door. */
+        void recvBackdoorResp();
+        EventFunctionWrapper backdoorRespEvent;
     };
 
     class IcachePort : public TimingCPUPort
@@ -0,0 +1,51 @@
+# Copyright (c) 2026 The Regents of the University of California.
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+from m5.params import *
+from m5.SimObject import SimObject
+
+
+class BranchTraceReplayer(SimObject):
+    """Replays a branch trace recorded by BranchTraceRecorder through a
+    branch predictor, without simulating a CPU. Each branch is predicted,
+    corrected if needed, and committed before the next one, as the
+    championship branch prediction frameworks do. The number of
+    mispredictions per kilo instruction of each branch type is reported in
+    the stats. The simulation exits once the trace has been replayed.
+    """
+
+    type = "BranchTraceReplayer"
+    cxx_header = "cpu/testers/bpred_replay/branch_trace_replayer.hh"
+    cxx_class = "gem5::BranchTraceReplayer"
+
+    traceFile = Param.String("Branch trace to replay")
+    maxBranches = Param.UInt64(
+        0, "Number of branches to replay, zero replays the whole trace"
+    )
+    branchPred = Param.BranchPredictor("Branch predictor to evaluate")
+
+    # The branch predictor objects take these from their parent
+    numThreads = Param.Unsigned(1, "Number of threads")
@@ -0,0 +1,228 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cpu/testers/bpred_replay/branch_trace_replayer.hh"
+
+#include <memory>
+
+#include "arch/generic/pcstate.hh"
+#include "base/logging.hh"
+#include "cpu/op_class.hh"
+#include "proto/branch.pb.h"
+#include "sim/sim_exit.hh"
+
+namespace gem5
+{
+
+namespace
+{
+
+/** PC of the replayed branches, advanced by the instruction size */
+typedef GenericISA::SimplePCState<4> ReplayPCState;
+
+/**
+ * Instruction with the control flags of a branch type, used to present
+ * the trace branches to the predictor. The size is set for every branch
+ * before it is predicted.
+ */
+class ReplayBranchInst : public StaticInst
+{
+  public:
+    ReplayBranchInst(enums::BranchType type)
+        : StaticInst("replay_branch", No_OpClass)
+    {
+        flags[IsControl] = true;
+        switch (type) {
+          case enums::Return:
+            flags[IsReturn] = true;
+            flags[IsIndirectControl] = true;
+            flags[IsUncondControl] = true;
+            break;
+          case enums::CallDirect:
+            flags[IsCall] = true;
+            flags[IsDirectControl] = true;
+            flags[IsUncondControl] = true;
+            break;
+          case enums::CallIndirect:
+            flags[IsCall] = true;
+            flags[IsIndirectControl] = true;
+            flags[IsUncondControl] = true;
+            break;
+          case enums::DirectCond:
+            flags[IsDirectControl] = true;
+            flags[IsCondControl] = true;
+            break;
+          case enums::DirectUncond:
+            flags[IsDirectControl] = true;
+            flags[IsUncondControl] = true;
+            break;
+          case enums::IndirectCond:
+            flags[IsIndirectControl] = true;
+            flags[IsCondControl] = true;
+            break;
+          case enums::IndirectUncond:
+            flags[IsIndirectControl] = true;
+            flags[IsUncondControl] = true;
+            break;
+          default:
+            panic("No replay instruction for branch type %d.", type);
+        }
+    }
+
+    Fault
+    execute(ExecContext *xc, trace::InstRecord *traceData) const override
+    {
+        panic("Replayed branches cannot be executed.");
+    }
+
+    void
+    advancePC(PCStateBase &pc) const override
+    {
+        pc.set(pc.instAddr() + _size);
+    }
+
+    std::unique_ptr<PCStateBase>
+    buildRetPC(const PCStateBase &cur_pc,
+               const PCStateBase &call_pc) const override
+    {
+        std::unique_ptr<PCStateBase> ret_pc(call_pc.clone());
+        ret_pc->set(call_pc.instAddr() + _size);
+        return ret_pc;
+    }
+
+    std::string
+    generateDisassembly(Addr pc,
+                        const loader::SymbolTable *symtab) const override
+    {
+        return mnemonic;
+    }
+};
+
+} // anonymous namespace
+
+BranchTraceReplayer::BranchTraceReplayer(
+        const BranchTraceReplayerParams &params)
+    : SimObject(params),
+      bpred(params.branchPred),
+      trace(params.traceFile),
+      traceFile(params.traceFile),
+      maxBranches(params.maxBranches),
+      seqNum(1),
+      replayEvent([this]{ replay(); }, name()),
+      stats(this)
+{
+    fatal_if(!bpred, "%s needs a branch predictor.", name());
+
+    ProtoMessage::BranchHeader header;
+    fatal_if(!trace.read(header), "Failed to read the header of %s.",
+             traceFile);
+
+    for (int type = 0; type < enums::Num_BranchType; type++) {
+        if (type != enums::NoBranch) {
+            branchInsts[type] =
+                new ReplayBranchInst(enums::BranchType(type));
+        }
+    }
+}
+
+void
+BranchTraceReplayer::startup()
+{
+    schedule(replayEvent, curTick());
+}
+
+void
+BranchTraceReplayer::replay()
+{
+    const ThreadID tid = 0;
+    ProtoMessage::Branch msg;
+    uint64_t replayed = 0;
+
+    while ((maxBranches == 0 || replayed < maxBranches) && trace.read(msg)) {
+        const unsigned type = msg.type();
+        if (type == enums::NoBranch || type >= enums::Num_BranchType) {
+            warn_once("%s: Skipping trace records with invalid branch "
+                      "types.", name());
+            continue;
+        }
+
+        const StaticInstPtr &inst = branchInsts[type];
+        inst->size(msg.size());
+
+        const bool taken = msg.has_target();
+        const Addr next_pc = taken ? msg.target() : msg.pc() + msg.size();
+
+        // Predict the branch, then resolve it right away: squash it if
+        // the predicted next PC is wrong and commit it
+        ReplayPCState pc(msg.pc());
+        bpred->predict(inst, seqNum, pc, tid);
+        if (pc.instAddr() != next_pc) {
+            stats.mispredicts[type]++;
+            bpred->squash(seqNum, ReplayPCState(next_pc), taken, tid);
+        }
+        bpred->update(seqNum, tid);
+
+        stats.branches[type]++;
+        stats.insts += msg.insts();
+        seqNum++;
+        replayed++;
+    }
+
+    exitSimLoop(name() + " finished replaying " + traceFile);
+}
+
+BranchTraceReplayer::ReplayStats::ReplayStats(statistics::Group *parent)
+    : statistics::Group(parent),
+      ADD_STAT(insts, statistics::units::Count::get(),
+               "Number of instructions covered by the replayed branches"),
+      ADD_STAT(branches, statistics::units::Count::get(),
+               "Number of replayed branches"),
+      ADD_STAT(mispredicts, statistics::units::Count::get(),
+               "Number of branches with a mispredicted next PC"),
+      ADD_STAT(mpki, statistics::units::Ratio::get(),
+               "Mispredictions per kilo instruction")
+{
+    using namespace statistics;
+
+    branches
+        .init(enums::Num_BranchType)
+        .flags(total | pdf);
+    mispredicts
+        .init(enums::Num_BranchType)
+        .flags(total);
+    for (int type = 0; type < enums::Num_BranchType; type++) {
+        branches.subname(type, enums::BranchTypeStrings[type]);
+        mispredicts.subname(type, enums::BranchTypeStrings[type]);
+        mpki.subname(type, enums::BranchTypeStrings[type]);
+    }
+
+    mpki.flags(total);
+    mpki = mispredicts * 1000 / insts;
+}
+
+} // namespace gem5
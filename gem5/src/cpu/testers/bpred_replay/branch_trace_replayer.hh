@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_TESTERS_BPRED_REPLAY_BRANCH_TRACE_REPLAYER_HH__
+#define __CPU_TESTERS_BPRED_REPLAY_BRANCH_TRACE_REPLAYER_HH__
+
+#include <array>
+#include <cstdint>
+
+#include "base/statistics.hh"
+#include "cpu/inst_seq.hh"
+#include "cpu/pred/bpred_unit.hh"
+#include "cpu/static_inst.hh"
+#include "enums/BranchType.hh"
+#include "params/BranchTraceReplayer.hh"
+#include "proto/protoio.hh"
+#include "sim/eventq.hh"
+#include "sim/sim_object.hh"
+
+namespace gem5
+{
+
+/**
+ * Drives a branch predictor with the branches of a trace recorded by
+ * BranchTraceRecorder. Every branch is resolved right after it has been
+ * predicted, so the predictor is evaluated without the effects of a
+ * pipeline.
+ */
+class BranchTraceReplayer : public SimObject
+{
+  public:
+    BranchTraceReplayer(const BranchTraceReplayerParams &params);
+
+    void startup() override;
+
+  private:
+    /** Replays the trace and exits the simulation loop */
+    void replay();
+
+    /** The predictor being evaluated */
+    branch_prediction::BPredUnit *bpred;
+
+    /** The trace and its name */
+    ProtoInputStream trace;
+    const std::string traceFile;
+
+    /** Number of branches to replay, zero for all */
+    const uint64_t maxBranches;
+
+    /** Stand-in instruction for each branch type */
+    std::array<StaticInstPtr, enums::Num_BranchType> branchInsts;
+
+    /** Sequence number of the next branch */
+    InstSeqNum seqNum;
+
+    EventFunctionWrapper replayEvent;
+
+    struct ReplayStats : public statistics::Group
+    {
+        ReplayStats(statistics::Group *parent);
+
+        statistics::Scalar insts;
+        statistics::Vector branches;
+        statistics::Vector mispredicts;
+        statistics::Formula mpki;
+    } stats;
+};
+
+} // namespace gem5
+
+#endif // __CPU_TESTERS_BPRED_REPLAY_BRANCH_TRACE_REPLAYER_HH__
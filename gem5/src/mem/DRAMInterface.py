@@ -70,6 +70,18 @@ class DRAMInterface(MemInterface):
     # performance being lower when enabled
     enable_dram_powerdown = Param.Bool(False, "Enable powerdown states")
 
+    # check the bank-indexed FR-FCFS scheduler against a walk of the
+    # whole queue on every decision, for debugging
+    verify_frfcfs = Param.Bool(
+        False, "Verify FR-FCFS decisions against a full queue scan"
+    )
+
+    # Model the refreshes of idle ranks in closed form when the memory is
+    # next accessed or the stats are dumped, rather than with events,
+    # with the same results. Only takes effect with powerdown disabled,
+    # as ranks otherwise sleep through their refreshes
+    lazy_refresh = Param.Bool(False, "Model refreshes of idle ranks lazily")
+
     # For power modelling we need to know if the DRAM has a DLL or not
     dll = Param.Bool(True, "DRAM has DLL or not")
 
@@ -49,10 +49,19 @@ class SimpleMemory(AbstractMemory):
     latency = Param.Latency("30ns", "Request to response latency")
     latency_var = Param.Latency("0ns", "Request to response latency variance")
     # The memory bandwidth limit default is set to 12.8GiB/s which is
-    # representative of a x64 DDR3-1600 channel.
+    # representative of a x64 DDR3-1600 channel. A bandwidth of 0 turns
+    # off the limit: timing requests are then never refused, and only
+    # their latency is modelled.
     bandwidth = Param.MemoryBandwidth(
         "12.8GiB/s", "Combined read and write bandwidth"
     )
+    # Let timing requestors with a back door to the memory access it
+    # directly, only waiting for the latency, for memories whose timing
+    # is not of interest, such as ROMs and boot images. These accesses
+    # are not snooped or counted in the memory stats.
+    latency_only = Param.Bool(
+        False, "Let timing requestors access the memory through a back door"
+    )
 
     def controller(self):
         # Simple memory doesn't use a MemCtrl
@@ -39,8 +39,16 @@ class ThreadBridge(SimObject):
     the issue. The receiver side is expected to use the same EventQueue that
     the ThreadBridge is using.
 
-    Given that this is only used for simulation speed accelerating, only the
-    atomic and functional access are supported.
+    Atomic and functional accesses are migrated as described above. Timing
+    packets instead cross with the given delay, which must be at least the
+    simulation quantum when several event queues are used. They are handed
+    over at quantum barriers, and the bridge sends them on in the order of
+    the tick they arrived at, the incoming port and their arrival order on
+    that port, so that the result does not depend on how the event queues
+    are spread over host threads. Each incoming port can have req_size
+    requests and resp_size responses in the bridge. Credits for that space
+    come back across the queues with the same delay, and a sender that was
+    refused is sent a retry once they do.
 
     Example:
 
@@ -56,5 +64,13 @@ class ThreadBridge(SimObject):
     cxx_header = "mem/thread_bridge.hh"
     cxx_class = "gem5::ThreadBridge"
 
-    in_port = ResponsePort("Incoming port")
+    in_port = VectorResponsePort("Incoming ports")
     out_port = RequestPort("Outgoing port")
+
+    delay = Param.Latency("0ns", "Delay of timing packets across the bridge")
+    req_size = Param.Unsigned(
+        16, "The number of requests to buffer per incoming port"
+    )
+    resp_size = Param.Unsigned(
+        16, "The number of responses to buffer per incoming port"
+    )
@@ -154,6 +154,15 @@ class SnoopFilter(SimObject):
     # Sanity check on max capacity to track, adjust if needed.
     max_capacity = Param.MemorySize("8MiB", "Maximum capacity of snoop filter")
 
+    # Organise the filter as a bounded, set-associative directory,
+    # evicting lines and back-invalidating their holders when a set is
+    # full. The default of 0 sets tracks any number of lines, only
+    # bounded by the max_capacity sanity check.
+    sets = Param.Unsigned(
+        0, "Number of sets (power of 2) of a bounded filter, 0 if unbounded"
+    )
+    ways = Param.Unsigned(8, "Associativity of a bounded filter")
+
 
 # We use a coherent crossbar to connect multiple requestors to the L2
 # caches. Normally this crossbar would be part of the cache itself.
@@ -34,6 +34,7 @@
 
 #include "base/addr_range.hh"
 #include "base/callback.hh"
+#include "base/types.hh"
 
 namespace gem5
 {
@@ -89,6 +90,18 @@ class MemBackdoor
     Flags flags() const { return _flags; }
     void flags(Flags f) { _flags = f; }
 
+    // Whether timing requestors may access the data through this back door
+    // instead of sending packets, taking the given latency for each access.
+    // A target only allows this when the latency is all it models.
+    bool latencyOnly() const { return _latencyOnly; }
+    Tick latency() const { return _latency; }
+    void
+    latencyOnly(Tick l)
+    {
+        _latencyOnly = true;
+        _latency = l;
+    }
+
     MemBackdoor(AddrRange r, uint8_t *p, Flags flags) :
         _range(r), _ptr(p), _flags(flags)
     {}
@@ -122,6 +135,8 @@ class MemBackdoor
     AddrRange _range;
     uint8_t *_ptr;
     Flags _flags;
+    bool _latencyOnly = false;
+    Tick _latency = 0;
 };
 
 typedef MemBackdoor *MemBackdoorPtr;
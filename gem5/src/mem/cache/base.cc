@@ -252,7 +252,7 @@ BaseCache::handleTimingReqHit(PacketPtr pkt, CacheBlk *blk, Tick request_time)
             // Basically we need to get the MSHR in the same state as if
             // we had missed and just received the response.
             // Request *req2 = new Request(*(pkt->req));
-            RequestPtr req2 = std::make_shared<Request>(*(pkt->req));
+            RequestPtr req2 = Request::create(*(pkt->req));
             PacketPtr pkt2 = new Packet(req2, pkt->cmd);
             MSHR *mshr = allocateMissBuffer(pkt2, curTick(), true);
             // Mark the MSHR "in service" (even though it's not) to prevent
@@ -297,8 +297,9 @@ BaseCache::handleTimingReqHit(PacketPtr pkt, CacheBlk *blk, Tick request_time)
         // the calculateAccessLatency() function.
         cpuSidePort.schedTimingResp(pkt, request_time);
     } else {
-        DPRINTF(Cache, "%s satisfied %s, no response needed\n", __func__,
-                pkt->print());
+        DPRINTF_ADDR(Cache, pkt->getAddr(),
+            "%s satisfied %s, no response needed\n", __func__,
+            pkt->print());
 
         // queue the packet for deletion, as the sending cache is
         // still relying on it; if the block is found in access(),
@@ -340,8 +341,9 @@ BaseCache::handleTimingReqMiss(PacketPtr pkt, MSHR *mshr, CacheBlk *blk,
                 // uncached memory write, forwarded to WriteBuffer.
                 allocateWriteBuffer(pkt, forward_time);
             } else {
-                DPRINTF(Cache, "%s coalescing MSHR for %s\n", __func__,
-                        pkt->print());
+                DPRINTF_ADDR(Cache, pkt->getAddr(),
+                    "%s coalescing MSHR for %s\n", __func__,
+                    pkt->print());
 
                 assert(pkt->req->requestorId() < system->maxRequestors());
                 stats.cmdStats(pkt).mshrHits[pkt->req->requestorId()]++;
@@ -588,12 +590,14 @@ BaseCache::recvTimingResp(PacketPtr pkt)
     const bool is_error = pkt->isError();
 
     if (is_error) {
-        DPRINTF(Cache, "%s: Cache received %s with error\n", __func__,
-                pkt->print());
+        DPRINTF_ADDR(Cache, pkt->getAddr(),
+            "%s: Cache received %s with error\n", __func__,
+            pkt->print());
     }
 
-    DPRINTF(Cache, "%s: Handling response %s\n", __func__,
-            pkt->print());
+    DPRINTF_ADDR(Cache, pkt->getAddr(),
+        "%s: Handling response %s\n", __func__,
+        pkt->print());
 
     // if this is a write, we should be looking at an uncacheable
     // write
@@ -716,7 +720,8 @@ BaseCache::recvTimingResp(PacketPtr pkt)
     // copy writebacks to write buffer
     doWritebacks(writebacks, forward_time);
 
-    DPRINTF(CacheVerbose, "%s: Leaving with %s\n", __func__, pkt->print());
+    DPRINTF_ADDR(CacheVerbose, pkt->getAddr(),
+        "%s: Leaving with %s\n", __func__, pkt->print());
     delete pkt;
 }
 
@@ -741,8 +746,9 @@ BaseCache::recvAtomic(PacketPtr pkt)
         // block. If a dirty block is encountered a WriteClean
         // will update any copies to the path to the memory
         // until the point of reference.
-        DPRINTF(CacheVerbose, "%s: packet %s found block: %s\n",
-                __func__, pkt->print(), blk->print());
+        DPRINTF_ADDR(CacheVerbose, pkt->getAddr(),
+            "%s: packet %s found block: %s\n",
+            __func__, pkt->print(), blk->print());
         PacketPtr wb_pkt = writecleanBlk(blk, pkt->req->getDest(), pkt->id);
         writebacks.push_back(wb_pkt);
         pkt->setSatisfied();
@@ -835,9 +841,10 @@ BaseCache::functionalAccess(PacketPtr pkt, bool from_cpu_side)
         writeBuffer.trySatisfyFunctional(pkt) ||
         memSidePort.trySatisfyFunctional(pkt);
 
-    DPRINTF(CacheVerbose, "%s: %s %s%s%s\n", __func__,  pkt->print(),
-            (blk && blk->isValid()) ? "valid " : "",
-            have_data ? "data " : "", done ? "done " : "");
+    DPRINTF_ADDR(CacheVerbose, pkt->getAddr(),
+        "%s: %s %s%s%s\n", __func__,  pkt->print(),
+        (blk && blk->isValid()) ? "valid " : "",
+        have_data ? "data " : "", done ? "done " : "");
 
     // We're leaving the cache, so pop cache->name() label
     pkt->popLabel();
@@ -998,20 +1005,21 @@ BaseCache::getNextQueueEntry()
         if (pkt) {
             Addr pf_addr = pkt->getBlockAddr(blkSize);
             if (tags->findBlock({pf_addr, pkt->isSecure()})) {
-                DPRINTF(HWPrefetch, "Prefetch %#x has hit in cache, "
-                        "dropped.\n", pf_addr);
+                DPRINTF_ADDR(HWPrefetch, pf_addr,
+                    "Prefetch %#x has hit in cache, dropped.\n", pf_addr);
                 prefetcher->pfHitInCache();
                 // free the request and packet
                 delete pkt;
             } else if (mshrQueue.findMatch(pf_addr, pkt->isSecure())) {
-                DPRINTF(HWPrefetch, "Prefetch %#x has hit in a MSHR, "
-                        "dropped.\n", pf_addr);
+                DPRINTF_ADDR(HWPrefetch, pf_addr,
+                    "Prefetch %#x has hit in a MSHR, dropped.\n", pf_addr);
                 prefetcher->pfHitInMSHR();
                 // free the request and packet
                 delete pkt;
             } else if (writeBuffer.findMatch(pf_addr, pkt->isSecure())) {
-                DPRINTF(HWPrefetch, "Prefetch %#x has hit in the "
-                        "Write Buffer, dropped.\n", pf_addr);
+                DPRINTF_ADDR(HWPrefetch, pf_addr,
+                    "Prefetch %#x has hit in the Write Buffer, dropped.\n",
+                    pf_addr);
                 prefetcher->pfHitInWB();
                 // free the request and packet
                 delete pkt;
@@ -1248,7 +1256,8 @@ BaseCache::satisfyRequest(PacketPtr pkt, CacheBlk *blk, bool, bool)
         // supply data to any snoops that have appended themselves to
         // this cache before knowing the store will fail.
         blk->setCoherenceBits(CacheBlk::DirtyBit);
-        DPRINTF(CacheVerbose, "%s for %s (write)\n", __func__, pkt->print());
+        DPRINTF_ADDR(CacheVerbose, pkt->getAddr(),
+            "%s for %s (write)\n", __func__, pkt->print());
     } else if (pkt->isRead()) {
         if (pkt->isLLSC()) {
             blk->trackLoadLocked(pkt);
@@ -1273,8 +1282,9 @@ BaseCache::satisfyRequest(PacketPtr pkt, CacheBlk *blk, bool, bool)
     } else {
         assert(pkt->isInvalidate());
         invalidateBlock(blk);
-        DPRINTF(CacheVerbose, "%s for %s (invalidation)\n", __func__,
-                pkt->print());
+        DPRINTF_ADDR(CacheVerbose, pkt->getAddr(),
+            "%s for %s (invalidation)\n", __func__,
+            pkt->print());
     }
 }
 
@@ -1341,8 +1351,9 @@ BaseCache::access(PacketPtr pkt, CacheBlk *&blk, Cycles &lat,
     Cycles tag_latency(0);
     blk = tags->accessBlock(pkt, tag_latency);
 
-    DPRINTF(Cache, "%s for %s %s\n", __func__, pkt->print(),
-            blk ? "hit " + blk->print() : "miss");
+    DPRINTF_ADDR(Cache, pkt->getAddr(),
+        "%s for %s %s\n", __func__, pkt->print(),
+        blk ? "hit " + blk->print() : "miss");
 
     if (pkt->req->isCacheMaintenance()) {
         // A cache maintenance operation is always forwarded to the
@@ -1802,7 +1813,7 @@ BaseCache::writebackBlk(CacheBlk *blk)
 
     stats.writebacks[Request::wbRequestorId]++;
 
-    RequestPtr req = std::make_shared<Request>(
+    RequestPtr req = Request::create(
         regenerateBlkAddr(blk), blkSize, 0, Request::wbRequestorId);
 
     if (blk->isSecure())
@@ -1828,7 +1839,8 @@ BaseCache::writebackBlk(CacheBlk *blk)
     }
     //EMISSARY: END
 
-    DPRINTF(Cache, "Create Writeback %s writable: %d, dirty: %d\n",
+    DPRINTF_ADDR(Cache, pkt->getAddr(),
+        "Create Writeback %s writable: %d, dirty: %d\n",
         pkt->print(), blk->isSet(CacheBlk::WritableBit),
         blk->isSet(CacheBlk::DirtyBit));
 
@@ -1859,7 +1871,7 @@ BaseCache::writebackBlk(CacheBlk *blk)
 PacketPtr
 BaseCache::writecleanBlk(CacheBlk *blk, Request::Flags dest, PacketId id)
 {
-    RequestPtr req = std::make_shared<Request>(
+    RequestPtr req = Request::create(
         regenerateBlkAddr(blk), blkSize, 0, Request::wbRequestorId);
 
     if (blk->isSecure()) {
@@ -1874,8 +1886,9 @@ BaseCache::writecleanBlk(CacheBlk *blk, Request::Flags dest, PacketId id)
         pkt->setWriteThrough();
     }
 
-    DPRINTF(Cache, "Create %s writable: %d, dirty: %d\n", pkt->print(),
-            blk->isSet(CacheBlk::WritableBit), blk->isSet(CacheBlk::DirtyBit));
+    DPRINTF_ADDR(Cache, pkt->getAddr(),
+        "Create %s writable: %d, dirty: %d\n", pkt->print(),
+        blk->isSet(CacheBlk::WritableBit), blk->isSet(CacheBlk::DirtyBit));
 
     if (blk->isSet(CacheBlk::WritableBit)) {
         // not asserting shared means we pass the block in modified
@@ -1933,7 +1946,7 @@ BaseCache::writebackVisitor(CacheBlk &blk)
     if (blk.isSet(CacheBlk::DirtyBit)) {
         assert(blk.isValid());
 
-        RequestPtr request = std::make_shared<Request>(
+        RequestPtr request = Request::create(
             regenerateBlkAddr(&blk), blkSize, 0, Request::funcRequestorId);
 
         request->taskId(blk.getTaskId());
@@ -1988,7 +2001,8 @@ BaseCache::sendMSHRQueuePacket(MSHR* mshr)
     // use request from 1st target
     PacketPtr tgt_pkt = mshr->getTarget()->pkt;
 
-    DPRINTF(Cache, "%s: MSHR %s\n", __func__, tgt_pkt->print());
+    DPRINTF_ADDR(Cache, tgt_pkt->getAddr(),
+        "%s: MSHR %s\n", __func__, tgt_pkt->print());
 
     // if the cache is in write coalescing mode or (additionally) in
     // no allocation mode, and we have a write packet with an MSHR
@@ -2001,8 +2015,9 @@ BaseCache::sendMSHRQueuePacket(MSHR* mshr)
             // write a cache line
             if (writeAllocator->delay(mshr->blkAddr)) {
                 Tick delay = blkSize / tgt_pkt->getSize() * clockPeriod();
-                DPRINTF(CacheVerbose, "Delaying pkt %s %llu ticks to allow "
-                        "for write coalescing\n", tgt_pkt->print(), delay);
+                DPRINTF_ADDR(CacheVerbose, tgt_pkt->getAddr(),
+                    "Delaying pkt %s %llu ticks to allow "
+                    "for write coalescing\n", tgt_pkt->print(), delay);
                 mshrQueue.delay(mshr, delay);
                 return false;
             } else {
@@ -2070,8 +2085,9 @@ BaseCache::sendMSHRQueuePacket(MSHR* mshr)
             // block. If a dirty block is encountered a WriteClean
             // will update any copies to the path to the memory
             // until the point of reference.
-            DPRINTF(CacheVerbose, "%s: packet %s found block: %s\n",
-                    __func__, pkt->print(), blk->print());
+            DPRINTF_ADDR(CacheVerbose, pkt->getAddr(),
+                "%s: packet %s found block: %s\n",
+                __func__, pkt->print(), blk->print());
             PacketPtr wb_pkt = writecleanBlk(blk, pkt->req->getDest(),
                                              pkt->id);
             PacketList writebacks;
@@ -2091,7 +2107,8 @@ BaseCache::sendWriteQueuePacket(WriteQueueEntry* wq_entry)
     // always a single target for write queue entries
     PacketPtr tgt_pkt = wq_entry->getTarget()->pkt;
 
-    DPRINTF(Cache, "%s: write %s\n", __func__, tgt_pkt->print());
+    DPRINTF_ADDR(Cache, tgt_pkt->getAddr(),
+        "%s: write %s\n", __func__, tgt_pkt->print());
 
     // forward as is, both for evictions and uncacheable writes
     if (!memSidePort.sendTimingReq(tgt_pkt)) {
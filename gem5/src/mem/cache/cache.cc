@@ -169,7 +169,8 @@ Cache::access(PacketPtr pkt, CacheBlk *&blk, Cycles &lat,
                     "Should never see a write in a read-only cache %s\n",
                     name());
 
-        DPRINTF(Cache, "%s for %s\n", __func__, pkt->print());
+        DPRINTF_ADDR(Cache, pkt->getAddr(),
+            "%s for %s\n", __func__, pkt->print());
 
         // flush and invalidate any existing block
         CacheBlk *old_blk(tags->findBlock({pkt->getAddr(), pkt->isSecure()}));
@@ -266,7 +267,8 @@ Cache::doWritebacksAtomic(PacketList& writebacks)
 void
 Cache::recvTimingSnoopResp(PacketPtr pkt)
 {
-    DPRINTF(Cache, "%s for %s\n", __func__, pkt->print());
+    DPRINTF_ADDR(Cache, pkt->getAddr(),
+        "%s for %s\n", __func__, pkt->print());
 
     // determine if the response is from a snoop request we created
     // (in which case it should be in the outstandingSnoop), or if we
@@ -390,10 +392,10 @@ Cache::handleTimingReqMiss(PacketPtr pkt, CacheBlk *blk, Tick forward_time,
 
         if (!mshr) {
             // copy the request and create a new SoftPFReq packet
-            RequestPtr req = std::make_shared<Request>(pkt->req->getPaddr(),
-                                                    pkt->req->getSize(),
-                                                    pkt->req->getFlags(),
-                                                    pkt->req->requestorId());
+            RequestPtr req = Request::create(pkt->req->getPaddr(),
+                                             pkt->req->getSize(),
+                                             pkt->req->getFlags(),
+                                             pkt->req->requestorId());
             pf = new Packet(req, pkt->cmd);
             pf->allocate();
             assert(pf->matchAddr(pkt));
@@ -425,8 +427,9 @@ Cache::recvTimingReq(PacketPtr pkt)
         // a cache above us (but not where the packet came from) is
         // responding to the request, in other words it has the line
         // in Modified or Owned state
-        DPRINTF(Cache, "Cache above responding to %s: not responding\n",
-                pkt->print());
+        DPRINTF_ADDR(Cache, pkt->getAddr(),
+            "Cache above responding to %s: not responding\n",
+            pkt->print());
 
         // if the packet needs the block to be writable, and the cache
         // that has promised to respond (setting the cache responding
@@ -560,16 +563,18 @@ Cache::createMissPacket(PacketPtr cpu_pkt, CacheBlk *blk,
         // of date, however, there is no harm in conservatively
         // assuming the block has sharers
         pkt->setHasSharers();
-        DPRINTF(Cache, "%s: passing hasSharers from %s to %s\n",
-                __func__, cpu_pkt->print(), pkt->print());
+        DPRINTF_ADDR(Cache, pkt->getAddr(),
+            "%s: passing hasSharers from %s to %s\n",
+            __func__, cpu_pkt->print(), pkt->print());
     }
 
     // the packet should be block aligned
     assert(pkt->getAddr() == pkt->getBlockAddr(blkSize));
 
     pkt->allocate();
-    DPRINTF(Cache, "%s: created %s from %s\n", __func__, pkt->print(),
-            cpu_pkt->print());
+    DPRINTF_ADDR(Cache, pkt->getAddr(),
+        "%s: created %s from %s\n", __func__, pkt->print(),
+        cpu_pkt->print());
     return pkt;
 }
 
@@ -606,8 +611,9 @@ Cache::handleAtomicReqMiss(PacketPtr pkt, CacheBlk *&blk,
         bus_pkt = pkt;
     }
 
-    DPRINTF(Cache, "%s: Sending an atomic %s\n", __func__,
-            bus_pkt->print());
+    DPRINTF_ADDR(Cache, bus_pkt->getAddr(),
+        "%s: Sending an atomic %s\n", __func__,
+        bus_pkt->print());
 
     const std::string old_state = blk ? blk->print() : "";
 
@@ -616,8 +622,9 @@ Cache::handleAtomicReqMiss(PacketPtr pkt, CacheBlk *&blk,
     bool is_invalidate = bus_pkt->isInvalidate();
 
     // We are now dealing with the response handling
-    DPRINTF(Cache, "%s: Receive response: %s for %s\n", __func__,
-            bus_pkt->print(), old_state);
+    DPRINTF_ADDR(Cache, bus_pkt->getAddr(),
+        "%s: Receive response: %s for %s\n", __func__,
+        bus_pkt->print(), old_state);
 
     // If packet was a forward, the response (if any) is already
     // in place in the bus_pkt == pkt structure, so we don't need
@@ -673,8 +680,9 @@ Cache::recvAtomic(PacketPtr pkt)
     // above us is responding
     if (pkt->cacheResponding()) {
         assert(!pkt->req->isCacheInvalidate());
-        DPRINTF(Cache, "Cache above responding to %s: not responding\n",
-                pkt->print());
+        DPRINTF_ADDR(Cache, pkt->getAddr(),
+            "Cache above responding to %s: not responding\n",
+            pkt->print());
 
         // if a cache is responding, and it had the line in Owned
         // rather than Modified state, we need to invalidate any
@@ -897,8 +905,9 @@ Cache::serviceMSHRTargets(MSHR *mshr, const PacketPtr pkt, CacheBlk *blk)
                 // propagate that.  Response should not have
                 // isInvalidate() set otherwise.
                 tgt_pkt->cmd = MemCmd::ReadRespWithInvalidate;
-                DPRINTF(Cache, "%s: updated cmd to %s\n", __func__,
-                        tgt_pkt->print());
+                DPRINTF_ADDR(Cache, tgt_pkt->getAddr(),
+                    "%s: updated cmd to %s\n", __func__,
+                    tgt_pkt->print());
             }
             // Reset the bus additional time as it is now accounted for
             tgt_pkt->headerDelay = tgt_pkt->payloadDelay = 0;
@@ -975,7 +984,7 @@ Cache::cleanEvictBlk(CacheBlk *blk)
     assert(blk && blk->isValid() && !blk->isSet(CacheBlk::DirtyBit));
 
     // Creating a zero sized write, a message to the snoop filter
-    RequestPtr req = std::make_shared<Request>(
+    RequestPtr req = Request::create(
         regenerateBlkAddr(blk), blkSize, 0, Request::wbRequestorId);
 
     if (blk->isSecure())
@@ -985,7 +994,8 @@ Cache::cleanEvictBlk(CacheBlk *blk)
 
     PacketPtr pkt = new Packet(req, MemCmd::CleanEvict);
     pkt->allocate();
-    DPRINTF(Cache, "Create CleanEvict %s\n", pkt->print());
+    DPRINTF_ADDR(Cache, pkt->getAddr(),
+        "Create CleanEvict %s\n", pkt->print());
 
     return pkt;
 }
@@ -1004,7 +1014,8 @@ Cache::doTimingSupplyResponse(PacketPtr req_pkt, const uint8_t *blk_data,
     assert(req_pkt->isRequest());
     assert(req_pkt->needsResponse());
 
-    DPRINTF(Cache, "%s: for %s\n", __func__, req_pkt->print());
+    DPRINTF_ADDR(Cache, req_pkt->getAddr(),
+        "%s: for %s\n", __func__, req_pkt->print());
     // timing-mode snoop responses require a new packet, unless we
     // already made a copy...
     PacketPtr pkt = req_pkt;
@@ -1036,8 +1047,9 @@ Cache::doTimingSupplyResponse(PacketPtr req_pkt, const uint8_t *blk_data,
     Tick forward_time = clockEdge(forwardLatency) + pkt->headerDelay;
     // Here we reset the timing of the packet.
     pkt->headerDelay = pkt->payloadDelay = 0;
-    DPRINTF(CacheVerbose, "%s: created response: %s tick: %lu\n", __func__,
-            pkt->print(), forward_time);
+    DPRINTF_ADDR(CacheVerbose, pkt->getAddr(),
+        "%s: created response: %s tick: %lu\n", __func__,
+        pkt->print(), forward_time);
     memSidePort.schedTimingSnoopResp(pkt, forward_time);
 }
 
@@ -1045,7 +1057,8 @@ uint32_t
 Cache::handleSnoop(PacketPtr pkt, CacheBlk *blk, bool is_timing,
                    bool is_deferred, bool pending_inval)
 {
-    DPRINTF(CacheVerbose, "%s: for %s\n", __func__, pkt->print());
+    DPRINTF_ADDR(CacheVerbose, pkt->getAddr(),
+        "%s: for %s\n", __func__, pkt->print());
     // deferred snoops can only happen in timing mode
     assert(!(is_deferred && !is_timing));
     // pending_inval only makes sense on deferred snoops
@@ -1118,8 +1131,9 @@ Cache::handleSnoop(PacketPtr pkt, CacheBlk *blk, bool is_timing,
     bool blk_valid = blk && blk->isValid();
     if (pkt->isClean()) {
         if (blk_valid && blk->isSet(CacheBlk::DirtyBit)) {
-            DPRINTF(CacheVerbose, "%s: packet (snoop) %s found block: %s\n",
-                    __func__, pkt->print(), blk->print());
+            DPRINTF_ADDR(CacheVerbose, pkt->getAddr(),
+                "%s: packet (snoop) %s found block: %s\n",
+                __func__, pkt->print(), blk->print());
             PacketPtr wb_pkt =
                 writecleanBlk(blk, pkt->req->getDest(), pkt->id);
             PacketList writebacks;
@@ -1137,8 +1151,9 @@ Cache::handleSnoop(PacketPtr pkt, CacheBlk *blk, bool is_timing,
             pkt->setSatisfied();
         }
     } else if (!blk_valid) {
-        DPRINTF(CacheVerbose, "%s: snoop miss for %s\n", __func__,
-                pkt->print());
+        DPRINTF_ADDR(CacheVerbose, pkt->getAddr(),
+            "%s: snoop miss for %s\n", __func__,
+            pkt->print());
         if (is_deferred) {
             // we no longer have the block, and will not respond, but a
             // packet was allocated in MSHR::handleSnoop and we have
@@ -1153,8 +1168,9 @@ Cache::handleSnoop(PacketPtr pkt, CacheBlk *blk, bool is_timing,
         }
         return snoop_delay;
     } else {
-        DPRINTF(Cache, "%s: snoop hit for %s, old state is %s\n", __func__,
-                pkt->print(), blk->print());
+        DPRINTF_ADDR(Cache, pkt->getAddr(),
+            "%s: snoop hit for %s, old state is %s\n", __func__,
+            pkt->print(), blk->print());
 
         // We may end up modifying both the block state and the packet (if
         // we respond in atomic mode), so just figure out what to do now
@@ -1175,8 +1191,9 @@ Cache::handleSnoop(PacketPtr pkt, CacheBlk *blk, bool is_timing,
     // above and in it's own cache, a new MemCmd::ReadReq is created that
     // downstream caches observe.
     if (pkt->mustCheckAbove()) {
-        DPRINTF(Cache, "Found addr %#llx in upper level cache for snoop %s "
-                "from lower cache\n", pkt->getAddr(), pkt->print());
+        DPRINTF_ADDR(Cache, pkt->getAddr(),
+            "Found addr %#llx in upper level cache for snoop %s "
+            "from lower cache\n", pkt->getAddr(), pkt->print());
         pkt->setBlockCached();
         return snoop_delay;
     }
@@ -1260,7 +1277,8 @@ Cache::handleSnoop(PacketPtr pkt, CacheBlk *blk, bool is_timing,
 void
 Cache::recvTimingSnoopReq(PacketPtr pkt)
 {
-    DPRINTF(CacheVerbose, "%s: for %s\n", __func__, pkt->print());
+    DPRINTF_ADDR(CacheVerbose, pkt->getAddr(),
+        "%s: for %s\n", __func__, pkt->print());
 
     // no need to snoop requests that are not in range
     if (!inRange(pkt->getAddr())) {
@@ -1284,8 +1302,9 @@ Cache::recvTimingSnoopReq(PacketPtr pkt)
     // Inform request(Prefetch, CleanEvict or Writeback) from below of
     // MSHR hit, set setBlockCached.
     if (mshr && pkt->mustCheckAbove()) {
-        DPRINTF(Cache, "Setting block cached for %s from lower cache on "
-                "mshr hit\n", pkt->print());
+        DPRINTF_ADDR(Cache, pkt->getAddr(),
+            "Setting block cached for %s from lower cache on "
+            "mshr hit\n", pkt->print());
         pkt->setBlockCached();
         return;
     }
@@ -1322,8 +1341,9 @@ Cache::recvTimingSnoopReq(PacketPtr pkt)
             // propagate the BLOCK_CACHED flag in Writeback packets and prevent
             // any CleanEvicts from travelling down the memory hierarchy.
             pkt->setBlockCached();
-            DPRINTF(Cache, "%s: Squashing %s from lower cache on writequeue "
-                    "hit\n", __func__, pkt->print());
+            DPRINTF_ADDR(Cache, pkt->getAddr(),
+                "%s: Squashing %s from lower cache on writequeue "
+                "hit\n", __func__, pkt->print());
             return;
         }
 
@@ -1425,7 +1445,8 @@ Cache::sendMSHRQueuePacket(MSHR* mshr)
     PacketPtr tgt_pkt = mshr->getTarget()->pkt;
 
     if (tgt_pkt->cmd == MemCmd::HardPFReq && forwardSnoops) {
-        DPRINTF(Cache, "%s: MSHR %s\n", __func__, tgt_pkt->print());
+        DPRINTF_ADDR(Cache, tgt_pkt->getAddr(),
+            "%s: MSHR %s\n", __func__, tgt_pkt->print());
 
         // we should never have hardware prefetches to allocated
         // blocks
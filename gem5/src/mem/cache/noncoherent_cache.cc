@@ -161,8 +161,9 @@ NoncoherentCache::createMissPacket(PacketPtr cpu_pkt, CacheBlk *blk,
     assert(pkt->getAddr() == pkt->getBlockAddr(blkSize));
 
     pkt->allocate();
-    DPRINTF(Cache, "%s created %s from %s\n", __func__, pkt->print(),
-            cpu_pkt->print());
+    DPRINTF_ADDR(Cache, pkt->getAddr(),
+        "%s created %s from %s\n", __func__, pkt->print(),
+        cpu_pkt->print());
     return pkt;
 }
 
@@ -173,7 +174,8 @@ NoncoherentCache::handleAtomicReqMiss(PacketPtr pkt, CacheBlk *&blk,
 {
     PacketPtr bus_pkt = createMissPacket(pkt, blk, true,
                                          pkt->isWholeLineWrite(blkSize));
-    DPRINTF(Cache, "Sending an atomic %s\n", bus_pkt->print());
+    DPRINTF_ADDR(Cache, bus_pkt->getAddr(),
+        "Sending an atomic %s\n", bus_pkt->print());
 
     Cycles latency = ticksToCycles(memSidePort.sendAtomic(bus_pkt));
 
@@ -187,7 +189,8 @@ NoncoherentCache::handleAtomicReqMiss(PacketPtr pkt, CacheBlk *&blk,
     assert(!bus_pkt->hasSharers());
 
     // We are now dealing with the response handling
-    DPRINTF(Cache, "Receive response: %s\n", bus_pkt->print());
+    DPRINTF_ADDR(Cache, bus_pkt->getAddr(),
+        "Receive response: %s\n", bus_pkt->print());
 
     if (!bus_pkt->isError()) {
         // Any reponse that does not have an error should be filling,
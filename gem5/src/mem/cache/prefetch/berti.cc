@@ -57,7 +57,7 @@ BertiPrefetcher::updateHistoryTable(const PrefetchInfo &pfi)
         historyTable.findEntry({pfi.getPC(), pfi.isSecure()});
     HistoryInfo new_info = {blockIndex(pfi.getAddr()), curCycle()};
     if (entry) {
-        DPRINTF(BertiPrefetcher,
+        DPRINTF_PC(BertiPrefetcher, pfi.getPC(),
                 "History table hit, ip: [%lx] lineAddr: [%lx]\n", pfi.getPC(),
                 new_info.lineAddr);
         if (entry->history.size() == 16) {
@@ -65,8 +65,8 @@ BertiPrefetcher::updateHistoryTable(const PrefetchInfo &pfi)
         }
         entry->history.push_back(new_info);
     } else {
-        DPRINTF(BertiPrefetcher, "History table miss, ip: [%lx]\n",
-                pfi.getPC());
+        DPRINTF_PC(BertiPrefetcher, pfi.getPC(),
+                "History table miss, ip: [%lx]\n", pfi.getPC());
         entry = historyTable.findVictim({pfi.getPC(), pfi.isSecure()});
         historyTable.invalidate(entry);
         entry->history.clear();
@@ -131,7 +131,7 @@ BertiPrefetcher::updateTableOfDeltas(
 
 void BertiPrefetcher::calculatePrefetch(const PrefetchInfo &pfi, std::vector<AddrPriority> &addressed, const CacheAccessor &cache) 
 {
-    DPRINTF(BertiPrefetcher,
+    DPRINTF_PC(BertiPrefetcher, pfi.getPC(),
             "Train prefetcher, ip: [%lx] "
             "lineAddr: [%lx] miss: %d last lat: [%d]\n",
             pfi.getPC(), blockIndex(pfi.getAddr()),
@@ -162,10 +162,10 @@ void BertiPrefetcher::calculatePrefetch(const PrefetchInfo &pfi, std::vector<Add
             cache.hasBeenPrefetched(pfi.getAddr(), pfi.isSecure());
             std::list<prefetch_fill_latency>::iterator it;
             for (it = prefetch_latency_container.begin(); it != prefetch_latency_container.end() && !found; it++) {
-                DPRINTF(BertiPrefetcher, "Checking latency for addr [%lx] pfi addr [%lx] blockAddress [%lx]\n", it->addr, pfi.getAddr() ,blockAddress(pfi.getAddr()));
+                DPRINTF_PC(BertiPrefetcher, pfi.getPC(), "Checking latency for addr [%lx] pfi addr [%lx] blockAddress [%lx]\n", it->addr, pfi.getAddr() ,blockAddress(pfi.getAddr()));
                 found = (it->addr == blockAddress(pfi.getAddr()));
                 if(found)
-                DPRINTF(BertiPrefetcher, "Found latency %d for addr [%lx]\n", it->latency, it->addr);
+                DPRINTF_PC(BertiPrefetcher, pfi.getPC(), "Found latency %d for addr [%lx]\n", it->latency, it->addr);
             }
             assert(found);
             Cycles PrefetchFillLatency = it->latency;
@@ -184,12 +184,14 @@ void BertiPrefetcher::calculatePrefetch(const PrefetchInfo &pfi, std::vector<Add
     TableOfDeltasEntry *entry =
         tableOfDeltas.findEntry({pfi.getPC(), pfi.isSecure()});
     if (entry) {
-        DPRINTF(BertiPrefetcher, "Delta table hit, ip: [%lx]\n", pfi.getPC());
+        DPRINTF_PC(BertiPrefetcher, pfi.getPC(),
+                "Delta table hit, ip: [%lx]\n", pfi.getPC());
         tableOfDeltas.accessEntry(entry);
         if (aggressive_pf) {
             for (auto &delta_info : entry->deltas) {
                 if (delta_info.status == L2_PREF) {
-                    DPRINTF(BertiPrefetcher, "Using delta [%d] to prefetch\n",
+                    DPRINTF_PC(BertiPrefetcher, pfi.getPC(),
+                            "Using delta [%d] to prefetch\n",
                             delta_info.delta);
                     int64_t delta = delta_info.delta;
                     statsBerti.pf_delta.sample(delta);
@@ -200,7 +202,8 @@ void BertiPrefetcher::calculatePrefetch(const PrefetchInfo &pfi, std::vector<Add
             }
         } else {
             if (entry->best_delta != 0) {
-                DPRINTF(BertiPrefetcher, "Using delta [%d] to prefetch\n",
+                DPRINTF_PC(BertiPrefetcher, pfi.getPC(),
+                        "Using delta [%d] to prefetch\n",
                         entry->best_delta);
                 statsBerti.pf_delta.sample(entry->best_delta);
                 Addr pf_addr = (blockIndex(pfi.getAddr()) +
@@ -247,7 +250,7 @@ void BertiPrefetcher::notifyFill(const CacheAccessProbeArg &arg)
         pkt->req->isPrefetch()?"yes":"no", hasVaddr?"yes":"no", hasPC?"yes":"no");
         return;
     }
-    DPRINTF(BertiPrefetcher,
+    DPRINTF_PC(BertiPrefetcher, pkt->req->getPC(),
             "Cache Fill: %s isPF: %d\n",
             pkt->print(), pkt->req->isPrefetch());
     if (pkt->req->isPrefetch()) {
@@ -257,7 +260,7 @@ void BertiPrefetcher::notifyFill(const CacheAccessProbeArg &arg)
     }
     cleanPrefetchLatency(arg.cache);
     Addr addr = pkt->req->getPaddr();
-    DPRINTF(BertiPrefetcher, "Debug Fill for addr [%lx] paddr [%lx]\n", addr, pkt->req->getPaddr());
+    DPRINTF_PC(BertiPrefetcher, pkt->req->getPC(), "Debug Fill for addr [%lx] paddr [%lx]\n", addr, pkt->req->getPaddr());
     if( addr == 0x15d5bc80){
         addr = pkt->req->getVaddr();
         assert(true);
@@ -271,7 +274,7 @@ void BertiPrefetcher::notifyFill(const CacheAccessProbeArg &arg)
         new_latency.is_secure = pkt->req->isSecure();
         new_latency.latency = lastFillLatency;
         prefetch_latency_container.push_back(new_latency);
-        DPRINTF(BertiPrefetcher, "Adding latency %d for addr [%lx] orig vaddr [%lx]\n", new_latency.latency, new_latency.addr, pkt->req->getVaddr());
+        DPRINTF_PC(BertiPrefetcher, pkt->req->getPC(), "Adding latency %d for addr [%lx] orig vaddr [%lx]\n", new_latency.latency, new_latency.addr, pkt->req->getVaddr());
     }
 
     statsBerti.fill_pc.sample(pkt->req->getPC());
@@ -287,8 +290,8 @@ void BertiPrefetcher::notifyFill(const CacheAccessProbeArg &arg)
     }
     statsBerti.fill_latency.sample(wrappedLatency);
 
-    DPRINTF(BertiPrefetcher, "Updating table of deltas, latency [%d]\n",
-            latency);
+    DPRINTF_PC(BertiPrefetcher, pkt->req->getPC(),
+            "Updating table of deltas, latency [%d]\n", latency);
 
     
 
@@ -109,7 +109,7 @@ FetchDirectedPrefetcher::notifyPfAddr(Addr addr, bool virtual_addr)
 RequestPtr
 FetchDirectedPrefetcher::createPrefetchRequest(Addr vaddr)
 {
-    RequestPtr req = std::make_shared<Request>(
+    RequestPtr req = Request::create(
             vaddr, blkSize, 0, requestorId, vaddr, 0);
     req->setFlags(Request::PREFETCH);
     return req;
@@ -125,7 +125,7 @@ FetchDirectedPrefetcher::createPrefetchPacket(Addr addr, bool virtual_addr)
 
     if (virtual_addr) {
         // The address is virtual -> we need translate first
-        req = std::make_shared<Request>(
+        req = Request::create(
                 addr, blkSize, flags, requestorId, addr, 0);
 
 
@@ -141,7 +141,7 @@ FetchDirectedPrefetcher::createPrefetchPacket(Addr addr, bool virtual_addr)
 
     } else {
         // The adddress is physical -> no translation needed.
-        req = std::make_shared<Request>(
+        req = Request::create(
                 addr, blkSize, flags, requestorId);
     }
 
@@ -257,7 +257,7 @@ void
 FetchDirectedPrefetcher::PrefetchRequest::createRequest()
 {
     Flags flags = Request::INST_FETCH|Request::PREFETCH;
-    req = std::make_shared<Request>(
+    req = Request::create(
             addr, owner.blkSize, flags, owner.requestorId, addr, 0);
     req->setFlags(Request::PREFETCH);
 }
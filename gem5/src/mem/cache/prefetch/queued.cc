@@ -60,8 +60,8 @@ Queued::DeferredPacket::createPkt(Addr paddr, unsigned blk_size,
                                             bool tag_prefetch,
                                             Tick t) {
     /* Create a prefetch memory request */
-    RequestPtr req = std::make_shared<Request>(paddr, blk_size,
-                                                0, requestor_id);
+    RequestPtr req = Request::create(paddr, blk_size,
+                                     0, requestor_id);
 
     if (pfInfo.isSecure()) {
         req->setFlags(Request::SECURE);
@@ -182,10 +182,11 @@ Queued::notify(const CacheAccessProbeArg &acc, const PrefetchInfo &pfi)
         while (itr != pfq.end()) {
             if (blockAddress(itr->pfInfo.getAddr()) == blk_addr &&
                 itr->pfInfo.isSecure() == is_secure) {
-                DPRINTF(HWPrefetch, "Removing pf candidate addr: %#x "
-                        "(cl: %#x), demand request going to the same addr\n",
-                        itr->pfInfo.getAddr(),
-                        blockAddress(itr->pfInfo.getAddr()));
+                DPRINTF_ADDR(HWPrefetch, itr->pfInfo.getAddr(),
+                    "Removing pf candidate addr: %#x (cl: %#x), demand "
+                    "request going to the same addr\n",
+                    itr->pfInfo.getAddr(),
+                    blockAddress(itr->pfInfo.getAddr()));
                 delete itr->pkt;
                 itr = pfq.erase(itr);
                 statsQueued.pfRemovedDemand++;
@@ -221,8 +222,9 @@ Queued::notify(const CacheAccessProbeArg &acc, const PrefetchInfo &pfi)
         if (can_cross_page || samePage(addr_prio.first, pfi.getAddr())) {
             PrefetchInfo new_pfi(pfi,addr_prio.first);
             statsQueued.pfIdentified++;
-            DPRINTF(HWPrefetch, "Found a pf candidate addr: %#x, "
-                    "inserting into prefetch queue.\n", new_pfi.getAddr());
+            DPRINTF_ADDR(HWPrefetch, new_pfi.getAddr(),
+                "Found a pf candidate addr: %#x, inserting into prefetch "
+                "queue.\n", new_pfi.getAddr());
             // Create and insert the request
             insert(pkt, new_pfi, addr_prio.second, cache);
             num_pfs += 1;
@@ -257,7 +259,8 @@ Queued::getPacket()
     prefetchStats.pfIssued++;
     issuedPrefetches += 1;
     assert(pkt != nullptr);
-    DPRINTF(HWPrefetch, "Generating prefetch for %#x.\n", pkt->getAddr());
+    DPRINTF_ADDR(HWPrefetch, pkt->getAddr(),
+        "Generating prefetch for %#x.\n", pkt->getAddr());
 
     processMissingTranslations(queueSize - pfq.size());
     return pkt;
@@ -377,7 +380,7 @@ RequestPtr
 Queued::createPrefetchRequest(Addr addr, PrefetchInfo const &pfi,
                                         PacketPtr pkt)
 {
-    RequestPtr translation_req = std::make_shared<Request>(
+    RequestPtr translation_req = Request::create(
             addr, blkSize, pkt->req->getFlags(), requestorId, pfi.getPC(),
             pkt->req->contextId());
     translation_req->setFlags(Request::PREFETCH);
@@ -469,16 +472,17 @@ Queued::insert(const PacketPtr &pkt, PrefetchInfo &new_pfi,
         Tick pf_time = curTick() + clockPeriod() * priority;
         dpp.createPkt(target_paddr, blkSize, requestorId, tagPrefetch,
                       pf_time);
-        DPRINTF(HWPrefetch, "Prefetch queued. "
-                "addr:%#x priority: %3d tick:%lld.\n",
-                new_pfi.getAddr(), priority, pf_time);
+        DPRINTF_ADDR(HWPrefetch, new_pfi.getAddr(),
+            "Prefetch queued. addr:%#x priority: %3d tick:%lld.\n",
+            new_pfi.getAddr(), priority, pf_time);
         addToQueue(pfq, dpp);
     } else {
         // Add the translation request and try to resolve it later
         dpp.setTranslationRequest(translation_req);
         dpp.tc = system->threads[translation_req->contextId()];
-        DPRINTF(HWPrefetch, "Prefetch queued with no translation. "
-                "addr:%#x priority: %3d\n", new_pfi.getAddr(), priority);
+        DPRINTF_ADDR(HWPrefetch, new_pfi.getAddr(),
+            "Prefetch queued with no translation. addr:%#x priority: %3d\n",
+            new_pfi.getAddr(), priority);
         addToQueue(pfqMissingTranslation, dpp);
     }
 }
@@ -50,7 +50,7 @@ void BertiRubyPrefetcher::calculatePrefetch(const PrefetchInfo &pfi, std::vector
     pc = ((pc >> 1) ^ (pc >> 4));
     pc = pc & PC_MASK;
     bool cache_hit = !pfi.isCacheMiss();
-    DPRINTF(BertiRubyPrefetcher, "Calculate Prefetch: PC %x LineAddr %x Hit %d\n", pc, lineAddr, cache_hit);
+    DPRINTF_PC(BertiRubyPrefetcher, pfi.getPC(), "Calculate Prefetch: PC %x LineAddr %x Hit %d\n", pc, lineAddr, cache_hit);
     if (!cache_hit)
     {
         latencyt->add(lineAddr, pc, 1);
@@ -79,7 +79,7 @@ void BertiRubyPrefetcher::calculatePrefetch(const PrefetchInfo &pfi, std::vector
 
     if (berti_result == 0)
     {
-        DPRINTF(BertiRubyPrefetcher, "Calculate Prefetch: No deltas found for PC %x\n", pc);
+        DPRINTF_PC(BertiRubyPrefetcher, pfi.getPC(), "Calculate Prefetch: No deltas found for PC %x\n", pc);
         return;
     }
     int launched = 0;
@@ -88,7 +88,7 @@ void BertiRubyPrefetcher::calculatePrefetch(const PrefetchInfo &pfi, std::vector
         Addr pAddr = (lineAddr + i.delta) << LOG2_BLOCK_SIZE;
         if (!latencyt->get(pAddr) && i.delta != 0) // Avoids redundant prefetches with stride 0
         {
-            DPRINTF(BertiRubyPrefetcher, "Calculate Prefetch: Enqueue PF Addr %x\n", pAddr);
+            DPRINTF_PC(BertiRubyPrefetcher, pfi.getPC(), "Calculate Prefetch: Enqueue PF Addr %x\n", pAddr);
             addresses.push_back(AddrPriority(pAddr, 0));
             launched++;
             if(launched == degree)
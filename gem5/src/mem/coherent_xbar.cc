@@ -45,26 +45,36 @@
 
 #include "mem/coherent_xbar.hh"
 
+#include <algorithm>
+
 #include "base/compiler.hh"
 #include "base/logging.hh"
 #include "base/trace.hh"
 #include "debug/AddrRanges.hh"
 #include "debug/CoherentXBar.hh"
+#include "debug/Drain.hh"
 #include "sim/system.hh"
 
 namespace gem5
 {
 
 CoherentXBar::CoherentXBar(const CoherentXBarParams &p)
-    : BaseXBar(p), system(p.system), snoopFilter(p.snoop_filter),
+    : BaseXBar(p), outstandingSnoops(0), system(p.system),
+      snoopFilter(p.snoop_filter),
       snoopResponseLatency(p.snoop_response_latency),
       maxOutstandingSnoopCheck(p.max_outstanding_snoops),
       maxRoutingTableSizeCheck(p.max_routing_table_size),
       pointOfCoherency(p.point_of_coherency),
       pointOfUnification(p.point_of_unification),
+      backInvWritebackEvent([this]{ sendBackInvWritebacks(InvalidPortID); },
+                            name()),
+      backInvSnoopRespEvent([this]{ processBackInvSnoopResps(); }, name()),
+      backInvRetryEvent([this]{ processBackInvRetry(); }, name()),
 
       ADD_STAT(snoops, statistics::units::Count::get(), "Total snoops"),
       ADD_STAT(snoopTraffic, statistics::units::Byte::get(), "Total snoop traffic"),
+      ADD_STAT(pinnedLines, statistics::units::Count::get(),
+               "Back-invalidated lines held until written back"),
       ADD_STAT(snoopFanout, statistics::units::Count::get(),
                "Request fanout histogram")
 {
@@ -106,6 +116,9 @@ CoherentXBar::CoherentXBar(const CoherentXBarParams &p)
                                            csprintf("respLayer%d", i)));
         snoopRespPorts.push_back(new SnoopRespPort(*bp, *this));
     }
+
+    backInvWaitingPorts.resize(memSidePorts.size(), false);
+    backInvBlockedLayers.resize(memSidePorts.size(), false);
 }
 
 CoherentXBar::~CoherentXBar()
@@ -140,7 +153,9 @@ CoherentXBar::init()
         warn("CoherentXBar %s has no snooping ports attached!\n", name());
 
     // inform the snoop filter about the CPU-side ports so it can create
-    // its own internal representation
+    // its own internal representation, it enumerates the snooping
+    // ports in the same order as snoopPorts, and we use this to index
+    // the masks it returns
     if (snoopFilter)
         snoopFilter->setCPUSidePorts(cpuSidePorts);
 }
@@ -170,6 +185,21 @@ CoherentXBar::recvTimingReq(PacketPtr pkt, PortID cpu_side_port_id)
         return false;
     }
 
+    // a back-invalidated line stays pinned until its data has been
+    // written back below, so hold off any request for it, and keep
+    // the layer waiting until the line is unpinned
+    if (!is_express_snoop) {
+        const bool pinned = backInvalidations.count(backInvKey(pkt));
+        backInvBlockedLayers[mem_side_port_id] = pinned;
+        if (pinned) {
+            DPRINTF(CoherentXBar, "%s: src %s packet %s PINNED\n",
+                    __func__, src_port->name(), pkt->print());
+            reqLayers[mem_side_port_id]->failedTiming(src_port,
+                                                      clockEdge(Cycles(1)));
+            return false;
+        }
+    }
+
     DPRINTF(CoherentXBar, "%s: src %s packet %s\n", __func__,
             src_port->name(), pkt->print());
 
@@ -198,23 +228,30 @@ CoherentXBar::recvTimingReq(PacketPtr pkt, PortID cpu_side_port_id)
 
     const bool snoop_caches = !system->bypassCaches() &&
         pkt->cmd != MemCmd::WriteClean;
-    if (snoop_caches) {
-        assert(pkt->snoopDelay == 0);
+    if (snoop_caches && pkt->isClean() && !is_destination) {
+        // before snooping we need to make sure that the memory
+        // below is not busy and the cache clean request can be
+        // forwarded to it
+        if (!memSidePorts[mem_side_port_id]->tryTiming(pkt)) {
+            DPRINTF(CoherentXBar, "%s: src %s packet %s RETRY\n", __func__,
+                    src_port->name(), pkt->print());
 
-        if (pkt->isClean() && !is_destination) {
-            // before snooping we need to make sure that the memory
-            // below is not busy and the cache clean request can be
-            // forwarded to it
-            if (!memSidePorts[mem_side_port_id]->tryTiming(pkt)) {
-                DPRINTF(CoherentXBar, "%s: src %s packet %s RETRY\n", __func__,
-                        src_port->name(), pkt->print());
-
-                // update the layer state and schedule an idle event
-                reqLayers[mem_side_port_id]->failedTiming(src_port,
-                                                        clockEdge(Cycles(1)));
-                return false;
-            }
+            // update the layer state and schedule an idle event
+            reqLayers[mem_side_port_id]->failedTiming(src_port,
+                                                    clockEdge(Cycles(1)));
+            return false;
         }
+    }
+
+    // remember where to route a response to, this has to happen
+    // before snooping, as a cache committing to respond makes its
+    // response by copying the packet and its sender state, express
+    // snoops currently bypass the crossbar state entirely
+    if (!is_express_snoop)
+        pushRoute(pkt, cpu_side_port_id);
+
+    if (snoop_caches) {
+        assert(pkt->snoopDelay == 0);
 
 
         // the packet is a memory-mapped request and should be
@@ -228,7 +265,7 @@ CoherentXBar::recvTimingReq(PacketPtr pkt, PortID cpu_side_port_id)
             pkt->headerDelay += sf_res.second * clockPeriod();
             DPRINTF(CoherentXBar, "%s: src %s packet %s SF size: %i lat: %i\n",
                     __func__, src_port->name(), pkt->print(),
-                    sf_res.first.size(), sf_res.second);
+                    sf_res.first.count(), sf_res.second);
 
             if (pkt->isEviction()) {
                 // for block-evicting packets, i.e. writebacks and
@@ -236,7 +273,7 @@ CoherentXBar::recvTimingReq(PacketPtr pkt, PortID cpu_side_port_id)
                 // all we do is determine if the block is cached or
                 // not, instead just set it here based on the snoop
                 // filter result
-                if (!sf_res.first.empty())
+                if (sf_res.first.any())
                     pkt->setBlockCached();
             } else {
                 forwardTiming(pkt, cpu_side_port_id, sf_res.first);
@@ -259,6 +296,11 @@ CoherentXBar::recvTimingReq(PacketPtr pkt, PortID cpu_side_port_id)
     const bool expect_snoop_resp = !cache_responding && pkt->cacheResponding();
     bool expect_response = pkt->needsResponse() && !pkt->cacheResponding();
 
+    // the snoop response carries the route from here on, and the
+    // request itself will not see a response
+    if (expect_snoop_resp)
+        handOverRoute(pkt);
+
     const bool sink_packet = sinkPacket(pkt);
 
     // in certain cases the crossbar is responsible for responding
@@ -305,6 +347,9 @@ CoherentXBar::recvTimingReq(PacketPtr pkt, PortID cpu_side_port_id)
     if (snoopFilter && snoop_caches) {
         // Let the snoop filter know about the success of the send operation
         snoopFilter->finishRequest(!success, addr, pkt->isSecure());
+
+        // and invalidate any line it had to evict to track this one
+        backInvalidate(true);
     }
 
     // check if we were successful in sending the packet onwards
@@ -327,26 +372,18 @@ CoherentXBar::recvTimingReq(PacketPtr pkt, PortID cpu_side_port_id)
             // if this particular request will generate a snoop
             // response
             if (expect_snoop_resp) {
-                // we should never have an exsiting request outstanding
-                assert(outstandingSnoop.find(pkt->req) ==
-                       outstandingSnoop.end());
-                outstandingSnoop.insert(pkt->req);
+                ++outstandingSnoops;
 
                 // basic sanity check on the outstanding snoops
-                panic_if(outstandingSnoop.size() > maxOutstandingSnoopCheck,
+                panic_if(outstandingSnoops > maxOutstandingSnoopCheck,
                          "%s: Outstanding snoop requests exceeded %d\n",
                          name(), maxOutstandingSnoopCheck);
             }
 
-            // remember where to route the normal response to
-            if (expect_response || expect_snoop_resp) {
-                assert(routeTo.find(pkt->req) == routeTo.end());
-                routeTo[pkt->req] = cpu_side_port_id;
-
-                panic_if(routeTo.size() > maxRoutingTableSizeCheck,
-                         "%s: Routing table exceeds %d packets\n",
-                         name(), maxRoutingTableSizeCheck);
-            }
+            // basic sanity check on the routes
+            panic_if(numRoutes > maxRoutingTableSizeCheck,
+                     "%s: Routing table exceeds %d packets\n",
+                     name(), maxRoutingTableSizeCheck);
 
             // update the layer state and schedule an idle event
             reqLayers[mem_side_port_id]->succeededTiming(packetFinishTime);
@@ -371,6 +408,9 @@ CoherentXBar::recvTimingReq(PacketPtr pkt, PortID cpu_side_port_id)
     PacketPtr rsp_pkt = pkt;
     PortID rsp_port_id = cpu_side_port_id;
 
+    // is the packet keeping its route for a response still to come?
+    bool keep_route = success && expect_response;
+
     // If this is the destination of the cache clean operation the
     // crossbar is responsible for responding. This crossbar will
     // respond when the cache clean is complete. A cache clean
@@ -394,30 +434,25 @@ CoherentXBar::recvTimingReq(PacketPtr pkt, PortID cpu_side_port_id)
                 rsp_pkt = cmo_lookup->second;
                 assert(rsp_pkt);
 
-                // determine the destination
-                const auto route_lookup = routeTo.find(rsp_pkt->req);
-                assert(route_lookup != routeTo.end());
-                rsp_port_id = route_lookup->second;
-                assert(rsp_port_id != InvalidPortID);
+                // determine the destination and remove the route
+                rsp_port_id = popRoute(rsp_pkt);
                 assert(rsp_port_id < respLayers.size());
-                // remove the request from the routing table
-                routeTo.erase(route_lookup);
             }
             outstandingCMO.erase(cmo_lookup);
         } else {
             respond_directly = false;
             outstandingCMO.emplace(pkt->id, deferred_rsp);
-            if (!pkt->isWrite()) {
-                assert(routeTo.find(pkt->req) == routeTo.end());
-                routeTo[pkt->req] = cpu_side_port_id;
 
-                panic_if(routeTo.size() > maxRoutingTableSizeCheck,
-                         "%s: Routing table exceeds %d packets\n",
-                         name(), maxRoutingTableSizeCheck);
-            }
+            // hold on to the route until we respond
+            if (!pkt->isWrite())
+                keep_route = true;
         }
     }
 
+    // drop the route if nothing is coming back on this packet
+    if (!is_express_snoop && !expect_snoop_resp && !keep_route)
+        popRoute(pkt);
+
 
     if (respond_directly) {
         assert(rsp_pkt->needsResponse());
@@ -450,10 +485,7 @@ CoherentXBar::recvTimingResp(PacketPtr pkt, PortID mem_side_port_id)
     RequestPort *src_port = memSidePorts[mem_side_port_id];
 
     // determine the destination
-    const auto route_lookup = routeTo.find(pkt->req);
-    assert(route_lookup != routeTo.end());
-    const PortID cpu_side_port_id = route_lookup->second;
-    assert(cpu_side_port_id != InvalidPortID);
+    const PortID cpu_side_port_id = getRoute(pkt)->port;
     assert(cpu_side_port_id < respLayers.size());
 
     // test if the crossbar should be considered occupied for the
@@ -467,6 +499,9 @@ CoherentXBar::recvTimingResp(PacketPtr pkt, PortID mem_side_port_id)
     DPRINTF(CoherentXBar, "%s: src %s packet %s\n", __func__,
             src_port->name(), pkt->print());
 
+    // remove the route, the packet is on its way
+    popRoute(pkt);
+
     // store size and command as they might be modified when
     // forwarding the packet
     unsigned int pkt_size = pkt->hasData() ? pkt->getSize() : 0;
@@ -493,9 +528,6 @@ CoherentXBar::recvTimingResp(PacketPtr pkt, PortID mem_side_port_id)
     cpuSidePorts[cpu_side_port_id]->schedTimingResp(pkt, curTick()
                                         + latency);
 
-    // remove the request from the routing table
-    routeTo.erase(route_lookup);
-
     respLayers[cpu_side_port_id]->succeededTiming(packetFinishTime);
 
     // stats updates
@@ -531,6 +563,11 @@ CoherentXBar::recvTimingSnoopReq(PacketPtr pkt, PortID mem_side_port_id)
 
     assert(pkt->snoopDelay == 0);
 
+    // remember how to route a response, before any of the snoopers
+    // copies the packet to respond
+    [[maybe_unused]] RouteState *route =
+        pushRoute(pkt, mem_side_port_id, true);
+
     if (snoopFilter) {
         // let the Snoop Filter work its magic and guide probing
         auto sf_res = snoopFilter->lookupSnoop(pkt);
@@ -540,7 +577,7 @@ CoherentXBar::recvTimingSnoopReq(PacketPtr pkt, PortID mem_side_port_id)
         pkt->headerDelay += sf_res.second * clockPeriod();
         DPRINTF(CoherentXBar, "%s: src %s packet %s SF size: %i lat: %i\n",
                 __func__, memSidePorts[mem_side_port_id]->name(),
-                pkt->print(), sf_res.first.size(), sf_res.second);
+                pkt->print(), sf_res.first.count(), sf_res.second);
 
         // forward to all snoopers
         forwardTiming(pkt, InvalidPortID, sf_res.first);
@@ -552,12 +589,19 @@ CoherentXBar::recvTimingSnoopReq(PacketPtr pkt, PortID mem_side_port_id)
     pkt->headerDelay += pkt->snoopDelay;
     pkt->snoopDelay = 0;
 
-    // if we can expect a response, remember how to route it
+    // if we can expect a response, the response carries the route,
+    // otherwise it is no longer needed
+    assert(pkt->senderState == route);
     if (!cache_responding && pkt->cacheResponding()) {
-        assert(routeTo.find(pkt->req) == routeTo.end());
-        routeTo[pkt->req] = mem_side_port_id;
+        handOverRoute(pkt);
+    } else {
+        popRoute(pkt);
     }
 
+    // the caches above no longer have a pinned line, but it is here
+    if (!backInvalidations.empty())
+        snoopBackInvalidation(pkt, mem_side_port_id);
+
     // a snoop request came from a connected CPU-side-port device (one of
     // our memory-side ports), and if it is not coming from the CPU-side-port
     // device responsible for the address range something is
@@ -573,17 +617,25 @@ CoherentXBar::recvTimingSnoopResp(PacketPtr pkt, PortID cpu_side_port_id)
     ResponsePort* src_port = cpuSidePorts[cpu_side_port_id];
 
     // get the destination
-    const auto route_lookup = routeTo.find(pkt->req);
-    assert(route_lookup != routeTo.end());
-    const PortID dest_port_id = route_lookup->second;
-    assert(dest_port_id != InvalidPortID);
+    const RouteState *route = getRoute(pkt);
+    const PortID dest_port_id = route->port;
+
+    if (dest_port_id == InvalidPortID) {
+        // a holder giving up a dirty line we back-invalidated, the
+        // response ends here and the line is written back below
+        DPRINTF(CoherentXBar, "%s: src %s packet %s SINK\n", __func__,
+                src_port->name(), pkt->print());
+        popRoute(pkt);
+        snoops++;
+        snoopTraffic += pkt->getSize();
+        recvBackInvalidationResp(pkt);
+        return true;
+    }
 
     // determine if the response is from a snoop request we
-    // created as the result of a normal request (in which case it
-    // should be in the outstandingSnoop), or if we merely forwarded
-    // someone else's snoop request
-    const bool forwardAsSnoop = outstandingSnoop.find(pkt->req) ==
-        outstandingSnoop.end();
+    // created as the result of a normal request, or if we merely
+    // forwarded someone else's snoop request
+    const bool forwardAsSnoop = route->snoop;
 
     // test if the crossbar should be considered occupied for the
     // current port, note that the check is bypassed if the response
@@ -610,6 +662,9 @@ CoherentXBar::recvTimingSnoopResp(PacketPtr pkt, PortID cpu_side_port_id)
     DPRINTF(CoherentXBar, "%s: src %s packet %s\n", __func__,
             src_port->name(), pkt->print());
 
+    // remove the route before passing the packet on
+    popRoute(pkt);
+
     // store size and command as they might be modified when
     // forwarding the packet
     unsigned int pkt_size = pkt->hasData() ? pkt->getSize() : 0;
@@ -655,7 +710,8 @@ CoherentXBar::recvTimingSnoopResp(PacketPtr pkt, PortID cpu_side_port_id)
         // i.e. from a coherent requestor connected to the crossbar, and
         // since we created the snoop request as part of recvTiming,
         // this should now be a normal response again
-        outstandingSnoop.erase(pkt->req);
+        assert(outstandingSnoops > 0);
+        --outstandingSnoops;
 
         // this is a snoop response from a coherent requestor, hence it
         // should never go back to where the snoop response came from,
@@ -684,9 +740,6 @@ CoherentXBar::recvTimingSnoopResp(PacketPtr pkt, PortID cpu_side_port_id)
         respLayers[dest_port_id]->succeededTiming(packetFinishTime);
     }
 
-    // remove the request from the routing table
-    routeTo.erase(route_lookup);
-
     // stats updates
     transDist[pkt_cmd]++;
     snoops++;
@@ -698,7 +751,7 @@ CoherentXBar::recvTimingSnoopResp(PacketPtr pkt, PortID cpu_side_port_id)
 
 void
 CoherentXBar::forwardTiming(PacketPtr pkt, PortID exclude_cpu_side_port_id,
-                           const std::vector<QueuedResponsePort*>& dests)
+                           const SnoopFilter::SnoopMask& dests)
 {
     DPRINTF(CoherentXBar, "%s for %s\n", __func__, pkt->print());
 
@@ -707,7 +760,12 @@ CoherentXBar::forwardTiming(PacketPtr pkt, PortID exclude_cpu_side_port_id,
 
     unsigned fanout = 0;
 
-    for (const auto& p: dests) {
+    for (int i = 0; i < snoopPorts.size(); ++i) {
+        if (!dests[i])
+            continue;
+
+        QueuedResponsePort *p = snoopPorts[i];
+
         // we could have gotten this request from a snooping requestor
         // (corresponding to our own CPU-side port that is also in
         // snoopPorts) and should not send it back to where it came
@@ -724,12 +782,375 @@ CoherentXBar::forwardTiming(PacketPtr pkt, PortID exclude_cpu_side_port_id,
     snoopFanout.sample(fanout);
 }
 
+void
+CoherentXBar::backInvalidate(bool is_timing)
+{
+    SnoopFilter::BackInvalidation inv;
+    if (!snoopFilter->takeBackInvalidation(inv))
+        return;
+
+    Request::Flags flags = 0;
+    if (inv.isSecure)
+        flags.set(Request::SECURE);
+    RequestPtr req = Request::create(inv.addr, system->cacheLineSize(),
+                                     flags, snoopFilter->requestorId());
+
+    DPRINTF(CoherentXBar, "%s: addr %#x holders %x\n", __func__, inv.addr,
+            inv.holders);
+
+    // a read for ownership invalidates all the copies, and makes the
+    // holder of a dirty copy respond with the data
+    Packet pkt(req, MemCmd::ReadExReq);
+    pkt.allocate();
+    pkt.setExpressSnoop();
+
+    if (!is_timing) {
+        for (int i = 0; i < snoopPorts.size(); ++i) {
+            if (!inv.holders[i])
+                continue;
+
+            snoopPorts[i]->sendAtomicSnoop(&pkt);
+            if (pkt.isResponse()) {
+                // no cache above keeps the line, so write it back
+                // before the request that evicted it goes below
+                PacketPtr wb = createBackInvWriteback(&pkt);
+                memSidePorts[findPort(wb)]->sendAtomic(wb);
+                transDist[wb->cmdToIndex()]++;
+                delete wb;
+
+                // restore the request for the remaining holders
+                pkt.cmd = MemCmd::ReadExReq;
+            }
+        }
+        return;
+    }
+
+    // a timing response is made by copying the packet, and the route
+    // brings it back here
+    pushRoute(&pkt, InvalidPortID, true);
+
+    for (int i = 0; i < snoopPorts.size(); ++i) {
+        if (inv.holders[i])
+            snoopPorts[i]->sendTimingSnoopReq(&pkt);
+    }
+
+    if (!pkt.cacheResponding()) {
+        // the copies were all clean, and the memory below is up to
+        // date
+        popRoute(&pkt);
+        return;
+    }
+
+    handOverRoute(&pkt);
+
+    // the data is on its way, pin the line until it is written back
+    DPRINTF(CoherentXBar, "%s: addr %#x pinned\n", __func__, inv.addr);
+    pinnedLines++;
+    [[maybe_unused]] auto [it, inserted] =
+        backInvalidations.emplace(backInvKey(&pkt), BackInvalidation());
+    assert(inserted);
+    it->second.memSidePortId = findPort(&pkt);
+}
+
+PacketPtr
+CoherentXBar::createBackInvWriteback(const PacketPtr pkt) const
+{
+    assert(pkt->hasData());
+
+    PacketPtr wb = new Packet(pkt->req, MemCmd::WritebackDirty);
+    wb->allocate();
+    wb->setData(pkt->getConstPtr<uint8_t>());
+
+    // a holder with an Owned copy leaves other copies below
+    if (!pkt->responderHadWritable())
+        wb->setHasSharers();
+
+    return wb;
+}
+
+void
+CoherentXBar::recvBackInvalidationResp(PacketPtr pkt)
+{
+    const Addr key = backInvKey(pkt);
+    auto it = backInvalidations.find(key);
+    assert(it != backInvalidations.end());
+    BackInvalidation &binv = it->second;
+    assert(binv.writeback == nullptr);
+
+    PacketPtr wb = createBackInvWriteback(pkt);
+    delete pkt;
+
+    // answer the snoops from below that came in while the line was
+    // on its way, in the order they came in
+    for (auto &[snoop_pkt, port_id] : binv.deferredSnoops)
+        queueBackInvSnoopResp(snoop_pkt, port_id, wb->getConstPtr<uint8_t>());
+    binv.deferredSnoops.clear();
+
+    if (binv.invalidated) {
+        // a snoop from below took the line, and the memory below has
+        // no use for the write-back anymore
+        delete wb;
+        finishBackInvalidation(key);
+        return;
+    }
+
+    if (binv.hasSharers)
+        wb->setHasSharers();
+
+    binv.writeback = wb;
+    backInvWritebacks.push_back(key);
+
+    // send the write-back from the event rather than from within the
+    // snoop response
+    if (!backInvWritebackEvent.scheduled())
+        schedule(backInvWritebackEvent, clockEdge());
+}
+
+void
+CoherentXBar::snoopBackInvalidation(PacketPtr pkt, PortID mem_side_port_id)
+{
+    const Addr key = backInvKey(pkt);
+    auto it = backInvalidations.find(key);
+    if (it == backInvalidations.end())
+        return;
+    BackInvalidation &binv = it->second;
+
+    // once a snoop took the line, it is only pinned until the data
+    // arrives to answer that snoop
+    if (binv.invalidated)
+        return;
+
+    DPRINTF(CoherentXBar, "%s: packet %s hits pinned line\n", __func__,
+            pkt->print());
+
+    // act like the write buffer of a cache holding a dirty line
+    if (pkt->isEviction()) {
+        // the line is still cached here
+        pkt->setBlockCached();
+        return;
+    }
+
+    // cache maintenance is not ordered with the write-back, the line
+    // only leaves the pinned state once the write-back is accepted
+    if (pkt->isClean())
+        return;
+
+    // until the line is here we do not know if it was writable, and
+    // a snoop that needs it writable goes on below to any other copies
+    const bool have_writable = binv.writeback &&
+        !binv.writeback->hasSharers();
+    const bool invalidate = pkt->isInvalidate();
+
+    if (!pkt->req->isUncacheable() && pkt->isRead() && !invalidate) {
+        // the line stays here, and whoever gets the data a shared copy
+        pkt->setHasSharers();
+        binv.hasSharers = true;
+        if (binv.writeback)
+            binv.writeback->setHasSharers();
+    }
+
+    if (pkt->needsResponse() && !pkt->cacheResponding()) {
+        pkt->setCacheResponding();
+        if (have_writable)
+            pkt->setResponderHadWritable();
+
+        PacketPtr snoop_pkt = new Packet(pkt, false, true);
+        if (binv.writeback) {
+            queueBackInvSnoopResp(snoop_pkt, mem_side_port_id,
+                                  binv.writeback->getConstPtr<uint8_t>());
+        } else {
+            binv.deferredSnoops.emplace_back(snoop_pkt, mem_side_port_id);
+        }
+    }
+
+    if (invalidate) {
+        binv.invalidated = true;
+        if (binv.writeback) {
+            // the write-back has not been accepted yet, and is no
+            // longer needed
+            auto wb_it = std::find(backInvWritebacks.begin(),
+                                   backInvWritebacks.end(), key);
+            assert(wb_it != backInvWritebacks.end());
+            backInvWritebacks.erase(wb_it);
+            delete binv.writeback;
+            binv.writeback = nullptr;
+            finishBackInvalidation(key);
+        }
+    }
+}
+
+void
+CoherentXBar::queueBackInvSnoopResp(PacketPtr pkt, PortID mem_side_port_id,
+                                    const uint8_t *data)
+{
+    pkt->makeTimingResponse();
+    if (pkt->isRead())
+        pkt->setDataFromBlock(data, system->cacheLineSize());
+
+    pkt->headerDelay = 0;
+    pkt->payloadDelay = 0;
+
+    const Tick when = clockEdge(snoopResponseLatency);
+    assert(backInvSnoopResps.empty() ||
+           backInvSnoopResps.back().when <= when);
+    backInvSnoopResps.push_back({when, pkt, mem_side_port_id});
+
+    if (!backInvSnoopRespEvent.scheduled())
+        schedule(backInvSnoopRespEvent, when);
+}
+
+void
+CoherentXBar::processBackInvSnoopResps()
+{
+    while (!backInvSnoopResps.empty() &&
+           backInvSnoopResps.front().when <= curTick()) {
+        BackInvSnoopResp rsp = backInvSnoopResps.front();
+        backInvSnoopResps.pop_front();
+
+        DPRINTF(CoherentXBar, "%s: packet %s\n", __func__,
+                rsp.pkt->print());
+
+        snoops++;
+        snoopTraffic += rsp.pkt->hasData() ? rsp.pkt->getSize() : 0;
+
+        // like any snoop response forwarded below, this is not
+        // expected to be refused
+        [[maybe_unused]] bool success =
+            memSidePorts[rsp.memSidePortId]->sendTimingSnoopResp(rsp.pkt);
+        assert(success);
+    }
+
+    if (!backInvSnoopResps.empty())
+        schedule(backInvSnoopRespEvent, backInvSnoopResps.front().when);
+    else
+        checkBackInvDrained();
+}
+
+void
+CoherentXBar::sendBackInvWritebacks(PortID mem_side_port_id)
+{
+    auto it = backInvWritebacks.begin();
+    while (it != backInvWritebacks.end()) {
+        const Addr key = *it;
+        BackInvalidation &binv = backInvalidations.at(key);
+        const PortID port_id = binv.memSidePortId;
+
+        if ((mem_side_port_id != InvalidPortID &&
+             port_id != mem_side_port_id) || backInvWaitingPorts[port_id]) {
+            ++it;
+            continue;
+        }
+
+        PacketPtr wb = binv.writeback;
+        wb->headerDelay = 0;
+        wb->payloadDelay = 0;
+        calcPacketTiming(wb, forwardLatency * clockPeriod());
+
+        const unsigned int pkt_cmd = wb->cmdToIndex();
+        if (!memSidePorts[port_id]->sendTimingReq(wb)) {
+            DPRINTF(CoherentXBar, "%s: packet %s RETRY\n", __func__,
+                    wb->print());
+            backInvWaitingPorts[port_id] = true;
+            ++it;
+            continue;
+        }
+
+        DPRINTF(CoherentXBar, "%s: addr %#x written back\n", __func__,
+                key & ~Addr(1));
+        transDist[pkt_cmd]++;
+
+        // the write-back now belongs to the memory below
+        binv.writeback = nullptr;
+        it = backInvWritebacks.erase(it);
+        finishBackInvalidation(key);
+    }
+}
+
+void
+CoherentXBar::finishBackInvalidation(Addr key)
+{
+    [[maybe_unused]] auto erased = backInvalidations.erase(key);
+    assert(erased == 1);
+
+    // let the requests held off try again, from an event as we may be
+    // in the middle of a snoop
+    if (!backInvRetryEvent.scheduled())
+        schedule(backInvRetryEvent, clockEdge());
+}
+
+void
+CoherentXBar::processBackInvRetry()
+{
+    // a request for a line that is still pinned is simply held off
+    // again
+    for (PortID i = 0; i < reqLayers.size(); ++i) {
+        if (backInvBlockedLayers[i]) {
+            backInvBlockedLayers[i] = false;
+            if (reqLayers[i]->waitingForRetry())
+                reqLayers[i]->recvRetry();
+        }
+    }
+
+    checkBackInvDrained();
+}
+
+void
+CoherentXBar::checkBackInvDrained()
+{
+    if (drainState() == DrainState::Draining && drain() ==
+        DrainState::Drained) {
+        DPRINTF(Drain, "Crossbar done draining pinned lines\n");
+        signalDrainDone();
+    }
+}
+
+bool
+CoherentXBar::trySatisfyBackInvalidations(PacketPtr pkt)
+{
+    for (auto &[key, binv] : backInvalidations) {
+        if (binv.writeback && pkt->trySatisfyFunctional(binv.writeback))
+            return true;
+    }
+
+    for (auto &rsp : backInvSnoopResps) {
+        if (rsp.pkt->hasData() && pkt->trySatisfyFunctional(rsp.pkt))
+            return true;
+    }
+
+    return false;
+}
+
+DrainState
+CoherentXBar::drain()
+{
+    if (backInvalidations.empty() && backInvSnoopResps.empty() &&
+        !backInvRetryEvent.scheduled()) {
+        return DrainState::Drained;
+    }
+
+    DPRINTF(Drain, "Crossbar has pinned lines, not drained\n");
+    return DrainState::Draining;
+}
+
 void
 CoherentXBar::recvReqRetry(PortID mem_side_port_id)
 {
     // responses and snoop responses never block on forwarding them,
     // so the retry will always be coming from a port to which we
-    // tried to forward a request
+    // tried to forward a request, or a write-back of a pinned line,
+    // and the one retry goes for both
+    if (backInvWaitingPorts[mem_side_port_id]) {
+        const bool layer_waiting =
+            reqLayers[mem_side_port_id]->waitingForRetry() &&
+            !backInvBlockedLayers[mem_side_port_id];
+
+        backInvWaitingPorts[mem_side_port_id] = false;
+        sendBackInvWritebacks(mem_side_port_id);
+
+        if (!layer_waiting)
+            return;
+    }
+
     reqLayers[mem_side_port_id]->recvRetry();
 }
 
@@ -765,13 +1186,14 @@ CoherentXBar::recvAtomicBackdoor(PacketPtr pkt, PortID cpu_side_port_id,
             snoop_response_latency += sf_res.second * clockPeriod();
             DPRINTF(CoherentXBar, "%s: src %s packet %s SF size: %i lat: %i\n",
                     __func__, cpuSidePorts[cpu_side_port_id]->name(),
-                    pkt->print(), sf_res.first.size(), sf_res.second);
+                    pkt->print(), sf_res.first.count(), sf_res.second);
 
             // let the snoop filter know about the success of the send
             // operation, and do it even before sending it onwards to
             // avoid situations where atomic upward snoops sneak in
             // between and change the filter state
             snoopFilter->finishRequest(false, pkt->getAddr(), pkt->isSecure());
+            backInvalidate(false);
 
             if (pkt->isEviction()) {
                 // for block-evicting packets, i.e. writebacks and
@@ -779,7 +1201,7 @@ CoherentXBar::recvAtomicBackdoor(PacketPtr pkt, PortID cpu_side_port_id,
                 // all we do is determine if the block is cached or
                 // not, instead just set it here based on the snoop
                 // filter result
-                if (!sf_res.first.empty())
+                if (sf_res.first.any())
                     pkt->setBlockCached();
             } else {
                 snoop_result = forwardAtomic(pkt, cpu_side_port_id,
@@ -904,7 +1326,7 @@ CoherentXBar::recvAtomicSnoop(PacketPtr pkt, PortID mem_side_port_id)
         snoop_response_latency += sf_res.second * clockPeriod();
         DPRINTF(CoherentXBar, "%s: src %s packet %s SF size: %i lat: %i\n",
                 __func__, memSidePorts[mem_side_port_id]->name(),
-                pkt->print(), sf_res.first.size(), sf_res.second);
+                pkt->print(), sf_res.first.count(), sf_res.second);
         snoop_result = forwardAtomic(pkt, InvalidPortID, mem_side_port_id,
                                      sf_res.first);
     } else {
@@ -929,7 +1351,7 @@ CoherentXBar::recvAtomicSnoop(PacketPtr pkt, PortID mem_side_port_id)
 std::pair<MemCmd, Tick>
 CoherentXBar::forwardAtomic(PacketPtr pkt, PortID exclude_cpu_side_port_id,
                            PortID source_mem_side_port_id,
-                           const std::vector<QueuedResponsePort*>& dests)
+                           const SnoopFilter::SnoopMask& dests)
 {
     // the packet may be changed on snoops, record the original
     // command to enable us to restore it between snoops so that
@@ -943,7 +1365,12 @@ CoherentXBar::forwardAtomic(PacketPtr pkt, PortID exclude_cpu_side_port_id,
 
     unsigned fanout = 0;
 
-    for (const auto& p: dests) {
+    for (int i = 0; i < snoopPorts.size(); ++i) {
+        if (!dests[i])
+            continue;
+
+        QueuedResponsePort *p = snoopPorts[i];
+
         // we could have gotten this request from a snooping memory-side port
         // (corresponding to our own CPU-side port that is also in
         // snoopPorts) and should not send it back to where it came
@@ -1022,6 +1449,13 @@ CoherentXBar::recvFunctional(PacketPtr pkt, PortID cpu_side_port_id)
     // there is no need to continue if the snooping has found what we
     // were looking for and the packet is already a response
     if (!pkt->isResponse()) {
+        // a pinned line has the latest data until it is written back
+        if (trySatisfyBackInvalidations(pkt)) {
+            if (pkt->needsResponse())
+                pkt->makeResponse();
+            return;
+        }
+
         // since our CPU-side ports are queued ports we need to check
         // them as well
         for (const auto& p : cpuSidePorts) {
@@ -1058,6 +1492,12 @@ CoherentXBar::recvFunctionalSnoop(PacketPtr pkt, PortID mem_side_port_id)
         }
     }
 
+    if (trySatisfyBackInvalidations(pkt)) {
+        if (pkt->needsResponse())
+            pkt->makeResponse();
+        return;
+    }
+
     // forward to all snoopers
     forwardFunctional(pkt, InvalidPortID);
 }
@@ -46,8 +46,10 @@
 #ifndef __MEM_COHERENT_XBAR_HH__
 #define __MEM_COHERENT_XBAR_HH__
 
+#include <deque>
 #include <unordered_map>
-#include <unordered_set>
+#include <utility>
+#include <vector>
 
 #include "mem/snoop_filter.hh"
 #include "mem/xbar.hh"
@@ -261,11 +263,11 @@ class CoherentXBar : public BaseXBar
     std::vector<QueuedResponsePort*> snoopPorts;
 
     /**
-     * Store the outstanding requests that we are expecting snoop
-     * responses from so we can determine which snoop responses we
-     * generated and which ones were merely forwarded.
+     * Number of outstanding requests that we are expecting snoop
+     * responses from, for sanity checks. The route of the response
+     * tells if we generated the snoop or merely forwarded it.
      */
-    std::unordered_set<RequestPtr> outstandingSnoop;
+    unsigned int outstandingSnoops;
 
     /**
      * Store the outstanding cache maintenance that we are expecting
@@ -322,20 +324,21 @@ class CoherentXBar : public BaseXBar
     void
     forwardTiming(PacketPtr pkt, PortID exclude_cpu_side_port_id)
     {
-        forwardTiming(pkt, exclude_cpu_side_port_id, snoopPorts);
+        forwardTiming(pkt, exclude_cpu_side_port_id, allSnoopers());
     }
 
     /**
-     * Forward a timing packet to a selected list of snoopers, potentially
+     * Forward a timing packet to a selected set of snoopers, potentially
      * excluding one of the connected coherent requestors to avoid sending
      * a packet back to where it came from.
      *
      * @param pkt Packet to forward
      * @param exclude_cpu_side_port_id Id of CPU-side port to exclude
-     * @param dests Vector of destination ports for the forwarded pkt
+     * @param dests Mask of destination ports for the forwarded pkt,
+     * indexed like snoopPorts
      */
     void forwardTiming(PacketPtr pkt, PortID exclude_cpu_side_port_id,
-                       const std::vector<QueuedResponsePort*>& dests);
+                       const SnoopFilter::SnoopMask& dests);
 
     Tick recvAtomicBackdoor(PacketPtr pkt, PortID cpu_side_port_id,
                             MemBackdoorPtr *backdoor=nullptr);
@@ -355,11 +358,11 @@ class CoherentXBar : public BaseXBar
     forwardAtomic(PacketPtr pkt, PortID exclude_cpu_side_port_id)
     {
         return forwardAtomic(pkt, exclude_cpu_side_port_id, InvalidPortID,
-                             snoopPorts);
+                             allSnoopers());
     }
 
     /**
-     * Forward an atomic packet to a selected list of snoopers, potentially
+     * Forward an atomic packet to a selected set of snoopers, potentially
      * excluding one of the connected coherent requestors to avoid sending a
      * packet back to where it came from.
      *
@@ -367,16 +370,170 @@ class CoherentXBar : public BaseXBar
      * @param exclude_cpu_side_port_id Id of CPU-side port to exclude
      * @param source_mem_side_port_id Id of the memory-side port for
      * snoops from below
-     * @param dests Vector of destination ports for the forwarded pkt
+     * @param dests Mask of destination ports for the forwarded pkt,
+     * indexed like snoopPorts
      *
      * @return a pair containing the snoop response and snoop latency
      */
     std::pair<MemCmd, Tick> forwardAtomic(PacketPtr pkt,
                                           PortID exclude_cpu_side_port_id,
                                           PortID source_mem_side_port_id,
-                                          const std::vector<QueuedResponsePort*>&
+                                          const SnoopFilter::SnoopMask&
                                           dests);
 
+    /**
+     * A line evicted from a bounded snoop filter while a cache above
+     * held a dirty copy. The line stays pinned here, and requests for
+     * it are held off, until its data has been written back below.
+     */
+    struct BackInvalidation
+    {
+        /** Memory-side port the line is written back through. */
+        PortID memSidePortId;
+
+        /** The write-back, once the holder has given up the line. */
+        PacketPtr writeback = nullptr;
+
+        /**
+         * Snoops from below that arrived before the line, to respond
+         * to once it is here, with the port they came from.
+         */
+        std::vector<std::pair<PacketPtr, PortID>> deferredSnoops;
+
+        /** Has a snoop from below been given a shared copy? */
+        bool hasSharers = false;
+
+        /** Has a snoop from below taken the line from us? */
+        bool invalidated = false;
+    };
+
+    /** Pinned lines, by line address with the secure bit in bit 0. */
+    std::unordered_map<Addr, BackInvalidation> backInvalidations;
+
+    /** Pinned lines with their write-back ready to go, oldest first. */
+    std::deque<Addr> backInvWritebacks;
+
+    /** Memory-side ports that refused a write-back of a pinned line. */
+    std::vector<bool> backInvWaitingPorts;
+
+    /**
+     * Memory-side ports with a request layer held off by a pinned
+     * line rather than by the port below.
+     */
+    std::vector<bool> backInvBlockedLayers;
+
+    /** A response to a snoop from below made from a pinned line. */
+    struct BackInvSnoopResp
+    {
+        Tick when;
+        PacketPtr pkt;
+        PortID memSidePortId;
+    };
+
+    /** Snoop responses made from pinned lines, in time order. */
+    std::deque<BackInvSnoopResp> backInvSnoopResps;
+
+    /** Send the write-backs of pinned lines. */
+    EventFunctionWrapper backInvWritebackEvent;
+
+    /** Send the snoop responses made from pinned lines. */
+    void processBackInvSnoopResps();
+    EventFunctionWrapper backInvSnoopRespEvent;
+
+    /** Let the request layers held off by pinned lines try again. */
+    void processBackInvRetry();
+    EventFunctionWrapper backInvRetryEvent;
+
+    /** Signal a drain in progress once no line is pinned. */
+    void checkBackInvDrained();
+
+    /** Key of the line a packet is for in backInvalidations. */
+    Addr
+    backInvKey(const PacketPtr pkt) const
+    {
+        return pkt->getBlockAddr(system->cacheLineSize()) |
+            (pkt->isSecure() ? 1 : 0);
+    }
+
+    /**
+     * Snoop the holders of a line evicted from a bounded snoop filter
+     * by the last request, invalidating their copies. In timing mode
+     * the line is pinned if a holder responds with a dirty copy, and
+     * in atomic mode the copy is written back right away.
+     *
+     * @param is_timing Snoop in timing rather than atomic mode
+     */
+    void backInvalidate(bool is_timing);
+
+    /**
+     * Make the write-back of a back-invalidated line from the
+     * response of the holder that gave it up.
+     *
+     * @param pkt Response carrying the line
+     * @return The write-back, a WritebackDirty
+     */
+    PacketPtr createBackInvWriteback(const PacketPtr pkt) const;
+
+    /**
+     * Take the response of a holder giving up a pinned line, answer
+     * the snoops waiting for it, and write it back below.
+     *
+     * @param pkt Response carrying the line, deleted here
+     */
+    void recvBackInvalidationResp(PacketPtr pkt);
+
+    /**
+     * Let a pinned line act on a snoop from below, like the write
+     * buffer of a cache does, responding with the line if it is here
+     * or once it arrives.
+     *
+     * @param pkt Snoop request from below
+     * @param mem_side_port_id Port the snoop came from
+     */
+    void snoopBackInvalidation(PacketPtr pkt, PortID mem_side_port_id);
+
+    /**
+     * Queue the response to a snoop from below with the data of a
+     * pinned line.
+     *
+     * @param pkt Copy of the snoop request, turned into the response
+     * @param mem_side_port_id Port the snoop came from
+     * @param data Data of the line
+     */
+    void queueBackInvSnoopResp(PacketPtr pkt, PortID mem_side_port_id,
+                               const uint8_t *data);
+
+    /**
+     * Send the ready write-backs of pinned lines below, unpinning the
+     * lines whose write-back is accepted.
+     *
+     * @param mem_side_port_id Only send through this port, or through
+     * any port not waiting for a retry if InvalidPortID
+     */
+    void sendBackInvWritebacks(PortID mem_side_port_id);
+
+    /**
+     * Unpin a line and let the requests held off by it try again.
+     *
+     * @param key Key of the line
+     */
+    void finishBackInvalidation(Addr key);
+
+    /**
+     * Satisfy a functional access from the pinned lines and the
+     * snoop responses made from them.
+     *
+     * @return Whether the access is satisfied
+     */
+    bool trySatisfyBackInvalidations(PacketPtr pkt);
+
+    /** Mask selecting all the snooping ports. */
+    SnoopFilter::SnoopMask
+    allSnoopers() const
+    {
+        return SnoopFilter::SnoopMask().set();
+    }
+
     /** Function called by the port when the crossbar is receiving a Functional
         transaction.*/
     void recvFunctional(PacketPtr pkt, PortID cpu_side_port_id);
@@ -432,6 +589,7 @@ class CoherentXBar : public BaseXBar
 
     statistics::Scalar snoops;
     statistics::Scalar snoopTraffic;
+    statistics::Scalar pinnedLines;
     statistics::Distribution snoopFanout;
 
   public:
@@ -443,6 +601,8 @@ class CoherentXBar : public BaseXBar
     virtual ~CoherentXBar();
 
     virtual void regStats();
+
+    DrainState drain() override;
 };
 
 } // namespace gem5
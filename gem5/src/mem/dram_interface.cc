@@ -40,6 +40,9 @@
 
 #include "mem/dram_interface.hh"
 
+#include <algorithm>
+#include <map>
+
 #include "base/bitfield.hh"
 #include "base/cprintf.hh"
 #include "base/trace.hh"
@@ -58,6 +61,115 @@ namespace memory
 
 std::pair<MemPacketQueue::iterator, Tick>
 DRAMInterface::chooseNextFRFCFS(MemPacketQueue& queue, Tick min_col_at) const
+{
+    // The queue buckets its DRAM packets by bank and row, and the
+    // decisions below are those of the queue walk in
+    // chooseNextFRFCFSScan: the oldest seamless row hit if there is one,
+    // otherwise the oldest packet to one of the earliest banks to be
+    // prepped if that can be done 'behind the scenes' or there is no row
+    // hit at all, and otherwise the oldest row hit. All packets to the
+    // same bank and row share the same readiness, so only the oldest
+    // one of each needs to be considered.
+    const MemPacketQueue::Entry *seamless_hit = nullptr;
+    const MemPacketQueue::Entry *prepped_hit = nullptr;
+    Tick seamless_col_at = MaxTick;
+    Tick prepped_col_at = MaxTick;
+    bool got_row_miss = false;
+
+    for (int i = 0; i < ranksPerChannel; i++) {
+        // skip ranks which are refreshing
+        if (!ranks[i]->inRefIdleState())
+            continue;
+
+        for (int j = 0; j < banksPerRank; j++) {
+            const auto *bank_queue =
+                queue.bankQueue(pseudoChannel, i * banksPerRank + j);
+            if (!bank_queue || bank_queue->empty())
+                continue;
+
+            const Bank& bank = ranks[i]->banks[j];
+            const auto *hit = bank_queue->oldest(bank.openRow);
+            if (hit) {
+                const Tick col_allowed_at = (*hit->it)->isRead() ?
+                    bank.rdAllowedAt : bank.wrAllowedAt;
+                if (col_allowed_at <= min_col_at) {
+                    if (!seamless_hit || hit->seq < seamless_hit->seq) {
+                        seamless_hit = hit;
+                        seamless_col_at = col_allowed_at;
+                    }
+                } else if (!prepped_hit || hit->seq < prepped_hit->seq) {
+                    prepped_hit = hit;
+                    prepped_col_at = col_allowed_at;
+                }
+            }
+
+            got_row_miss |= bank_queue->size() > (hit ?
+                bank_queue->count(bank.openRow) : 0);
+        }
+    }
+
+    auto selected = std::make_pair(queue.end(), MaxTick);
+    if (seamless_hit) {
+        DPRINTF(DRAM, "%s Seamless buffer hit\n", __func__);
+        selected = std::make_pair(seamless_hit->it, seamless_col_at);
+    } else {
+        const MemPacketQueue::Entry *earliest = nullptr;
+        Tick earliest_col_at = MaxTick;
+        bool hidden_bank_prep = false;
+
+        if (got_row_miss) {
+            std::vector<uint32_t> earliest_banks;
+            std::tie(earliest_banks, hidden_bank_prep) =
+                minBankPrep(queue, min_col_at);
+
+            for (int i = 0; i < ranksPerChannel; i++) {
+                if (!earliest_banks[i])
+                    continue;
+                for (int j = 0; j < banksPerRank; j++) {
+                    if (!bits(earliest_banks[i], j, j))
+                        continue;
+                    const Bank& bank = ranks[i]->banks[j];
+                    const auto *miss = queue.bankQueue(pseudoChannel,
+                        i * banksPerRank + j)->oldestExcept(bank.openRow);
+                    if (miss && (!earliest || miss->seq < earliest->seq)) {
+                        earliest = miss;
+                        earliest_col_at = (*miss->it)->isRead() ?
+                            bank.rdAllowedAt : bank.wrAllowedAt;
+                    }
+                }
+            }
+        }
+
+        // give priority to packets that can issue bank commands 'behind
+        // the scenes'
+        if (earliest && (hidden_bank_prep || !prepped_hit)) {
+            selected = std::make_pair(earliest->it, earliest_col_at);
+        } else if (prepped_hit) {
+            DPRINTF(DRAM, "%s Prepped row buffer hit\n", __func__);
+            selected = std::make_pair(prepped_hit->it, prepped_col_at);
+        } else {
+            DPRINTF(DRAM, "%s no available DRAM ranks found\n", __func__);
+        }
+    }
+
+    if (verifyFRFCFS) {
+        auto expected = chooseNextFRFCFSScan(queue, min_col_at);
+        panic_if(expected != selected,
+                 "Indexed FR-FCFS chose %s at %d, queue walk chose %s at %d",
+                 selected.first == queue.end() ? "nothing" :
+                     csprintf("%#x", (*selected.first)->getAddr()),
+                 selected.second,
+                 expected.first == queue.end() ? "nothing" :
+                     csprintf("%#x", (*expected.first)->getAddr()),
+                 expected.second);
+    }
+
+    return selected;
+}
+
+std::pair<MemPacketQueue::iterator, Tick>
+DRAMInterface::chooseNextFRFCFSScan(MemPacketQueue& queue,
+                                    Tick min_col_at) const
 {
     std::vector<uint32_t> earliest_banks(ranksPerChannel, 0);
 
@@ -217,23 +329,17 @@ DRAMInterface::activateBank(Rank& rank_ref, Bank& bank_ref,
     bank_ref.rdAllowedAt = std::max(act_at + tRCD_RD, bank_ref.rdAllowedAt);
     bank_ref.wrAllowedAt = std::max(act_at + tRCD_WR, bank_ref.wrAllowedAt);
 
-    // start by enforcing tRRD
-    for (int i = 0; i < banksPerRank; i++) {
-        // next activate to any bank in this rank must not happen
-        // before tRRD
-        if (bankGroupArch && (bank_ref.bankgr == rank_ref.banks[i].bankgr)) {
-            // bank group architecture requires longer delays between
-            // ACT commands within the same bank group.  Use tRRD_L
-            // in this case
-            rank_ref.banks[i].actAllowedAt = std::max(act_at + tRRD_L,
-                                             rank_ref.banks[i].actAllowedAt);
-        } else {
-            // use shorter tRRD value when either
-            // 1) bank group architecture is not supportted
-            // 2) bank is in a different bank group
-            rank_ref.banks[i].actAllowedAt = std::max(act_at + tRRD,
-                                             rank_ref.banks[i].actAllowedAt);
-        }
+    // start by enforcing tRRD, next activate to any bank in this
+    // rank must not happen before tRRD
+    if (bankGroupArch) {
+        // bank group architecture requires longer delays between ACT
+        // commands within the same bank group.  Use tRRD_L in this
+        // case, and the shorter tRRD for the other bank groups
+        rank_ref.bankTimings.delayByGroup(rank_ref.bankTimings.actAllowedAt,
+                                          bank_ref.bankgr, act_at + tRRD_L,
+                                          act_at + tRRD);
+    } else {
+        BankTimings::delay(rank_ref.bankTimings.actAllowedAt, act_at + tRRD);
     }
 
     // next, we deal with tXAW, if the activation limit is disabled
@@ -263,11 +369,9 @@ DRAMInterface::activateBank(Rank& rank_ref, Bank& bank_ref,
             DPRINTF(DRAM, "Enforcing tXAW with X = %d, next activate "
                     "no earlier than %llu\n", activationLimit,
                     rank_ref.actTicks.back() + tXAW);
-            for (int j = 0; j < banksPerRank; j++)
-                // next activate must not happen before end of window
-                rank_ref.banks[j].actAllowedAt =
-                    std::max(rank_ref.actTicks.back() + tXAW,
-                             rank_ref.banks[j].actAllowedAt);
+            // next activate must not happen before end of window
+            BankTimings::delay(rank_ref.bankTimings.actAllowedAt,
+                               rank_ref.actTicks.back() + tXAW);
         }
     }
 
@@ -303,10 +407,7 @@ DRAMInterface::prechargeBank(Rank& rank_ref, Bank& bank, Tick pre_tick,
         // if not, shift to next burst window
         pre_at = ctrl->verifySingleCmd(pre_tick, maxCommandsPerWindow, true);
         // enforce tPPD
-        for (int i = 0; i < banksPerRank; i++) {
-            rank_ref.banks[i].preAllowedAt = std::max(pre_at + tPPD,
-                                             rank_ref.banks[i].preAllowedAt);
-        }
+        BankTimings::delay(rank_ref.bankTimings.preAllowedAt, pre_at + tPPD);
     }
 
     Tick pre_done_at = pre_at + tRP;
@@ -434,42 +535,44 @@ DRAMInterface::doBurstAccess(MemPacket* mem_pkt, Tick next_burst_at,
 
     // update the time for the next read/write burst for each
     // bank (add a max with tCCD/tCCD_L/tCCD_L_WR here)
-    Tick dly_to_rd_cmd;
-    Tick dly_to_wr_cmd;
+
+    // bank group architecture requires longer delays between
+    // RD/WR burst commands to the same bank group.
+    // tCCD_L is default requirement for same BG timing
+    // tCCD_L_WR is required for write-to-write
+    // Need to also take bus turnaround delays into account
+    const Tick same_bg_dly_to_rd = mem_pkt->isRead() ?
+        tCCD_L : std::max(tCCD_L, wrToRdDlySameBG);
+    const Tick same_bg_dly_to_wr = mem_pkt->isRead() ?
+        std::max(tCCD_L, rdToWrDlySameBG) : tCCD_L_WR;
+
+    // tBURST is default requirement for diff BG timing
+    // Need to also take bus turnaround delays into account
+    const Tick dly_to_rd_cmd = mem_pkt->isRead() ? burst_gap :
+                                                   writeToReadDelay();
+    const Tick dly_to_wr_cmd = mem_pkt->isRead() ? readToWriteDelay() :
+                                                   burst_gap;
+
     for (int j = 0; j < ranksPerChannel; j++) {
-        for (int i = 0; i < banksPerRank; i++) {
-            if (mem_pkt->rank == j) {
-                if (bankGroupArch &&
-                   (bank_ref.bankgr == ranks[j]->banks[i].bankgr)) {
-                    // bank group architecture requires longer delays between
-                    // RD/WR burst commands to the same bank group.
-                    // tCCD_L is default requirement for same BG timing
-                    // tCCD_L_WR is required for write-to-write
-                    // Need to also take bus turnaround delays into account
-                    dly_to_rd_cmd = mem_pkt->isRead() ?
-                                    tCCD_L : std::max(tCCD_L, wrToRdDlySameBG);
-                    dly_to_wr_cmd = mem_pkt->isRead() ?
-                                    std::max(tCCD_L, rdToWrDlySameBG) :
-                                    tCCD_L_WR;
-                } else {
-                    // tBURST is default requirement for diff BG timing
-                    // Need to also take bus turnaround delays into account
-                    dly_to_rd_cmd = mem_pkt->isRead() ? burst_gap :
-                                                       writeToReadDelay();
-                    dly_to_wr_cmd = mem_pkt->isRead() ? readToWriteDelay() :
-                                                       burst_gap;
-                }
-            } else {
-                // different rank is by default in a different bank group and
-                // doesn't require longer tCCD or additional RTW, WTR delays
-                // Need to account for rank-to-rank switching
-                dly_to_wr_cmd = rankToRankDelay();
-                dly_to_rd_cmd = rankToRankDelay();
-            }
-            ranks[j]->banks[i].rdAllowedAt = std::max(cmd_at + dly_to_rd_cmd,
-                                             ranks[j]->banks[i].rdAllowedAt);
-            ranks[j]->banks[i].wrAllowedAt = std::max(cmd_at + dly_to_wr_cmd,
-                                             ranks[j]->banks[i].wrAllowedAt);
+        BankTimings &timings = ranks[j]->bankTimings;
+        if (mem_pkt->rank != j) {
+            // different rank is by default in a different bank group and
+            // doesn't require longer tCCD or additional RTW, WTR delays
+            // Need to account for rank-to-rank switching
+            BankTimings::delay(timings.rdAllowedAt,
+                               cmd_at + rankToRankDelay());
+            BankTimings::delay(timings.wrAllowedAt,
+                               cmd_at + rankToRankDelay());
+        } else if (bankGroupArch) {
+            timings.delayByGroup(timings.rdAllowedAt, bank_ref.bankgr,
+                                 cmd_at + same_bg_dly_to_rd,
+                                 cmd_at + dly_to_rd_cmd);
+            timings.delayByGroup(timings.wrAllowedAt, bank_ref.bankgr,
+                                 cmd_at + same_bg_dly_to_wr,
+                                 cmd_at + dly_to_wr_cmd);
+        } else {
+            BankTimings::delay(timings.rdAllowedAt, cmd_at + dly_to_rd_cmd);
+            BankTimings::delay(timings.wrAllowedAt, cmd_at + dly_to_wr_cmd);
         }
     }
 
@@ -622,14 +725,12 @@ DRAMInterface::addRankToRankDelay(Tick cmd_at)
     // update timing for DRAM ranks due to bursts issued
     // to ranks on other media interfaces
     for (auto n : ranks) {
-        for (int i = 0; i < banksPerRank; i++) {
-            // different rank by default
-            // Need to only account for rank-to-rank switching
-            n->banks[i].rdAllowedAt = std::max(cmd_at + rankToRankDelay(),
-                                             n->banks[i].rdAllowedAt);
-            n->banks[i].wrAllowedAt = std::max(cmd_at + rankToRankDelay(),
-                                             n->banks[i].wrAllowedAt);
-        }
+        // different rank by default
+        // Need to only account for rank-to-rank switching
+        BankTimings::delay(n->bankTimings.rdAllowedAt,
+                           cmd_at + rankToRankDelay());
+        BankTimings::delay(n->bankTimings.wrAllowedAt,
+                           cmd_at + rankToRankDelay());
     }
 }
 
@@ -657,6 +758,8 @@ DRAMInterface::DRAMInterface(const DRAMInterfaceParams &_p)
       maxAccessesPerRow(_p.max_accesses_per_row),
       timeStampOffset(0), activeRank(0),
       enableDRAMPowerdown(_p.enable_dram_powerdown),
+      verifyFRFCFS(_p.verify_frfcfs),
+      lazyRefresh(_p.lazy_refresh), refreshIsLazy(false),
       lastStatsResetTick(0),
       stats(*this)
 {
@@ -919,6 +1022,9 @@ DRAMInterface::decodePacket(const PacketPtr pkt, Addr pkt_addr,
 
 void DRAMInterface::setupRank(const uint8_t rank, const bool is_read)
 {
+    // the rank is about to be accessed, so bring it up to date
+    syncRefresh();
+
     // increment entry count of the rank based on packet type
     if (is_read) {
         ++ranks[rank]->readEntries;
@@ -1016,9 +1122,21 @@ DRAMInterface::allRanksDrained() const
     return all_ranks_drained;
 }
 
+void
+DRAMInterface::resetStats()
+{
+    // account for any refreshes modelled lazily before the stats of the
+    // interface and its ranks are reset
+    syncRefresh();
+
+    MemInterface::resetStats();
+}
+
 void
 DRAMInterface::suspend()
 {
+    syncRefresh();
+
     for (auto r : ranks) {
         r->suspend();
     }
@@ -1041,16 +1159,32 @@ DRAMInterface::minBankPrep(const MemPacketQueue& queue,
     // determine if we have queued transactions targetting the
     // bank in question
     std::vector<bool> got_waiting(ranksPerChannel * banksPerRank, false);
-    for (const auto& p : queue) {
-        if (p->pseudoChannel != pseudoChannel)
+    for (int i = 0; i < ranksPerChannel; i++) {
+        if (!ranks[i]->inRefIdleState())
             continue;
-        if (p->isDram() && ranks[p->rank]->inRefIdleState())
-            got_waiting[p->bankId] = true;
+        for (int j = 0; j < banksPerRank; j++) {
+            const uint16_t bank_id = i * banksPerRank + j;
+            const auto *bank_queue = queue.bankQueue(pseudoChannel, bank_id);
+            got_waiting[bank_id] = bank_queue && !bank_queue->empty();
+        }
     }
 
+    // the bus direction, and hence the column timing of interest, is
+    // the same for all the banks
+    const bool read_bus = ctrl->inReadBusState(false, this);
+
+    // latest Tick for which ACT can occur without
+    // incurring additoinal delay on the data bus
+    const Tick tRCD = read_bus ? tRCD_RD : tRCD_WR;
+    const Tick hidden_act_max = std::max(min_col_at - tRCD, curTick());
+
     // Find command with optimal bank timing
     // Will prioritize commands that can issue seamlessly.
     for (int i = 0; i < ranksPerChannel; i++) {
+        const BankTimings &timings = ranks[i]->bankTimings;
+        const std::vector<Tick> &col_allowed_at = read_bus ?
+            timings.rdAllowedAt : timings.wrAllowedAt;
+
         for (int j = 0; j < banksPerRank; j++) {
             uint16_t bank_id = i * banksPerRank + j;
 
@@ -1063,22 +1197,11 @@ DRAMInterface::minBankPrep(const MemPacketQueue& queue,
                 // an activate, ignoring any rank-to-rank switching
                 // cost in this calculation
                 Tick act_at = ranks[i]->banks[j].openRow == Bank::NO_ROW ?
-                    std::max(ranks[i]->banks[j].actAllowedAt, curTick()) :
-                    std::max(ranks[i]->banks[j].preAllowedAt, curTick()) + tRP;
-
-                // latest Tick for which ACT can occur without
-                // incurring additoinal delay on the data bus
-                const Tick tRCD = ctrl->inReadBusState(false, this) ?
-                                                tRCD_RD : tRCD_WR;
-                const Tick hidden_act_max =
-                            std::max(min_col_at - tRCD, curTick());
+                    std::max(timings.actAllowedAt[j], curTick()) :
+                    std::max(timings.preAllowedAt[j], curTick()) + tRP;
 
                 // When is the earliest the R/W burst can issue?
-                const Tick col_allowed_at = ctrl->inReadBusState(false,
-                                              this) ?
-                                              ranks[i]->banks[j].rdAllowedAt :
-                                              ranks[i]->banks[j].wrAllowedAt;
-                Tick col_at = std::max(col_allowed_at, act_at + tRCD);
+                Tick col_at = std::max(col_allowed_at[j], act_at + tRCD);
 
                 // bank can issue burst back-to-back (seamlessly) with
                 // previous burst
@@ -1115,6 +1238,81 @@ DRAMInterface::minBankPrep(const MemPacketQueue& queue,
     return std::make_pair(bank_mask, hidden_bank_prep);
 }
 
+bool
+DRAMInterface::startLazyRefresh(const Rank *due)
+{
+    // after a refresh the rank would go to sleep if powerdown is
+    // enabled, and it then sleeps through refreshes anyway
+    if (!lazyRefresh || enableDRAMPowerdown || !ctrl->refreshCanBeLazy(this))
+        return false;
+
+    for (auto r : ranks) {
+        if (!r->canRefreshLazily() ||
+                (r != due && !r->refreshEvent.scheduled())) {
+            return false;
+        }
+    }
+
+    DPRINTF(DRAMState, "All ranks idle, modelling refreshes lazily\n");
+
+    for (auto r : ranks) {
+        if (r == due) {
+            r->lazyRefreshAt = curTick();
+        } else {
+            r->lazyRefreshAt = r->refreshEvent.when();
+            r->deschedule(r->refreshEvent);
+        }
+    }
+    refreshIsLazy = true;
+
+    return true;
+}
+
+void
+DRAMInterface::syncRefresh()
+{
+    if (!refreshIsLazy)
+        return;
+
+    refreshIsLazy = false;
+
+    DPRINTF(DRAMState, "Performing lazily modelled refreshes\n");
+
+    // Every completed refresh restarted the scheduler, which found
+    // nothing to do, unless a refresh of another rank completed in the
+    // same tick. Refreshes recur with the same period on all ranks, so
+    // the completions of two ranks coincide if and only if they are
+    // congruent modulo the period, and the completions of each rank
+    // form a run of consecutive multiples of the period from there.
+    const Tick period = tREFI - tRP;
+    std::map<Tick, std::vector<std::pair<Tick, Tick>>> completions;
+    for (auto r : ranks) {
+        Tick first_done_at;
+        uint64_t num_done;
+        std::tie(first_done_at, num_done) = r->replayRefreshes();
+        if (num_done) {
+            const Tick first = first_done_at / period;
+            completions[first_done_at % period].emplace_back(
+                first, first + num_done);
+        }
+    }
+
+    uint64_t restarts = 0;
+    for (auto &residue : completions) {
+        auto &runs = residue.second;
+        std::sort(runs.begin(), runs.end());
+        Tick covered = 0;
+        for (const auto &run : runs) {
+            const Tick from = std::max(run.first, covered);
+            if (run.second > from)
+                restarts += run.second - from;
+            covered = std::max(covered, run.second);
+        }
+    }
+
+    ctrl->recordLazyRefreshRestarts(this, restarts);
+}
+
 DRAMInterface::Rank::Rank(const DRAMInterfaceParams &_p,
                          int _rank, DRAMInterface& _dram)
     : EventManager(&_dram), dram(_dram),
@@ -1122,8 +1320,10 @@ DRAMInterface::Rank::Rank(const DRAMInterfaceParams &_p,
       pwrStateTick(0), refreshDueAt(0), pwrState(PWR_IDLE),
       refreshState(REF_IDLE), inLowPowerState(false), rank(_rank),
       readEntries(0), writeEntries(0), outstandingEvents(0),
-      wakeUpAllowedAt(0), power(_p, false), banks(_p.banks_per_rank),
-      numBanksActive(0), actTicks(_p.activation_limit, 0), lastBurstTick(0),
+      wakeUpAllowedAt(0), power(_p, false),
+      bankTimings(_p.banks_per_rank), numBanksActive(0),
+      actTicks(_p.activation_limit, 0), lastBurstTick(0),
+      lazyRefreshAt(MaxTick),
       writeDoneEvent([this]{ processWriteDoneEvent(); }, name()),
       activateEvent([this]{ processActivateEvent(); }, name()),
       prechargeEvent([this]{ processPrechargeEvent(); }, name()),
@@ -1132,8 +1332,10 @@ DRAMInterface::Rank::Rank(const DRAMInterfaceParams &_p,
       wakeUpEvent([this]{ processWakeUpEvent(); }, name()),
       stats(_dram, *this)
 {
+    // the banks refer into bankTimings, which is never resized
+    banks.reserve(_p.banks_per_rank);
     for (int b = 0; b < _p.banks_per_rank; b++) {
-        banks[b].bank = b;
+        banks.emplace_back(bankTimings, b);
         // GDDR addressing of banks to BG is linear.
         // Here we assume that all DRAM generations address bank groups as
         // follows:
@@ -1150,6 +1352,7 @@ DRAMInterface::Rank::Rank(const DRAMInterfaceParams &_p,
             // No bank groups; simply assign to bank number
             banks[b].bankgr = b;
         }
+        bankTimings.bankGroup[b] = banks[b].bankgr;
     }
 }
 
@@ -1171,7 +1374,7 @@ DRAMInterface::Rank::suspend()
     deschedule(refreshEvent);
 
     // Update the stats
-    updatePowerStats();
+    updatePowerStats(curTick());
 
     // don't automatically transition back to LP state after next REF
     pwrStatePostRefresh = PWR_IDLE;
@@ -1188,6 +1391,79 @@ DRAMInterface::Rank::isQueueEmpty() const
     return no_queued_cmds;
 }
 
+bool
+DRAMInterface::Rank::canRefreshLazily() const
+{
+    return refreshState == REF_IDLE && pwrState == PWR_IDLE &&
+        pwrStatePostRefresh == PWR_IDLE && !inLowPowerState &&
+        numBanksActive == 0 && outstandingEvents == 0 &&
+        readEntries == 0 && writeEntries == 0 &&
+        !writeDoneEvent.scheduled() && !activateEvent.scheduled() &&
+        !prechargeEvent.scheduled() && !powerEvent.scheduled() &&
+        !wakeUpEvent.scheduled();
+}
+
+std::pair<Tick, uint64_t>
+DRAMInterface::Rank::replayRefreshes()
+{
+    const Tick first_done_at = lazyRefreshAt + dram.tRFC;
+    uint64_t num_done = 0;
+
+    // With the rank idle, each refresh goes from the idle power state
+    // straight into the refresh, and back to idle once it is done, with
+    // the next one due a refresh interval later. Perform the same state
+    // updates and DRAMPower calls as the refresh event loop would, in
+    // the same order, so that the stats come out the same.
+    while (lazyRefreshAt <= curTick()) {
+        const Tick ref_at = lazyRefreshAt;
+        const Tick ref_done_at = ref_at + dram.tRFC;
+
+        stats.pwrStateTime[PWR_IDLE] += ref_at - pwrStateTick;
+        pwrStateTick = ref_at;
+
+        std::fill(bankTimings.actAllowedAt.begin(),
+                  bankTimings.actAllowedAt.end(), ref_done_at);
+
+        cmdList.push_back(Command(MemCommand::REF, 0, ref_at));
+
+        updatePowerStats(ref_at);
+
+        DPRINTF(DRAMPower, "%llu,REF,0,%d\n", divCeil(ref_at, dram.tCK) -
+                dram.timeStampOffset, rank);
+
+        refreshDueAt = ref_at + dram.tREFI;
+        lazyRefreshAt = refreshDueAt - dram.tRP;
+
+        if (ref_done_at >= curTick()) {
+            // still refreshing, so pick up the refresh event loop where
+            // it would be at this point
+            pwrState = PWR_REF;
+            pwrStateTrans = PWR_REF;
+            refreshState = REF_RUN;
+            ++outstandingEvents;
+
+            if (ref_done_at == curTick()) {
+                // the refresh is done, but the rank has not yet
+                // transitioned back to the idle state
+                schedulePowerEvent(PWR_IDLE, curTick());
+                schedule(refreshEvent, lazyRefreshAt);
+            } else {
+                schedule(refreshEvent, ref_done_at);
+            }
+
+            return std::make_pair(first_done_at, num_done);
+        }
+
+        stats.pwrStateTime[PWR_REF] += ref_done_at - ref_at;
+        pwrStateTick = ref_done_at;
+        ++num_done;
+    }
+
+    schedule(refreshEvent, lazyRefreshAt);
+
+    return std::make_pair(first_done_at, num_done);
+}
+
 void
 DRAMInterface::Rank::checkDrainDone()
 {
@@ -1204,7 +1480,7 @@ DRAMInterface::Rank::checkDrainDone()
 }
 
 void
-DRAMInterface::Rank::flushCmdList()
+DRAMInterface::Rank::flushCmdList(Tick when)
 {
     // at the moment sort the list of commands and update the counters
     // for DRAMPower libray when doing a refresh
@@ -1214,19 +1490,19 @@ DRAMInterface::Rank::flushCmdList()
     // push to commands to DRAMPower
     for ( ; next_iter != cmdList.end() ; ++next_iter) {
          Command cmd = *next_iter;
-         if (cmd.timeStamp <= curTick()) {
-             // Move all commands at or before curTick to DRAMPower
+         if (cmd.timeStamp <= when) {
+             // Move all commands at or before the tick to DRAMPower
              power.powerlib.doCommand(cmd.type, cmd.bank,
                                       divCeil(cmd.timeStamp, dram.tCK) -
                                       dram.timeStampOffset);
          } else {
-             // done - found all commands at or before curTick()
-             // next_iter references the 1st command after curTick
+             // done - found all commands at or before the tick
+             // next_iter references the 1st command after the tick
              break;
          }
     }
-    // reset cmdList to only contain commands after curTick
-    // if there are no commands after curTick, updated cmdList will be empty
+    // reset cmdList to only contain commands after the tick
+    // if there are no commands after it, updated cmdList will be empty
     // in this case, next_iter is cmdList.end()
     cmdList.assign(next_iter, cmdList.end());
 }
@@ -1286,6 +1562,11 @@ DRAMInterface::Rank::processWriteDoneEvent()
 void
 DRAMInterface::Rank::processRefreshEvent()
 {
+    // if nothing is going on, hand this and all further refreshes over
+    // to be modelled lazily until the ranks are next accessed
+    if (refreshState == REF_IDLE && dram.startLazyRefresh(this))
+        return;
+
     // when first preparing the refresh, remember when it was due
     if ((refreshState == REF_IDLE) || (refreshState == REF_SREF_EXIT)) {
         // remember when the refresh is due
@@ -1343,12 +1624,12 @@ DRAMInterface::Rank::processRefreshEvent()
             // first determine when we can precharge
             Tick pre_at = curTick();
 
-            for (auto &b : banks) {
-                // respect both causality and any existing bank
-                // constraints, some banks could already have a
-                // (auto) precharge scheduled
-                pre_at = std::max(b.preAllowedAt, pre_at);
-            }
+            // respect both causality and any existing bank
+            // constraints, some banks could already have a
+            // (auto) precharge scheduled
+            pre_at = std::max(*std::max_element(
+                                  bankTimings.preAllowedAt.begin(),
+                                  bankTimings.preAllowedAt.end()), pre_at);
 
             // make sure all banks per rank are precharged, and for those that
             // already are, update their availability
@@ -1406,15 +1687,14 @@ DRAMInterface::Rank::processRefreshEvent()
 
         Tick ref_done_at = curTick() + dram.tRFC;
 
-        for (auto &b : banks) {
-            b.actAllowedAt = ref_done_at;
-        }
+        std::fill(bankTimings.actAllowedAt.begin(),
+                  bankTimings.actAllowedAt.end(), ref_done_at);
 
         // at the moment this affects all ranks
         cmdList.push_back(Command(MemCommand::REF, 0, curTick()));
 
         // Update the stats
-        updatePowerStats();
+        updatePowerStats(curTick());
 
         DPRINTF(DRAMPower, "%llu,REF,0,%d\n", divCeil(curTick(), dram.tCK) -
                 dram.timeStampOffset, rank);
@@ -1581,15 +1861,13 @@ DRAMInterface::Rank::scheduleWakeUpEvent(Tick exit_delay)
     // we try to wake-up
     schedule(wakeUpEvent, wake_up_tick);
 
-    for (auto &b : banks) {
-        // respect both causality and any existing bank
-        // constraints, some banks could already have a
-        // (auto) precharge scheduled
-        b.wrAllowedAt = std::max(wake_up_tick + exit_delay, b.wrAllowedAt);
-        b.rdAllowedAt = std::max(wake_up_tick + exit_delay, b.rdAllowedAt);
-        b.preAllowedAt = std::max(wake_up_tick + exit_delay, b.preAllowedAt);
-        b.actAllowedAt = std::max(wake_up_tick + exit_delay, b.actAllowedAt);
-    }
+    // respect both causality and any existing bank
+    // constraints, some banks could already have a
+    // (auto) precharge scheduled
+    BankTimings::delay(bankTimings.wrAllowedAt, wake_up_tick + exit_delay);
+    BankTimings::delay(bankTimings.rdAllowedAt, wake_up_tick + exit_delay);
+    BankTimings::delay(bankTimings.preAllowedAt, wake_up_tick + exit_delay);
+    BankTimings::delay(bankTimings.actAllowedAt, wake_up_tick + exit_delay);
     // Transitioning out of low power state, clear flag
     inLowPowerState = false;
 
@@ -1764,17 +2042,17 @@ DRAMInterface::Rank::processPowerEvent()
 }
 
 void
-DRAMInterface::Rank::updatePowerStats()
+DRAMInterface::Rank::updatePowerStats(Tick when)
 {
     // All commands up to refresh have completed
     // flush cmdList to DRAMPower
-    flushCmdList();
+    flushCmdList(when);
 
     // Call the function that calculates window energy at intermediate update
     // events like at refresh, stats dump as well as at simulation exit.
     // Window starts at the last time the calcWindowEnergy function was called
-    // and is upto current time.
-    power.powerlib.calcWindowEnergy(divCeil(curTick(), dram.tCK) -
+    // and is upto the given time.
+    power.powerlib.calcWindowEnergy(divCeil(when, dram.tCK) -
                                     dram.timeStampOffset);
 
     // Get the energy from DRAMPower
@@ -1802,7 +2080,7 @@ DRAMInterface::Rank::updatePowerStats()
     // power (mW) = ----------- * ----------
     //              time (tick)   tick_frequency
     stats.averagePower = (stats.totalEnergy.value() /
-                    (curTick() - dram.lastStatsResetTick)) *
+                    (when - dram.lastStatsResetTick)) *
                     (sim_clock::Frequency / 1000000000.0);
 }
 
@@ -1811,8 +2089,11 @@ DRAMInterface::Rank::computeStats()
 {
     DPRINTF(DRAM,"Computing stats due to a dump callback\n");
 
+    // account for any refreshes modelled lazily
+    dram.syncRefresh();
+
     // Update the stats
-    updatePowerStats();
+    updatePowerStats(curTick());
 
     // final update of power state times
     stats.pwrStateTime[pwrState] += (curTick() - pwrStateTick);
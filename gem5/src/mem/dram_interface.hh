@@ -258,8 +258,10 @@ class DRAMInterface : public MemInterface
 
         /**
          * Function to update Power Stats
+         *
+         * @param when Tick up to which the stats are updated
          */
-        void updatePowerStats();
+        void updatePowerStats(Tick when);
 
         /**
          * Schedule a power state transition in the future, and
@@ -327,6 +329,9 @@ class DRAMInterface : public MemInterface
          */
         std::vector<Command> cmdList;
 
+        /** Timing state of the banks, referred to by the Banks. */
+        BankTimings bankTimings;
+
         /**
          * Vector of Banks. Each rank is made of several devices which in
          * term are made from several banks.
@@ -347,6 +352,12 @@ class DRAMInterface : public MemInterface
          */
         Tick lastBurstTick;
 
+        /**
+         * When the refreshes of the rank are modelled lazily, the tick
+         * at which the next refresh is due to start.
+         */
+        Tick lazyRefreshAt;
+
         Rank(const DRAMInterfaceParams &_p, int _rank,
              DRAMInterface& _dram);
 
@@ -417,6 +428,27 @@ class DRAMInterface : public MemInterface
          */
         bool isQueueEmpty() const;
 
+        /**
+         * Check if the rank is idle in every respect, with all banks
+         * closed, nothing queued and no events outstanding other than
+         * the next refresh, so that its refreshes can be modelled
+         * lazily.
+         *
+         * @return true if the refreshes can be modelled lazily
+         */
+        bool canRefreshLazily() const;
+
+        /**
+         * Perform the refreshes modelled lazily that started at or
+         * before curTick(), and hand the rank back to the refresh event
+         * loop in the state it would be in had the refreshes been
+         * simulated with events.
+         *
+         * @return The tick at which the first refresh completed, and the
+         *         number of refreshes that completed before curTick()
+         */
+        std::pair<Tick, uint64_t> replayRefreshes();
+
         /**
          * Let the rank check if it was waiting for requests to drain
          * to allow it to transition states.
@@ -425,11 +457,13 @@ class DRAMInterface : public MemInterface
 
         /**
          * Push command out of cmdList queue that are scheduled at
-         * or before curTick() to DRAMPower library
-         * All commands before curTick are guaranteed to be complete
+         * or before a given tick to DRAMPower library
+         * All commands before the tick are guaranteed to be complete
          * and can safely be flushed.
+         *
+         * @param when Tick up to which commands are flushed
          */
-        void flushCmdList();
+        void flushCmdList(Tick when);
 
         /**
          * Computes stats just prior to dump event
@@ -548,6 +582,22 @@ class DRAMInterface : public MemInterface
     /** Enable or disable DRAM powerdown states. */
     bool enableDRAMPowerdown;
 
+    /**
+     * Check every FR-FCFS decision made using the queue's bank index
+     * against a walk of the whole queue.
+     */
+    const bool verifyFRFCFS;
+
+    /**
+     * Model the refreshes of idle ranks lazily rather than with events.
+     */
+    const bool lazyRefresh;
+
+    /**
+     * Are the refreshes of the ranks currently modelled lazily?
+     */
+    bool refreshIsLazy;
+
     /** The time when stats were last reset used to calculate average power */
     Tick lastStatsResetTick;
 
@@ -653,6 +703,18 @@ class DRAMInterface : public MemInterface
     std::pair<std::vector<uint32_t>, bool>
     minBankPrep(const MemPacketQueue& queue, Tick min_col_at) const;
 
+    /**
+     * Stop simulating the refreshes of the ranks with events, and model
+     * them lazily instead, if the controller and all ranks are idle.
+     * Called by the refresh event of a rank that is due to refresh. All
+     * the other ranks must have their next refresh scheduled, which is
+     * not the case for suspended ranks.
+     *
+     * @param due The rank whose refresh is due now
+     * @return true if the refreshes are now modelled lazily
+     */
+    bool startLazyRefresh(const Rank *due);
+
     /*
      * @return time to send a burst of data without gaps
      */
@@ -706,6 +768,14 @@ class DRAMInterface : public MemInterface
      */
     void suspend() override;
 
+    /**
+     * Perform the refreshes modelled lazily up to curTick(), and go
+     * back to simulating them with events.
+     */
+    void syncRefresh() override;
+
+    void resetStats() override;
+
     /*
      * @return time to offset next command
      */
@@ -730,6 +800,14 @@ class DRAMInterface : public MemInterface
     std::pair<MemPacketQueue::iterator, Tick>
     chooseNextFRFCFS(MemPacketQueue& queue, Tick min_col_at) const override;
 
+    /**
+     * Reference FR-FCFS implementation which walks the whole queue, used
+     * to check the indexed one when verifyFRFCFS is set. Takes the same
+     * arguments and returns the same values as chooseNextFRFCFS.
+     */
+    std::pair<MemPacketQueue::iterator, Tick>
+    chooseNextFRFCFSScan(MemPacketQueue& queue, Tick min_col_at) const;
+
     /**
      * Actually do the burst - figure out the latency it
      * will take to service the req based on bank state, channel state etc
@@ -460,6 +460,22 @@ HBMCtrl::verifyMultiCmd(Tick cmd_tick, Tick max_cmds_per_burst,
     return cmd_at;
 }
 
+DrainState
+HBMCtrl::drain()
+{
+    pc1Int->syncRefresh();
+
+    return MemCtrl::drain();
+}
+
+void
+HBMCtrl::resetStats()
+{
+    pc1Int->syncRefresh();
+
+    MemCtrl::resetStats();
+}
+
 void
 HBMCtrl::drainResume()
 {
@@ -251,7 +251,9 @@ class HBMCtrl : public MemCtrl
 
     virtual void init() override;
     virtual void startup() override;
+    DrainState drain() override;
     virtual void drainResume() override;
+    void resetStats() override;
 
 
   protected:
@@ -94,7 +94,7 @@ class HeteroMemCtrl : public MemCtrl
     pktSizeCheck(MemPacket* mem_pkt, MemInterface* mem_intr) const override;
 
     virtual void processRespondEvent(MemInterface* mem_intr,
-                        MemPacketQueue& queue,
+                        std::deque<MemPacket*>& queue,
                         EventFunctionWrapper& resp_event,
                         bool& retry_rd_req) override;
 
@@ -129,6 +129,15 @@ class HeteroMemCtrl : public MemCtrl
     DrainState drain() override;
     void drainResume() override;
 
+    /**
+     * The scheduler also serves the NVM interface, so its runs on the
+     * completion of a refresh are not necessarily idle.
+     */
+    bool refreshCanBeLazy(const MemInterface* mem_intr) override
+    {
+        return false;
+    }
+
   protected:
 
     Tick recvAtomic(PacketPtr pkt) override;
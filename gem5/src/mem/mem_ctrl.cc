@@ -486,7 +486,7 @@ MemCtrl::recvTimingReq(PacketPtr pkt)
 
 void
 MemCtrl::processRespondEvent(MemInterface* mem_intr,
-                        MemPacketQueue& queue,
+                        std::deque<MemPacket*>& queue,
                         EventFunctionWrapper& resp_event,
                         bool& retry_rd_req)
 {
@@ -879,7 +879,7 @@ MemCtrl::nonDetermReads(MemInterface* mem_intr) {
 
 void
 MemCtrl::processNextReqEvent(MemInterface* mem_intr,
-                        MemPacketQueue& resp_queue,
+                        std::deque<MemPacket*>& resp_queue,
                         EventFunctionWrapper& resp_event,
                         EventFunctionWrapper& next_req_event,
                         bool& retry_wr_req) {
@@ -1425,6 +1425,10 @@ MemCtrl::allIntfDrained() const
 DrainState
 MemCtrl::drain()
 {
+    // catch up with any refreshes modelled lazily, which the drain has
+    // to wait for
+    dram->syncRefresh();
+
     // if there is anything in any of our internal queues, keep track
     // of that as well
     if (totalWriteQueueSize || totalReadQueueSize || !respQEmpty() ||
@@ -1448,6 +1452,35 @@ MemCtrl::drain()
     }
 }
 
+void
+MemCtrl::resetStats()
+{
+    // account for any scheduler restarts due to refreshes modelled
+    // lazily before the stats are reset
+    dram->syncRefresh();
+
+    qos::MemCtrl::resetStats();
+}
+
+bool
+MemCtrl::refreshCanBeLazy(const MemInterface* mem_intr)
+{
+    // with nothing to do, a run of the scheduler only records that the
+    // bus stays in the read state, see recordLazyRefreshRestarts
+    return !turnPolicy && drainState() == DrainState::Running &&
+        !totalReadQueueSize && !totalWriteQueueSize && respQEmpty() &&
+        !requestEventScheduled(mem_intr->pseudoChannel) &&
+        !respondEventScheduled(mem_intr->pseudoChannel) &&
+        mem_intr->busState == READ && mem_intr->busStateNext == READ;
+}
+
+void
+MemCtrl::recordLazyRefreshRestarts(MemInterface* mem_intr, uint64_t count)
+{
+    for (uint64_t i = 0; i < count; ++i)
+        recordTurnaroundStats(mem_intr->busState, mem_intr->busStateNext);
+}
+
 void
 MemCtrl::drainResume()
 {
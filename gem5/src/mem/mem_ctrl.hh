@@ -46,8 +46,11 @@
 #ifndef __MEM_CTRL_HH__
 #define __MEM_CTRL_HH__
 
+#include <cassert>
 #include <deque>
+#include <list>
 #include <string>
+#include <unordered_map>
 #include <unordered_set>
 #include <utility>
 #include <vector>
@@ -215,9 +218,168 @@ class MemPacket
 
 };
 
-// The memory packets are store in a multiple dequeue structure,
-// based on their QoS priority
-typedef std::deque<MemPacket*> MemPacketQueue;
+/**
+ * A queue of memory packets in arrival order. The controller keeps one
+ * per QoS priority level for reads and for writes.
+ *
+ * Besides the packets themselves, the queue indexes its DRAM packets by
+ * pseudo channel, bank and row, so that the FR-FCFS scheduler can find
+ * the oldest row hit or the oldest request to a bank without walking the
+ * whole queue. Packets can only be added at the back, and iterators stay
+ * valid until the packet they refer to is erased.
+ */
+class MemPacketQueue
+{
+  private:
+    typedef std::list<MemPacket*> PacketList;
+
+  public:
+    typedef PacketList::value_type value_type;
+    typedef PacketList::iterator iterator;
+    typedef PacketList::const_iterator const_iterator;
+
+    /** A queued DRAM packet and its position in arrival order. */
+    struct Entry
+    {
+        uint64_t seq;
+        iterator it;
+    };
+
+    /** The DRAM packets queued for one bank, bucketed by row. */
+    class BankQueue
+    {
+      private:
+        friend class MemPacketQueue;
+
+        /** Packets to each row, oldest first. */
+        std::unordered_map<uint32_t, std::deque<Entry>> rows;
+        /** Number of packets queued for the bank. */
+        size_t numPkts = 0;
+
+      public:
+        size_t size() const { return numPkts; }
+        bool empty() const { return numPkts == 0; }
+
+        /** Number of packets queued for a row. */
+        size_t
+        count(uint32_t row) const
+        {
+            auto it = rows.find(row);
+            return it == rows.end() ? 0 : it->second.size();
+        }
+
+        /** The oldest packet to a row, or nullptr if there is none. */
+        const Entry *
+        oldest(uint32_t row) const
+        {
+            auto it = rows.find(row);
+            return it == rows.end() ? nullptr : &it->second.front();
+        }
+
+        /** The oldest packet to any row but the given one, if any. */
+        const Entry *
+        oldestExcept(uint32_t row) const
+        {
+            const Entry *found = nullptr;
+            for (const auto &bucket : rows) {
+                if (bucket.first != row &&
+                    (!found || bucket.second.front().seq < found->seq)) {
+                    found = &bucket.second.front();
+                }
+            }
+            return found;
+        }
+    };
+
+  private:
+    PacketList packets;
+    /** Bank queues, indexed by pseudo channel and then bank id. */
+    std::vector<std::vector<BankQueue>> banks;
+    /** Sequence number for the next packet added. */
+    uint64_t nextSeq = 0;
+
+    BankQueue &
+    bankQueueFor(const MemPacket *pkt)
+    {
+        if (banks.size() <= pkt->pseudoChannel)
+            banks.resize(pkt->pseudoChannel + 1);
+        auto &channel = banks[pkt->pseudoChannel];
+        if (channel.size() <= pkt->bankId)
+            channel.resize(pkt->bankId + 1);
+        return channel[pkt->bankId];
+    }
+
+    void
+    unindex(iterator pos)
+    {
+        const MemPacket *pkt = *pos;
+        if (!pkt->isDram())
+            return;
+
+        BankQueue &bank_queue = bankQueueFor(pkt);
+        auto row_it = bank_queue.rows.find(pkt->row);
+        assert(row_it != bank_queue.rows.end());
+        auto &bucket = row_it->second;
+        // Packets almost always leave in order, so this is usually the
+        // first entry.
+        auto entry = bucket.begin();
+        while (entry->it != pos)
+            ++entry;
+        bucket.erase(entry);
+        if (bucket.empty())
+            bank_queue.rows.erase(row_it);
+        --bank_queue.numPkts;
+    }
+
+  public:
+    iterator begin() { return packets.begin(); }
+    iterator end() { return packets.end(); }
+    const_iterator begin() const { return packets.begin(); }
+    const_iterator end() const { return packets.end(); }
+
+    size_t size() const { return packets.size(); }
+    bool empty() const { return packets.empty(); }
+
+    MemPacket *front() const { return packets.front(); }
+    MemPacket *back() const { return packets.back(); }
+
+    void
+    push_back(MemPacket *pkt)
+    {
+        auto pos = packets.insert(packets.end(), pkt);
+        uint64_t seq = nextSeq++;
+        if (pkt->isDram()) {
+            BankQueue &bank_queue = bankQueueFor(pkt);
+            bank_queue.rows[pkt->row].push_back({seq, pos});
+            ++bank_queue.numPkts;
+        }
+    }
+
+    iterator
+    erase(iterator pos)
+    {
+        unindex(pos);
+        return packets.erase(pos);
+    }
+
+    void pop_front() { erase(packets.begin()); }
+
+    /**
+     * The DRAM packets queued for a bank.
+     *
+     * @return The bank's queue, or nullptr if no packet to the bank has
+     * been queued yet.
+     */
+    const BankQueue *
+    bankQueue(uint8_t pseudo_channel, uint16_t bank_id) const
+    {
+        if (pseudo_channel >= banks.size() ||
+            bank_id >= banks[pseudo_channel].size()) {
+            return nullptr;
+        }
+        return &banks[pseudo_channel][bank_id];
+    }
+};
 
 
 /**
@@ -300,14 +462,14 @@ class MemCtrl : public qos::MemCtrl
      * in these methods
      */
     virtual void processNextReqEvent(MemInterface* mem_intr,
-                          MemPacketQueue& resp_queue,
+                          std::deque<MemPacket*>& resp_queue,
                           EventFunctionWrapper& resp_event,
                           EventFunctionWrapper& next_req_event,
                           bool& retry_wr_req);
     EventFunctionWrapper nextReqEvent;
 
     virtual void processRespondEvent(MemInterface* mem_intr,
-                        MemPacketQueue& queue,
+                        std::deque<MemPacket*>& queue,
                         EventFunctionWrapper& resp_event,
                         bool& retry_rd_req);
     EventFunctionWrapper respondEvent;
@@ -686,6 +848,28 @@ class MemCtrl : public qos::MemCtrl
 
     DrainState drain() override;
 
+    void resetStats() override;
+
+    /**
+     * Check if the controller is idle as far as an interface is
+     * concerned, with nothing queued, no events scheduled and the bus
+     * staying in the read state, so that the refreshes of the interface
+     * can be modelled lazily.
+     *
+     * @param mem_intr memory interface to check
+     * @return true if the refreshes can be modelled lazily
+     */
+    virtual bool refreshCanBeLazy(const MemInterface* mem_intr);
+
+    /**
+     * Account for the scheduler restarts of refreshes modelled lazily,
+     * each of which would have found nothing to do.
+     *
+     * @param mem_intr memory interface that was refreshed
+     * @param count number of restarts
+     */
+    void recordLazyRefreshRestarts(MemInterface* mem_intr, uint64_t count);
+
     /**
      * Check for command bus contention for single cycle command.
      * If there is contention, shift command to next burst.
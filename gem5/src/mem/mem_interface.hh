@@ -46,6 +46,7 @@
 #ifndef __MEM_INTERFACE_HH__
 #define __MEM_INTERFACE_HH__
 
+#include <algorithm>
 #include <deque>
 #include <string>
 #include <unordered_set>
@@ -74,11 +75,75 @@ namespace memory
 class MemInterface : public AbstractMemory
 {
   protected:
+    /**
+     * The timing state of all the banks of a rank, kept as one
+     * contiguous array per command rather than per bank. Constraints
+     * that apply to many banks at once, which is the case for most
+     * commands, then become branch-free loops over the arrays that
+     * the compiler can vectorise.
+     */
+    class BankTimings
+    {
+
+      public:
+        /** When each bank can accept a read. */
+        std::vector<Tick> rdAllowedAt;
+        /** When each bank can accept a write. */
+        std::vector<Tick> wrAllowedAt;
+        /** When each bank can be precharged. */
+        std::vector<Tick> preAllowedAt;
+        /** When each bank can be activated. */
+        std::vector<Tick> actAllowedAt;
+        /** Bank group of each bank. */
+        std::vector<uint8_t> bankGroup;
+
+        BankTimings(unsigned banks) :
+            rdAllowedAt(banks, 0), wrAllowedAt(banks, 0),
+            preAllowedAt(banks, 0), actAllowedAt(banks, 0),
+            bankGroup(banks, 0)
+        { }
+
+        /**
+         * Make sure a command is not allowed at any bank before a
+         * given tick.
+         *
+         * @param allowed_at One of the arrays of this object
+         * @param at Earliest tick for the command
+         */
+        static void
+        delay(std::vector<Tick> &allowed_at, Tick at)
+        {
+            for (auto &t : allowed_at)
+                t = std::max(t, at);
+        }
+
+        /**
+         * Make sure a command is not allowed at any bank before a
+         * given tick, which depends on whether the bank is in a
+         * given bank group.
+         *
+         * @param allowed_at One of the arrays of this object
+         * @param group Bank group that sees same_at
+         * @param same_at Earliest tick for the banks in the group
+         * @param other_at Earliest tick for the other banks
+         */
+        void
+        delayByGroup(std::vector<Tick> &allowed_at, uint8_t group,
+                     Tick same_at, Tick other_at) const
+        {
+            for (size_t i = 0; i < allowed_at.size(); ++i) {
+                const Tick at = bankGroup[i] == group ? same_at : other_at;
+                allowed_at[i] = std::max(allowed_at[i], at);
+            }
+        }
+    };
+
     /**
      * A basic class to track the bank state, i.e. what row is
      * currently open (if any), when is the bank free to accept a new
      * column (read/write) command, when can it be precharged, and
-     * when can it be activated.
+     * when can it be activated. The times refer into the BankTimings
+     * of the rank.
      *
      * The bank also keeps track of how many bytes have been accessed
      * in the open row since it was opened.
@@ -93,17 +158,20 @@ class MemInterface : public AbstractMemory
         uint8_t bank;
         uint8_t bankgr;
 
-        Tick rdAllowedAt;
-        Tick wrAllowedAt;
-        Tick preAllowedAt;
-        Tick actAllowedAt;
+        Tick &rdAllowedAt;
+        Tick &wrAllowedAt;
+        Tick &preAllowedAt;
+        Tick &actAllowedAt;
 
         uint32_t rowAccesses;
         uint32_t bytesAccessed;
 
-        Bank() :
-            openRow(NO_ROW), bank(0), bankgr(0),
-            rdAllowedAt(0), wrAllowedAt(0), preAllowedAt(0), actAllowedAt(0),
+        Bank(BankTimings &timings, uint8_t _bank) :
+            openRow(NO_ROW), bank(_bank), bankgr(0),
+            rdAllowedAt(timings.rdAllowedAt[_bank]),
+            wrAllowedAt(timings.wrAllowedAt[_bank]),
+            preAllowedAt(timings.preAllowedAt[_bank]),
+            actAllowedAt(timings.actAllowedAt[_bank]),
             rowAccesses(0), bytesAccessed(0)
         { }
     };
@@ -385,6 +453,13 @@ class MemInterface : public AbstractMemory
         "not be executed from here.\n");
     }
 
+    /**
+     * Bring any state the interface models lazily up to date with
+     * curTick(). The controller calls this before it inspects the
+     * interface outside of the interface's own events.
+     */
+    virtual void syncRefresh() {}
+
     /**
      * This function is NVM specific.
      */
@@ -92,12 +92,15 @@ NVMInterface::NVMInterface(const NVMInterfaceParams &_p)
 
 NVMInterface::Rank::Rank(const NVMInterfaceParams &_p,
                          int _rank, NVMInterface& _nvm)
-    : EventManager(&_nvm), rank(_rank), banks(_p.banks_per_rank)
+    : EventManager(&_nvm), rank(_rank), bankTimings(_p.banks_per_rank)
 {
+    // the banks refer into bankTimings, which is never resized
+    banks.reserve(_p.banks_per_rank);
     for (int b = 0; b < _p.banks_per_rank; b++) {
-        banks[b].bank = b;
+        banks.emplace_back(bankTimings, b);
         // No bank groups; simply assign to bank number
         banks[b].bankgr = b;
+        bankTimings.bankGroup[b] = b;
     }
 }
 
@@ -444,26 +447,21 @@ NVMInterface::doBurstAccess(MemPacket* pkt, Tick next_burst_at,
     // Use the same bus delays defined for NVM
     pkt->readyTime = cmd_at + tSEND + tBURST;
 
-    Tick dly_to_rd_cmd;
-    Tick dly_to_wr_cmd;
     for (auto n : ranks) {
-        for (int i = 0; i < banksPerRank; i++) {
-            // base delay is a function of tBURST and bus turnaround
-            dly_to_rd_cmd = pkt->isRead() ? tBURST : writeToReadDelay();
-            dly_to_wr_cmd = pkt->isRead() ? readToWriteDelay() : tBURST;
-
-            if (pkt->rank != n->rank) {
-                // adjust timing for different ranks
-                // Need to account for rank-to-rank switching with tCS
-                dly_to_wr_cmd = rankToRankDelay();
-                dly_to_rd_cmd = rankToRankDelay();
-            }
-            n->banks[i].rdAllowedAt = std::max(cmd_at + dly_to_rd_cmd,
-                                      n->banks[i].rdAllowedAt);
-
-            n->banks[i].wrAllowedAt = std::max(cmd_at + dly_to_wr_cmd,
-                                      n->banks[i].wrAllowedAt);
+        // base delay is a function of tBURST and bus turnaround
+        Tick dly_to_rd_cmd = pkt->isRead() ? tBURST : writeToReadDelay();
+        Tick dly_to_wr_cmd = pkt->isRead() ? readToWriteDelay() : tBURST;
+
+        if (pkt->rank != n->rank) {
+            // adjust timing for different ranks
+            // Need to account for rank-to-rank switching with tCS
+            dly_to_wr_cmd = rankToRankDelay();
+            dly_to_rd_cmd = rankToRankDelay();
         }
+        BankTimings::delay(n->bankTimings.rdAllowedAt,
+                           cmd_at + dly_to_rd_cmd);
+        BankTimings::delay(n->bankTimings.wrAllowedAt,
+                           cmd_at + dly_to_wr_cmd);
     }
 
     DPRINTF(NVM, "NVM Access to %#x, ready at %lld.\n",
@@ -590,14 +588,12 @@ NVMInterface::addRankToRankDelay(Tick cmd_at)
     // update timing for NVM ranks due to bursts issued
     // to ranks for other media interfaces
     for (auto n : ranks) {
-        for (int i = 0; i < banksPerRank; i++) {
-            // different rank by default
-            // Need to only account for rank-to-rank switching
-            n->banks[i].rdAllowedAt = std::max(cmd_at + rankToRankDelay(),
-                                             n->banks[i].rdAllowedAt);
-            n->banks[i].wrAllowedAt = std::max(cmd_at + rankToRankDelay(),
-                                             n->banks[i].wrAllowedAt);
-        }
+        // different rank by default
+        // Need to only account for rank-to-rank switching
+        BankTimings::delay(n->bankTimings.rdAllowedAt,
+                           cmd_at + rankToRankDelay());
+        BankTimings::delay(n->bankTimings.wrAllowedAt,
+                           cmd_at + rankToRankDelay());
     }
 }
 
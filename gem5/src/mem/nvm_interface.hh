@@ -76,6 +76,9 @@ class NVMInterface : public MemInterface
          */
         uint8_t rank;
 
+        /** Timing state of the banks, referred to by the Banks. */
+        BankTimings bankTimings;
+
         /**
          * Vector of NVM banks. Each rank is made of several banks
          * that can be accessed in parallel.
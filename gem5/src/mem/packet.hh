@@ -58,6 +58,7 @@
 #include "base/extensible.hh"
 #include "base/flags.hh"
 #include "base/logging.hh"
+#include "base/pool_allocator.hh"
 #include "base/printable.hh"
 #include "base/types.hh"
 #include "mem/htm.hh"
@@ -386,6 +387,16 @@ class Packet : public Printable, public Extensible<Packet>
     */
     PacketDataPtr data;
 
+    /** Payloads of up to this many bytes are stored in the packet. */
+    static constexpr unsigned InlineDataSize = 64;
+
+    /**
+     * Storage for small payloads allocated by the packet itself, so
+     * that the common cache-line sized accesses need no separate heap
+     * allocation for their data.
+     */
+    uint8_t inlineData[InlineDataSize];
+
     /// The address of the request.  This address could be virtual or
     /// physical, depending on the system configuration.
     Addr addr;
@@ -1084,6 +1095,23 @@ class Packet : public Printable, public Extensible<Packet>
         deleteData();
     }
 
+    /**
+     * Packets are recycled through a per-thread pool rather than
+     * allocated from the heap every time.
+     */
+    static void *
+    operator new(size_t size)
+    {
+        assert(size == sizeof(Packet));
+        return PoolAllocator<Packet>().allocate(1);
+    }
+
+    static void
+    operator delete(void *p)
+    {
+        PoolAllocator<Packet>().deallocate(static_cast<Packet *>(p), 1);
+    }
+
     /**
      * Take a request packet and modify it in place to be suitable for
      * returning as a response to that request.
@@ -1385,7 +1413,7 @@ class Packet : public Printable, public Extensible<Packet>
     void
     deleteData()
     {
-        if (flags.isSet(DYNAMIC_DATA))
+        if (flags.isSet(DYNAMIC_DATA) && data != inlineData)
             delete [] data;
 
         flags.clear(STATIC_DATA|DYNAMIC_DATA);
@@ -1401,7 +1429,8 @@ class Packet : public Printable, public Extensible<Packet>
         if (hasData() || hasRespData()) {
             assert(flags.noneSet(STATIC_DATA|DYNAMIC_DATA));
             flags.set(DYNAMIC_DATA);
-            data = new uint8_t[getSize()];
+            data = getSize() <= InlineDataSize ? inlineData :
+                new uint8_t[getSize()];
         }
     }
 
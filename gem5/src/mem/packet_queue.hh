@@ -49,7 +49,7 @@
  * for the flow control of the port.
  */
 
-#include <list>
+#include <deque>
 
 #include "mem/port.hh"
 #include "sim/drain.hh"
@@ -76,7 +76,12 @@ class PacketQueue : public Drainable
         {}
     };
 
-    typedef std::list<DeferredPacket> DeferredPacketList;
+    /**
+     * Outgoing packets, ordered by the time they are ready to be sent,
+     * and by insertion for equal times. A deque rather than a list
+     * avoids allocating a node per packet.
+     */
+    typedef std::deque<DeferredPacket> DeferredPacketList;
 
     /** A list of outgoing packets. */
     DeferredPacketList transmitList;
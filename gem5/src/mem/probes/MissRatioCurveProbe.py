@@ -0,0 +1,63 @@
+# Copyright (c) 2026 The Regents of the University of California.
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+from m5.params import *
+from m5.proxy import *
+from m5.SimObject import SimObject
+
+
+class MissRatioCurveProbe(SimObject):
+    """Shadow tags sampling a few sets of a cache, giving at every stats
+    dump the miss ratio the cache would have had at other sizes and
+    associativities, assuming LRU replacement.
+    """
+
+    type = "MissRatioCurveProbe"
+    cxx_header = "mem/probes/miss_ratio_curve.hh"
+    cxx_class = "gem5::MissRatioCurveProbe"
+
+    manager = Param.SimObject(Parent.any, "Cache to instrument")
+    system = Param.System(Parent.any, "System the cache belongs to")
+
+    size = Param.MemorySize(Parent.size, "Capacity of the cache in bytes")
+    assoc = Param.Unsigned(Parent.assoc, "Associativity of the cache")
+    block_size = Param.Unsigned(
+        Parent.cache_line_size, "Block size of the cache in bytes"
+    )
+
+    # each candidate number of sets gets its own shadow tags, and each
+    # of them covers all the associativities up to the largest one
+    set_shifts = VectorParam.Int(
+        [-1, 0, 1],
+        "Log2 of the number of sets of each candidate geometry, "
+        "relative to the number of sets of the cache",
+    )
+    max_assoc_factor = Param.Unsigned(
+        4, "Largest candidate associativity as a multiple of the cache's"
+    )
+    sampled_sets = Param.Unsigned(
+        32, "Number of sets sampled in each candidate geometry"
+    )
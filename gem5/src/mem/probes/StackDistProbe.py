@@ -65,3 +65,16 @@ class StackDistProbe(BaseMemProbe):
     # logarithmic histogram bins and enable/disable
     log_hist_bins = Param.Unsigned("32", "Bins in logarithmic histograms")
     disable_log_hists = Param.Bool(False, "Disable logarithmic histograms")
+
+    # approximate the stack distances by only tracking a sample of the
+    # lines chosen by address hash, with each sampled request standing
+    # for the requests to the lines left out, trading accuracy for
+    # host memory and time
+    sampling_shift = Param.Unsigned(
+        0, "Track 1 in 2^N lines (0 to track all the lines)"
+    )
+    max_tracked_lines = Param.Unsigned(
+        0,
+        "Halve the sampling rate whenever more lines are tracked "
+        "(0 for no limit)",
+    )
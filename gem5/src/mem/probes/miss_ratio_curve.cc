@@ -0,0 +1,214 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/probes/miss_ratio_curve.hh"
+
+#include <algorithm>
+#include <limits>
+#include <string>
+
+#include "base/intmath.hh"
+#include "base/logging.hh"
+#include "mem/packet.hh"
+#include "params/MissRatioCurveProbe.hh"
+#include "sim/system.hh"
+
+namespace gem5
+{
+
+MissRatioCurveProbe::MissRatioCurveProbe(const MissRatioCurveProbeParams &p)
+    : SimObject(p),
+      system(p.system),
+      blkSize(p.block_size),
+      assoc(p.assoc),
+      maxWays(p.assoc * p.max_assoc_factor),
+      stats(*this)
+{
+    fatal_if(!isPowerOf2(blkSize), "Block size must be a power of 2\n");
+    fatal_if(maxWays == 0, "Largest candidate associativity is 0\n");
+    fatal_if(!isPowerOf2(p.sampled_sets),
+             "Number of sampled sets must be a power of 2\n");
+
+    const uint64_t cache_sets = p.size / (blkSize * assoc);
+    fatal_if(!isPowerOf2(cache_sets),
+             "Number of sets of the cache must be a power of 2\n");
+
+    for (auto shift : p.set_shifts) {
+        const uint64_t num_sets = shift >= 0 ? cache_sets << shift :
+                                               cache_sets >> -shift;
+        fatal_if(num_sets == 0, "Set shift %d leaves no sets\n", shift);
+
+        const unsigned sampled =
+            std::min<uint64_t>(p.sampled_sets, num_sets);
+        geometries.push_back(Geometry{(unsigned)num_sets,
+                                      (unsigned)(num_sets / sampled),
+                                      std::vector<std::vector<Addr>>(
+                                          sampled)});
+        for (auto &set : geometries.back().sets)
+            set.reserve(maxWays);
+    }
+}
+
+void
+MissRatioCurveProbe::regProbeListeners()
+{
+    const MissRatioCurveProbeParams &p =
+        dynamic_cast<const MissRatioCurveProbeParams &>(params());
+
+    ProbeManager *const mgr(p.manager->getProbeManager());
+    listeners.push_back(mgr->connect<AccessListener>(*this, "Hit"));
+    listeners.push_back(mgr->connect<AccessListener>(*this, "Miss"));
+}
+
+void
+MissRatioCurveProbe::startup()
+{
+    // atomic accesses do not notify the hit and miss probes of the
+    // cache, so the curve would silently stay empty
+    fatal_if(!system->isTimingMode(),
+             "%s only sees the accesses of a cache in timing mode\n",
+             name());
+}
+
+void
+MissRatioCurveProbe::handleAccess(const PacketPtr pkt)
+{
+    // uncacheable accesses, cache maintenance and clean evictions never
+    // allocate
+    if (pkt->req->isUncacheable() || pkt->req->isCacheMaintenance() ||
+        pkt->isCleanEviction())
+        return;
+
+    // writebacks, prefetches and upgrades touch the blocks but, as in
+    // the stats of the cache, are not part of the demand miss ratio
+    bool demand;
+    switch (pkt->cmd.toInt()) {
+      case MemCmd::ReadReq:
+      case MemCmd::WriteReq:
+      case MemCmd::WriteLineReq:
+      case MemCmd::ReadExReq:
+      case MemCmd::ReadCleanReq:
+      case MemCmd::ReadSharedReq:
+        demand = true;
+        break;
+      default:
+        demand = false;
+    }
+
+    // the block address leaves the low bit free for the security state
+    const Addr blk_addr = pkt->getBlockAddr(blkSize);
+    const Addr tag = blk_addr | pkt->isSecure();
+    const Addr blk_num = blk_addr / blkSize;
+
+    for (int g = 0; g < geometries.size(); g++) {
+        Geometry &geom = geometries[g];
+        const Addr set_idx = blk_num & (geom.numSets - 1);
+        if (set_idx % geom.stride)
+            continue;
+
+        auto &set = geom.sets[set_idx / geom.stride];
+        auto it = std::find(set.begin(), set.end(), tag);
+        if (demand) {
+            stats.accesses[g]++;
+            if (it != set.end())
+                stats.hits[g][it - set.begin()]++;
+        }
+
+        // move the block to the MRU position, evicting the LRU one if
+        // it was not there and the set is full
+        if (it != set.end()) {
+            std::rotate(set.begin(), it, it + 1);
+        } else {
+            if (set.size() == maxWays)
+                set.pop_back();
+            set.insert(set.begin(), tag);
+        }
+    }
+}
+
+MissRatioCurveProbe::MissRatioCurveStats::MissRatioCurveStats(
+    MissRatioCurveProbe &parent)
+    : statistics::Group(&parent),
+      probe(parent),
+      ADD_STAT(accesses, statistics::units::Count::get(),
+               "Demand accesses to the sampled sets"),
+      ADD_STAT(hits, statistics::units::Count::get(),
+               "Demand hits in the sampled sets by LRU stack depth"),
+      ADD_STAT(missRatio, statistics::units::Ratio::get(),
+               "Demand miss ratio by number of sets and associativity")
+{
+}
+
+void
+MissRatioCurveProbe::MissRatioCurveStats::regStats()
+{
+    using namespace statistics;
+
+    statistics::Group::regStats();
+
+    const auto &geometries = probe.geometries;
+
+    accesses
+        .init(geometries.size());
+    hits
+        .init(geometries.size(), probe.maxWays);
+    missRatio
+        .init(geometries.size(), probe.maxWays);
+
+    for (int g = 0; g < geometries.size(); g++) {
+        const std::string sets = "sets" +
+            std::to_string(geometries[g].numSets);
+        accesses.subname(g, sets);
+        hits.subname(g, sets);
+        missRatio.subname(g, sets);
+    }
+    for (int w = 0; w < probe.maxWays; w++) {
+        hits.ysubname(w, "depth" + std::to_string(w));
+        missRatio.ysubname(w, "ways" + std::to_string(w + 1));
+    }
+}
+
+void
+MissRatioCurveProbe::MissRatioCurveStats::preDumpStats()
+{
+    statistics::Group::preDumpStats();
+
+    // a hit at a given stack depth is a hit for any larger
+    // associativity, so the curve is the running sum of the hits
+    for (int g = 0; g < probe.geometries.size(); g++) {
+        const Counter total = accesses[g].value();
+        Counter hit_sum = 0;
+        for (int w = 0; w < probe.maxWays; w++) {
+            hit_sum += hits[g][w].value();
+            missRatio[g][w] = total ? 1 - hit_sum / total :
+                std::numeric_limits<double>::quiet_NaN();
+        }
+    }
+}
+
+} // namespace gem5
@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __MEM_PROBES_MISS_RATIO_CURVE_HH__
+#define __MEM_PROBES_MISS_RATIO_CURVE_HH__
+
+#include <vector>
+
+#include "base/statistics.hh"
+#include "base/types.hh"
+#include "mem/cache/cache_probe_arg.hh"
+#include "sim/probe/probe.hh"
+#include "sim/sim_object.hh"
+
+namespace gem5
+{
+
+struct MissRatioCurveProbeParams;
+class System;
+
+/**
+ * Miss ratio curve of a cache, measured online with shadow tags.
+ *
+ * For each candidate number of sets, a few sets are sampled and kept
+ * as LRU stacks of up to max_assoc_factor times the associativity of
+ * the cache. The depth at which an access hits in a stack tells if it
+ * would have hit with any associativity up to that, so one run gives
+ * the miss ratio of every candidate size and associativity. The
+ * shadow tags only see the accesses the cache sees, and model LRU
+ * replacement and the default set indexing whatever the cache uses.
+ */
+class MissRatioCurveProbe : public SimObject
+{
+  public:
+    MissRatioCurveProbe(const MissRatioCurveProbeParams &p);
+
+    void regProbeListeners() override;
+    void startup() override;
+
+  protected:
+    /**
+     * Update the shadow tags with an access to the cache.
+     *
+     * @param pkt Packet that accessed the cache
+     */
+    void handleAccess(const PacketPtr pkt);
+
+    class AccessListener : public ProbeListenerArgBase<CacheAccessProbeArg>
+    {
+      public:
+        AccessListener(MissRatioCurveProbe &_parent, std::string name)
+            : ProbeListenerArgBase(std::move(name)), parent(_parent)
+        {}
+
+        void
+        notify(const CacheAccessProbeArg &arg) override
+        {
+            parent.handleAccess(arg.pkt);
+        }
+
+      protected:
+        MissRatioCurveProbe &parent;
+    };
+
+    /** Shadow tags of one candidate number of sets. */
+    struct Geometry
+    {
+        /** Number of sets of the candidate. */
+        unsigned numSets;
+        /** Distance between two sampled sets. */
+        unsigned stride;
+        /** Sampled sets, each ordered from MRU to LRU. */
+        std::vector<std::vector<Addr>> sets;
+    };
+
+    /** System of the cache, to check its memory mode. */
+    System *const system;
+
+    /** Block size of the cache. */
+    const unsigned blkSize;
+
+    /** Associativity of the cache. */
+    const unsigned assoc;
+
+    /** Largest candidate associativity. */
+    const unsigned maxWays;
+
+    /** Candidate geometries. */
+    std::vector<Geometry> geometries;
+
+    std::vector<ProbeListenerPtr<>> listeners;
+
+    struct MissRatioCurveStats : public statistics::Group
+    {
+        MissRatioCurveStats(MissRatioCurveProbe &parent);
+
+        void regStats() override;
+        void preDumpStats() override;
+
+        const MissRatioCurveProbe &probe;
+
+        /** Demand accesses to the sampled sets of each geometry. */
+        statistics::Vector accesses;
+
+        /** Hits per geometry and LRU stack depth. */
+        statistics::Vector2d hits;
+
+        /** Miss ratio per geometry and associativity. */
+        statistics::Vector2d missRatio;
+    } stats;
+};
+
+} // namespace gem5
+
+#endif // __MEM_PROBES_MISS_RATIO_CURVE_HH__
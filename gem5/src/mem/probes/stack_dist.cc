@@ -37,23 +37,76 @@
 
 #include "mem/probes/stack_dist.hh"
 
+#include "base/bitfield.hh"
+#include "base/intmath.hh"
 #include "params/StackDistProbe.hh"
 #include "sim/system.hh"
 
 namespace gem5
 {
 
+namespace
+{
+
+/** Mix the bits of a line address, so that any bit can be sampled on. */
+uint64_t
+hashLine(uint64_t x)
+{
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    x *= 0xc4ceb9fe1a85ec53ULL;
+    x ^= x >> 33;
+    return x;
+}
+
+} // anonymous namespace
+
 StackDistProbe::StackDistProbe(const StackDistProbeParams &p)
     : BaseMemProbe(p),
       lineSize(p.line_size),
       disableLinearHists(p.disable_linear_hists),
       disableLogHists(p.disable_log_hists),
+      maxTrackedLines(p.max_tracked_lines),
       calc(p.verify),
+      samplingShift(p.sampling_shift),
+      trackedLines(65),
+      numTrackedLines(0),
       stats(this)
 {
     fatal_if(p.system->cacheLineSize() > p.line_size,
              "The stack distance probe must use a cache line size that is "
              "larger or equal to the system's cache line size.");
+    // the weight of a sample has to fit in the histograms
+    fatal_if(samplingShift > 30, "Sampling shift %d too large\n",
+             samplingShift);
+    // the reference stack does not follow lines leaving the tree
+    fatal_if(p.verify && maxTrackedLines,
+             "Verification is not supported with a tracked lines budget");
+}
+
+bool
+StackDistProbe::isSampled(Addr line_addr, unsigned &level) const
+{
+    const uint64_t hash = hashLine(line_addr / lineSize);
+    level = hash ? ctz64(hash) : 64;
+    return level >= samplingShift;
+}
+
+void
+StackDistProbe::enforceBudget()
+{
+    while (numTrackedLines > maxTrackedLines && samplingShift < 30) {
+        // the lines with exactly samplingShift trailing zeros are no
+        // longer sampled at half the rate
+        for (auto line_addr : trackedLines[samplingShift])
+            calc.calcStackDistAndUpdate(line_addr, false);
+        numTrackedLines -= trackedLines[samplingShift].size();
+        std::vector<Addr>().swap(trackedLines[samplingShift]);
+
+        ++samplingShift;
+        stats.rateReductions++;
+    }
 }
 
 StackDistProbe::StackDistProbeStats::StackDistProbeStats(
@@ -68,7 +121,10 @@ StackDistProbe::StackDistProbeStats::StackDistProbeStats(
       ADD_STAT(writeLogHist, statistics::units::Ratio::get(),
                "Writes logarithmic distribution"),
       ADD_STAT(infiniteSD, statistics::units::Count::get(),
-               "Number of requests with infinite stack distance")
+               "Number of requests with infinite stack distance"),
+      ADD_STAT(rateReductions, statistics::units::Count::get(),
+               "Number of times the sampling rate was halved to stay "
+               "within the tracked lines budget")
 {
     using namespace statistics;
 
@@ -93,6 +149,9 @@ StackDistProbe::StackDistProbeStats::StackDistProbeStats(
 
     infiniteSD
         .flags(nozero);
+
+    rateReductions
+        .flags(nozero);
 }
 
 void
@@ -106,19 +165,35 @@ StackDistProbe::handleRequest(const probing::PacketInfo &pkt_info)
     // Align the address to a cache line size
     const Addr aligned_addr(roundDown(pkt_info.addr, lineSize));
 
-    // Calculate the stack distance
-    const uint64_t sd(calc.calcStackDistAndUpdate(aligned_addr).first);
+    // Only look at a sample of the lines if asked to, and let each
+    // sampled request stand for the ones to the lines not sampled
+    unsigned level = 0;
+    const bool sampling = samplingShift || maxTrackedLines;
+    if (sampling && !isSampled(aligned_addr, level))
+        return;
+    const int weight = 1 << samplingShift;
+
+    // Calculate the stack distance, which only counts the sampled
+    // lines and is scaled accordingly
+    uint64_t sd(calc.calcStackDistAndUpdate(aligned_addr).first);
     if (sd == StackDistCalc::Infinity) {
-        stats.infiniteSD++;
+        stats.infiniteSD += weight;
+        if (sampling) {
+            trackedLines[level].push_back(aligned_addr);
+            ++numTrackedLines;
+            if (maxTrackedLines)
+                enforceBudget();
+        }
         return;
     }
+    sd <<= samplingShift;
 
     // Sample the stack distance of the address in linear bins
     if (!disableLinearHists) {
         if (pkt_info.cmd.isRead())
-            stats.readLinearHist.sample(sd);
+            stats.readLinearHist.sample(sd, weight);
         else
-            stats.writeLinearHist.sample(sd);
+            stats.writeLinearHist.sample(sd, weight);
     }
 
     if (!disableLogHists) {
@@ -126,9 +201,9 @@ StackDistProbe::handleRequest(const probing::PacketInfo &pkt_info)
 
         // Sample the stack distance of the address in log bins
         if (pkt_info.cmd.isRead())
-            stats.readLogHist.sample(sd_lg2);
+            stats.readLogHist.sample(sd_lg2, weight);
         else
-            stats.writeLogHist.sample(sd_lg2);
+            stats.writeLogHist.sample(sd_lg2, weight);
     }
 }
 
@@ -38,6 +38,8 @@
 #ifndef __MEM_PROBES_STACK_DIST_HH__
 #define __MEM_PROBES_STACK_DIST_HH__
 
+#include <vector>
+
 #include "mem/packet.hh"
 #include "mem/probes/base.hh"
 #include "mem/stack_dist_calc.hh"
@@ -66,9 +68,40 @@ class StackDistProbe : public BaseMemProbe
     // Disable the logarithmic histograms
     const bool disableLogHists;
 
+    // Maximum number of lines to track, 0 for no limit
+    const uint64_t maxTrackedLines;
+
   protected:
+    /**
+     * Decide if a line is tracked. Lines are sampled by a hash of
+     * their address (SHARDS), tracking the ones whose hash has at
+     * least samplingShift trailing zero bits, i.e. 1 in
+     * 2^samplingShift lines. Raising the shift keeps a subset of the
+     * lines tracked before.
+     *
+     * @param line_addr Address of the line
+     * @param level Set to the number of trailing zero bits of the hash
+     * @return True if the line is sampled
+     */
+    bool isSampled(Addr line_addr, unsigned &level) const;
+
+    /**
+     * Halve the sampling rate, removing the lines no longer sampled
+     * from the stack, until the tracked lines fit the budget.
+     */
+    void enforceBudget();
+
     StackDistCalc calc;
 
+    // Log2 of the ratio of lines to sampled lines
+    unsigned samplingShift;
+
+    // Sampled lines in the stack, by trailing zero bits of their hash
+    std::vector<std::vector<Addr>> trackedLines;
+
+    // Number of lines in trackedLines
+    uint64_t numTrackedLines;
+
     struct StackDistProbeStats : public statistics::Group
     {
         StackDistProbeStats(StackDistProbe* parent);
@@ -87,6 +120,9 @@ class StackDistProbe : public BaseMemProbe
 
         // Writes logarithmic histogram
         statistics::Scalar infiniteSD;
+
+        // Times the sampling rate was halved to stay within the budget
+        statistics::Scalar rateReductions;
     } stats;
 };
 
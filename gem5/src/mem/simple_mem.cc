@@ -58,6 +58,9 @@ SimpleMemory::SimpleMemory(const SimpleMemoryParams &p) :
     releaseEvent([this]{ release(); }, name()),
     dequeueEvent([this]{ dequeue(); }, name())
 {
+    // timing accesses through the back door only see the fixed latency
+    if (p.latency_only)
+        backdoor.latencyOnly(latency);
 }
 
 void
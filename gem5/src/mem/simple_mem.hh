@@ -129,7 +129,8 @@ class SimpleMemory : public AbstractMemory
     /**
      * Bandwidth in ticks per byte. The regulation affects the
      * acceptance rate of requests and the queueing takes place after
-     * the regulation.
+     * the regulation. A bandwidth of 0 disables the regulation, leaving
+     * only the latency.
      */
     const double bandwidth;
 
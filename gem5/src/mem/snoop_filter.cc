@@ -42,6 +42,7 @@
 
 #include "mem/snoop_filter.hh"
 
+#include "base/intmath.hh"
 #include "base/logging.hh"
 #include "base/trace.hh"
 #include "debug/SnoopFilter.hh"
@@ -52,18 +53,125 @@ namespace gem5
 
 const int SnoopFilter::SNOOP_MASK_SIZE;
 
-void
-SnoopFilter::eraseIfNullEntry(SnoopFilterCache::iterator& sf_it)
+SnoopFilter::SnoopFilter(const SnoopFilterParams &p)
+    : SimObject(p), numSets(p.sets), numWays(p.ways), useCount(0),
+      backInvPending(false), linesize(p.system->cacheLineSize()),
+      lookupLatency(p.lookup_latency), lineShift(floorLog2(linesize)),
+      maxEntryCount(p.max_capacity / p.system->cacheLineSize()),
+      _requestorId(p.sets ? p.system->getRequestorId(this) :
+                   Request::invldRequestorId),
+      stats(this)
+{
+    if (isBounded()) {
+        fatal_if(!isPowerOf2(numSets),
+                 "%s: number of sets (%d) must be a power of 2\n",
+                 name(), numSets);
+        fatal_if(numWays == 0, "%s: a bounded filter needs ways\n", name());
+        entries.resize(numSets * numWays);
+    }
+}
+
+SnoopFilter::SnoopItem *
+SnoopFilter::findEntry(Addr line_addr)
+{
+    if (isBounded()) {
+        DirEntry *set = getSet(line_addr);
+        for (unsigned way = 0; way < numWays; ++way) {
+            if (set[way].valid && set[way].lineAddr == line_addr) {
+                set[way].lastUse = ++useCount;
+                return &set[way].item;
+            }
+        }
+        // the line can only be in the overflow map if it is non-empty,
+        // so avoid hashing in the common case
+        if (cachedLocations.empty())
+            return nullptr;
+    }
+
+    auto sf_it = cachedLocations.find(line_addr);
+    return sf_it == cachedLocations.end() ? nullptr : &sf_it->second;
+}
+
+SnoopFilter::SnoopItem *
+SnoopFilter::allocateEntry(Addr line_addr)
 {
-    SnoopItem& sf_item = sf_it->second;
-    if ((sf_item.requested | sf_item.holder).none()) {
-        cachedLocations.erase(sf_it);
-        DPRINTF(SnoopFilter, "%s:   Removed SF entry.\n",
+    if (!isBounded())
+        return &cachedLocations.emplace(line_addr, SnoopItem()).first->second;
+
+    // pick an invalid way if there is one, and otherwise the least
+    // recently used line that has no requests in flight, as the
+    // requestors of those would not see their responses tracked
+    DirEntry *set = getSet(line_addr);
+    DirEntry *victim = nullptr;
+    for (unsigned way = 0; way < numWays; ++way) {
+        DirEntry &entry = set[way];
+        if (!entry.valid) {
+            victim = &entry;
+            break;
+        }
+        if (entry.item.requested.none() &&
+            (!victim || entry.lastUse < victim->lastUse)) {
+            victim = &entry;
+        }
+    }
+
+    if (!victim) {
+        DPRINTF(SnoopFilter, "%s:   set full of requests, overflowing\n",
                 __func__);
+        stats.overflows++;
+        return &cachedLocations.emplace(line_addr, SnoopItem()).first->second;
+    }
+
+    if (victim->valid) {
+        DPRINTF(SnoopFilter, "%s:   evicting %#x SF value %x.%x\n",
+                __func__, victim->lineAddr, victim->item.requested,
+                victim->item.holder);
+        reqLookupResult.victimSlot = victim;
+        reqLookupResult.victim = *victim;
+    }
+
+    victim->lineAddr = line_addr;
+    victim->valid = true;
+    victim->item = SnoopItem();
+    victim->lastUse = ++useCount;
+    return &victim->item;
+}
+
+void
+SnoopFilter::eraseIfNullEntry(Addr line_addr, SnoopItem *sf_item)
+{
+    if ((sf_item->requested | sf_item->holder).any())
+        return;
+
+    bool in_set = false;
+    if (isBounded()) {
+        DirEntry *set = getSet(line_addr);
+        for (unsigned way = 0; way < numWays && !in_set; ++way) {
+            if (&set[way].item == sf_item) {
+                set[way].valid = false;
+                in_set = true;
+            }
+        }
     }
+    if (!in_set)
+        cachedLocations.erase(line_addr);
+
+    DPRINTF(SnoopFilter, "%s:   Removed SF entry.\n",
+            __func__);
 }
 
-std::pair<SnoopFilter::SnoopList, Cycles>
+bool
+SnoopFilter::takeBackInvalidation(BackInvalidation &inv)
+{
+    if (!backInvPending)
+        return false;
+
+    inv = pendingBackInv;
+    backInvPending = false;
+    return true;
+}
+
+std::pair<SnoopFilter::SnoopMask, Cycles>
 SnoopFilter::lookupRequest(const Packet* cpkt, const ResponsePort&
                            cpu_side_port)
 {
@@ -78,8 +186,10 @@ SnoopFilter::lookupRequest(const Packet* cpkt, const ResponsePort&
         line_addr |= LineSecure;
     }
     SnoopMask req_port = portToMask(cpu_side_port);
-    reqLookupResult.it = cachedLocations.find(line_addr);
-    bool is_hit = (reqLookupResult.it != cachedLocations.end());
+    reqLookupResult.lineAddr = line_addr;
+    reqLookupResult.item = findEntry(line_addr);
+    reqLookupResult.victimSlot = nullptr;
+    bool is_hit = (reqLookupResult.item != nullptr);
 
     // If the snoop filter has no entry, and we should not allocate,
     // do not create a new snoop filter entry, simply return a NULL
@@ -88,11 +198,9 @@ SnoopFilter::lookupRequest(const Packet* cpkt, const ResponsePort&
         return snoopDown(lookupLatency);
 
     // If no hit in snoop filter create a new element and update iterator
-    if (!is_hit) {
-        reqLookupResult.it =
-            cachedLocations.emplace(line_addr, SnoopItem()).first;
-    }
-    SnoopItem& sf_item = reqLookupResult.it->second;
+    if (!is_hit)
+        reqLookupResult.item = allocateEntry(line_addr);
+    SnoopItem& sf_item = *reqLookupResult.item;
     SnoopMask interested = sf_item.holder | sf_item.requested;
 
     // Store unmodified value of snoop filter item in temp storage in
@@ -113,8 +221,7 @@ SnoopFilter::lookupRequest(const Packet* cpkt, const ResponsePort&
 
     // If we are not allocating, we are done
     if (!allocate)
-        return snoopSelected(maskToPortList(interested & ~req_port),
-                             lookupLatency);
+        return snoopSelected(interested & ~req_port, lookupLatency);
 
     if (cpkt->needsResponse()) {
         if (!cpkt->cacheResponding()) {
@@ -153,16 +260,16 @@ SnoopFilter::lookupRequest(const Packet* cpkt, const ResponsePort&
         }
     }
 
-    return snoopSelected(maskToPortList(interested & ~req_port), lookupLatency);
+    return snoopSelected(interested & ~req_port, lookupLatency);
 }
 
 void
 SnoopFilter::finishRequest(bool will_retry, Addr addr, bool is_secure)
 {
-    if (reqLookupResult.it != cachedLocations.end()) {
+    if (reqLookupResult.item) {
         // since we rely on the caller, do a basic check to ensure
         // that finishRequest is being called following lookupRequest
-        assert(reqLookupResult.it->first == \
+        assert(reqLookupResult.lineAddr == \
                 (is_secure ? ((addr & ~(Addr(linesize - 1))) | LineSecure) : \
                  (addr & ~(Addr(linesize - 1)))));
         if (will_retry) {
@@ -170,17 +277,40 @@ SnoopFilter::finishRequest(bool will_retry, Addr addr, bool is_secure)
             // Undo any changes made in lookupRequest to the snoop filter
             // entry if the request will come again. retryItem holds
             // the previous value of the snoopfilter entry.
-            reqLookupResult.it->second = retry_item;
+            *reqLookupResult.item = retry_item;
 
             DPRINTF(SnoopFilter, "%s:   restored SF value %x.%x\n",
                     __func__,  retry_item.requested, retry_item.holder);
         }
 
-        eraseIfNullEntry(reqLookupResult.it);
+        eraseIfNullEntry(reqLookupResult.lineAddr, reqLookupResult.item);
+        reqLookupResult.item = nullptr;
+    }
+
+    if (DirEntry *slot = reqLookupResult.victimSlot) {
+        if (will_retry) {
+            // the new line did not get allocated after all, so put
+            // the line it evicted back in place
+            assert(!slot->valid);
+            *slot = reqLookupResult.victim;
+        } else {
+            const DirEntry &victim = reqLookupResult.victim;
+            assert(!backInvPending);
+            if (victim.item.holder.any()) {
+                pendingBackInv.addr = victim.lineAddr & ~Addr(LineSecure);
+                pendingBackInv.isSecure = victim.lineAddr & LineSecure;
+                pendingBackInv.holders = victim.item.holder;
+                backInvPending = true;
+
+                stats.backInvalidations++;
+                stats.backInvalidatedHolders += victim.item.holder.count();
+            }
+        }
+        reqLookupResult.victimSlot = nullptr;
     }
 }
 
-std::pair<SnoopFilter::SnoopList, Cycles>
+std::pair<SnoopFilter::SnoopMask, Cycles>
 SnoopFilter::lookupSnoop(const Packet* cpkt)
 {
     DPRINTF(SnoopFilter, "%s: packet %s\n", __func__, cpkt->print());
@@ -191,10 +321,12 @@ SnoopFilter::lookupSnoop(const Packet* cpkt)
     if (cpkt->isSecure()) {
         line_addr |= LineSecure;
     }
-    auto sf_it = cachedLocations.find(line_addr);
-    bool is_hit = (sf_it != cachedLocations.end());
+    SnoopItem *sf_item_ptr = findEntry(line_addr);
+    bool is_hit = (sf_item_ptr != nullptr);
 
-    panic_if(!is_hit && (cachedLocations.size() >= maxEntryCount),
+    // a bounded filter evicts lines instead of growing
+    panic_if(!is_hit && !isBounded() &&
+             (cachedLocations.size() >= maxEntryCount),
              "snoop filter exceeded capacity of %d cache blocks\n",
              maxEntryCount);
 
@@ -204,7 +336,7 @@ SnoopFilter::lookupSnoop(const Packet* cpkt)
     if (!is_hit)
         return snoopDown(lookupLatency);
 
-    SnoopItem& sf_item = sf_it->second;
+    SnoopItem& sf_item = *sf_item_ptr;
 
     SnoopMask interested = (sf_item.holder | sf_item.requested);
 
@@ -234,10 +366,10 @@ SnoopFilter::lookupSnoop(const Packet* cpkt)
         sf_item.holder = 0;
         DPRINTF(SnoopFilter, "%s:   new SF value %x.%x\n",
                 __func__, sf_item.requested, sf_item.holder);
-        eraseIfNullEntry(sf_it);
+        eraseIfNullEntry(line_addr, sf_item_ptr);
     }
 
-    return snoopSelected(maskToPortList(interested), lookupLatency);
+    return snoopSelected(interested, lookupLatency);
 }
 
 void
@@ -264,7 +396,10 @@ SnoopFilter::updateSnoopResponse(const Packet* cpkt,
     }
     SnoopMask rsp_mask = portToMask(rsp_port);
     SnoopMask req_mask = portToMask(req_port);
-    SnoopItem& sf_item = cachedLocations[line_addr];
+    SnoopItem *sf_item_ptr = findEntry(line_addr);
+    panic_if(!sf_item_ptr, "No SF entry for snoop response %s\n",
+             cpkt->print());
+    SnoopItem& sf_item = *sf_item_ptr;
 
     DPRINTF(SnoopFilter, "%s:   old SF value %x.%x\n",
             __func__,  sf_item.requested, sf_item.holder);
@@ -311,18 +446,17 @@ SnoopFilter::updateSnoopForward(const Packet* cpkt,
     if (cpkt->isSecure()) {
         line_addr |= LineSecure;
     }
-    auto sf_it = cachedLocations.find(line_addr);
-    bool is_hit = sf_it != cachedLocations.end();
+    SnoopItem *sf_item_ptr = findEntry(line_addr);
 
     // Nothing to do if it is not a hit
-    if (!is_hit)
+    if (!sf_item_ptr)
         return;
 
     // If the snoop response has no sharers the line is passed in
     // Modified state, and we know that there are no other copies, or
     // they will all be invalidated imminently
     if (!cpkt->hasSharers()) {
-        SnoopItem& sf_item = sf_it->second;
+        SnoopItem& sf_item = *sf_item_ptr;
 
         DPRINTF(SnoopFilter, "%s:   old SF value %x.%x\n",
                 __func__, sf_item.requested, sf_item.holder);
@@ -330,7 +464,7 @@ SnoopFilter::updateSnoopForward(const Packet* cpkt,
         DPRINTF(SnoopFilter, "%s:   new SF value %x.%x\n",
                 __func__, sf_item.requested, sf_item.holder);
 
-        eraseIfNullEntry(sf_it);
+        eraseIfNullEntry(line_addr, sf_item_ptr);
     }
 }
 
@@ -353,12 +487,12 @@ SnoopFilter::updateResponse(const Packet* cpkt, const ResponsePort&
     if (cpkt->isSecure()) {
         line_addr |= LineSecure;
     }
-    auto sf_it = cachedLocations.find(line_addr);
-    if (sf_it == cachedLocations.end())
+    SnoopItem *sf_item_ptr = findEntry(line_addr);
+    if (!sf_item_ptr)
         return;
 
     SnoopMask response_mask = portToMask(cpu_side_port);
-    SnoopItem& sf_item = sf_it->second;
+    SnoopItem& sf_item = *sf_item_ptr;
 
     DPRINTF(SnoopFilter, "%s:   old SF value %x.%x\n",
             __func__,  sf_item.requested, sf_item.holder);
@@ -377,7 +511,7 @@ SnoopFilter::updateResponse(const Packet* cpkt, const ResponsePort&
         if (cpkt->isInvalidate()) {
             sf_item.holder &= ~response_mask;
         }
-        eraseIfNullEntry(sf_it);
+        eraseIfNullEntry(line_addr, sf_item_ptr);
     } else {
         // Any other response implies that a cache above will have the
         // block.
@@ -405,7 +539,15 @@ SnoopFilter::SnoopFilterStats::SnoopFilterStats(statistics::Group *parent)
                "holder of the requested data."),
       ADD_STAT(hitMultiSnoops, statistics::units::Count::get(),
                "Number of snoops hitting in the snoop filter with multiple "
-               "(>1) holders of the requested data.")
+               "(>1) holders of the requested data."),
+      ADD_STAT(backInvalidations, statistics::units::Count::get(),
+               "Number of lines evicted from a bounded snoop filter, "
+               "invalidating their holders."),
+      ADD_STAT(backInvalidatedHolders, statistics::units::Count::get(),
+               "Number of holders snooped to invalidate evicted lines."),
+      ADD_STAT(overflows, statistics::units::Count::get(),
+               "Number of lines tracked outside their set in a bounded "
+               "snoop filter as every way had requests in flight.")
 {}
 
 void
@@ -46,6 +46,7 @@
 #include <bitset>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "mem/packet.hh"
 #include "mem/port.hh"
@@ -85,6 +86,13 @@ namespace gem5
  *     upper cache dropped a line, making the snoop filter pessimistic for now
  * (4) ordering: there is no single point of order in the system.  Instead,
  *     requesting MSHRs track order between local requests and remote snoops
+ *
+ * By default the filter tracks any number of lines. It can also be
+ * organised as a bounded, set-associative directory, in which case
+ * allocating an entry in a full set evicts the least recently used
+ * entry without in-flight requests. The holders of an evicted line
+ * must then be back-invalidated by the crossbar to keep the filter
+ * inclusive of the caches above it (see takeBackInvalidation).
  */
 class SnoopFilter : public SimObject
 {
@@ -95,13 +103,15 @@ class SnoopFilter : public SimObject
 
     typedef std::vector<QueuedResponsePort*> SnoopList;
 
-    SnoopFilter (const SnoopFilterParams &p) :
-        SimObject(p), reqLookupResult(cachedLocations.end()),
-        linesize(p.system->cacheLineSize()), lookupLatency(p.lookup_latency),
-        maxEntryCount(p.max_capacity / p.system->cacheLineSize()),
-        stats(this)
-    {
-    }
+    /**
+     * The underlying type for the bitmask we use for tracking. This
+     * limits the number of snooping ports supported per crossbar. Bit
+     * i of a mask corresponds to the i-th snooping port in the list
+     * passed to setCPUSidePorts.
+     */
+    typedef std::bitset<SNOOP_MASK_SIZE> SnoopMask;
+
+    SnoopFilter (const SnoopFilterParams &p);
 
     /**
      * Init a new snoop filter and tell it about all the cpu_sideports
@@ -137,9 +147,9 @@ class SnoopFilter : public SimObject
      *
      * @param cpkt              Pointer to the request packet. Not changed.
      * @param cpu_side_port     Response port where the request came from.
-     * @return Pair of a vector of snoop target ports and lookup latency.
+     * @return Pair of a mask of snoop target ports and lookup latency.
      */
-    std::pair<SnoopList, Cycles> lookupRequest(const Packet* cpkt,
+    std::pair<SnoopMask, Cycles> lookupRequest(const Packet* cpkt,
                                         const ResponsePort& cpu_side_port);
 
     /**
@@ -159,10 +169,10 @@ class SnoopFilter : public SimObject
      * additional steering thanks to the snoop filter.
      *
      * @param cpkt Pointer to const Packet containing the snoop.
-     * @return Pair with a vector of ResponsePorts that need snooping and a
+     * @return Pair with a mask of ResponsePorts that need snooping and a
      * lookup latency.
      */
-    std::pair<SnoopList, Cycles> lookupSnoop(const Packet* cpkt);
+    std::pair<SnoopMask, Cycles> lookupSnoop(const Packet* cpkt);
 
     /**
      * Let the snoop filter see any snoop responses that turn into
@@ -200,15 +210,37 @@ class SnoopFilter : public SimObject
      */
     void updateResponse(const Packet *cpkt, const ResponsePort& cpu_side_port);
 
-    virtual void regStats();
-
-  protected:
+    /**
+     * A line evicted from a bounded filter, along with the ports
+     * holding it that need to be invalidated.
+     */
+    struct BackInvalidation
+    {
+        Addr addr;
+        bool isSecure;
+        SnoopMask holders;
+    };
 
     /**
-     * The underlying type for the bitmask we use for tracking. This
-     * limits the number of snooping ports supported per crossbar.
+     * Get the back-invalidation caused by the last successful
+     * request, if any. The crossbar must call this following
+     * finishRequest and snoop the holders before any other request
+     * reaches the filter.
+     *
+     * @param inv Back-invalidation to fill in
+     * @return True if a line was evicted and inv is valid
      */
-    typedef std::bitset<SNOOP_MASK_SIZE> SnoopMask;
+    bool takeBackInvalidation(BackInvalidation &inv);
+
+    /** Is this a bounded, set-associative filter? */
+    bool isBounded() const { return numSets != 0; }
+
+    /** Requestor id used for the back-invalidation snoops. */
+    RequestorID requestorId() const { return _requestorId; }
+
+    virtual void regStats();
+
+  protected:
 
     /**
     * Per cache line item tracking a bitmask of ResponsePorts who have an
@@ -228,19 +260,21 @@ class SnoopFilter : public SimObject
     /**
      * Simple factory methods for standard return values.
      */
-    std::pair<SnoopList, Cycles> snoopAll(Cycles latency) const
+    std::pair<SnoopMask, Cycles> snoopAll(Cycles latency) const
     {
-        return std::make_pair(cpuSidePorts, latency);
+        SnoopMask all;
+        for (size_t i = 0; i < cpuSidePorts.size(); ++i)
+            all.set(i);
+        return std::make_pair(all, latency);
     }
-    std::pair<SnoopList, Cycles> snoopSelected(const SnoopList&
+    std::pair<SnoopMask, Cycles> snoopSelected(const SnoopMask&
                                 _cpu_side_ports, Cycles latency) const
     {
         return std::make_pair(_cpu_side_ports, latency);
     }
-    std::pair<SnoopList, Cycles> snoopDown(Cycles latency) const
+    std::pair<SnoopMask, Cycles> snoopDown(Cycles latency) const
     {
-        SnoopList empty;
-        return std::make_pair(empty , latency);
+        return std::make_pair(SnoopMask(), latency);
     }
 
     /**
@@ -249,23 +283,71 @@ class SnoopFilter : public SimObject
      * @return One-hot bitmask corresponding to the port.
      */
     SnoopMask portToMask(const ResponsePort& port) const;
+
+  private:
+
+    /** An entry of a bounded filter. */
+    struct DirEntry
+    {
+        Addr lineAddr = 0;
+        bool valid = false;
+        SnoopItem item;
+        /** Value of useCount at the last access, for replacement. */
+        uint64_t lastUse = 0;
+    };
+
     /**
-     * Converts a bitmask of ports into the corresponing list of ports
-     * @param ports SnoopMask of the requested ports
-     * @return SnoopList containing all the requested ResponsePorts
+     * Find the entry of a line.
+     *
+     * @param line_addr Line address, including the LineSecure bit
+     * @return The entry of the line, or nullptr if not tracked
      */
-    SnoopList maskToPortList(SnoopMask ports) const;
+    SnoopItem *findEntry(Addr line_addr);
 
-  private:
+    /**
+     * Allocate an empty entry for a line that is not tracked. In a
+     * bounded filter this may evict another line, which is recorded
+     * in reqLookupResult so that finishRequest can undo it.
+     *
+     * @param line_addr Line address, including the LineSecure bit
+     * @return The new entry
+     */
+    SnoopItem *allocateEntry(Addr line_addr);
 
     /**
      * Removes snoop filter items which have no requestors and no holders.
      */
-    void eraseIfNullEntry(SnoopFilterCache::iterator& sf_it);
+    void eraseIfNullEntry(Addr line_addr, SnoopItem *sf_item);
+
+    /**
+     * Get the ways of the set a line maps to in a bounded filter.
+     */
+    DirEntry *
+    getSet(Addr line_addr)
+    {
+        return &entries[((line_addr >> lineShift) & (numSets - 1)) *
+                        numWays];
+    }
 
-    /** Simple hash set of cached addresses. */
+    /**
+     * Hash set of cached addresses. In a bounded filter this only
+     * holds the lines that did not fit in their set because every
+     * way had requests in flight.
+     */
     SnoopFilterCache cachedLocations;
 
+    /** Entries of a bounded filter, numWays per set. */
+    std::vector<DirEntry> entries;
+
+    /** Number of sets of a bounded filter, 0 when unbounded. */
+    const unsigned numSets;
+
+    /** Number of ways per set of a bounded filter. */
+    const unsigned numWays;
+
+    /** Access counter providing the LRU order of the entries. */
+    uint64_t useCount;
+
     /**
      * A request lookup must be followed by a call to finishRequest to inform
      * the operation's success. If a retry is needed, however, all changes
@@ -274,29 +356,32 @@ class SnoopFilter : public SimObject
      */
     struct ReqLookupResult
     {
-        /** Iterator used to store the result from lookupRequest. */
-        SnoopFilterCache::iterator it;
+        /** Line address of the entry found by lookupRequest. */
+        Addr lineAddr = 0;
+
+        /** Entry found by lookupRequest, nullptr if none. */
+        SnoopItem *item = nullptr;
 
         /**
          * Variable to temporarily store value of snoopfilter entry
          * in case finishRequest needs to undo changes made in lookupRequest
          * (because of crossbar retry)
          */
-        SnoopItem retryItem;
+        SnoopItem retryItem{0, 0};
 
-        /**
-         * The constructor must be informed of the internal cache's end
-         * iterator, so do not allow the compiler to implictly define it.
-         *
-         * @param end_it Iterator to the end of the internal cache.
-         */
-        ReqLookupResult(SnoopFilterCache::iterator end_it)
-            : it(end_it), retryItem{0, 0}
-        {
-        }
-        ReqLookupResult() = delete;
+        /** Entry evicted to make room for the new one, if any. */
+        DirEntry *victimSlot = nullptr;
+
+        /** Previous contents of victimSlot. */
+        DirEntry victim;
     } reqLookupResult;
 
+    /** Line evicted by the last successful request, if any. */
+    BackInvalidation pendingBackInv;
+
+    /** Is pendingBackInv waiting to be taken by the crossbar? */
+    bool backInvPending;
+
     /** List of all attached snooping CPU-side ports. */
     SnoopList cpuSidePorts;
     /** Track the mapping from port ids to the local mask ids. */
@@ -305,8 +390,12 @@ class SnoopFilter : public SimObject
     const Addr linesize;
     /** Latency for doing a lookup in the filter */
     const Cycles lookupLatency;
+    /** Log2 of the cache line size, for indexing the sets. */
+    const int lineShift;
     /** Max capacity in terms of cache blocks tracked, for sanity checking */
     const unsigned maxEntryCount;
+    /** Requestor id of the back-invalidation snoops. */
+    const RequestorID _requestorId;
 
     /**
      * Use the lower bits of the address to keep track of the line status
@@ -329,6 +418,10 @@ class SnoopFilter : public SimObject
         statistics::Scalar totSnoops;
         statistics::Scalar hitSingleSnoops;
         statistics::Scalar hitMultiSnoops;
+
+        statistics::Scalar backInvalidations;
+        statistics::Scalar backInvalidatedHolders;
+        statistics::Scalar overflows;
     } stats;
 };
 
@@ -341,16 +434,6 @@ SnoopFilter::portToMask(const ResponsePort& port) const
         ((SnoopMask)1) << localResponsePortIds[port.getId()];
 }
 
-inline SnoopFilter::SnoopList
-SnoopFilter::maskToPortList(SnoopMask port_mask) const
-{
-    SnoopList res;
-    for (const auto& p : cpuSidePorts)
-        if ((port_mask & portToMask(*p)).any())
-            res.push_back(p);
-    return res;
-}
-
 } // namespace gem5
 
 #endif // __MEM_SNOOP_FILTER_HH__
@@ -27,6 +27,7 @@
 
 #include "mem/thread_bridge.hh"
 
+#include "base/logging.hh"
 #include "base/trace.hh"
 #include "sim/eventq.hh"
 
@@ -34,13 +35,48 @@ namespace gem5
 {
 
 ThreadBridge::ThreadBridge(const ThreadBridgeParams &p)
-    : SimObject(p), in_port_("in_port", *this), out_port_("out_port", *this)
+    : SimObject(p), delay_(p.delay), req_size_(p.req_size),
+      resp_size_(p.resp_size), out_port_("out_port", *this),
+      send_event_([this]{ trySendReq(); }, name() + ".send_event", false,
+                  Send_Pri),
+      retry_event_([this]
+                   {
+                       retry_resp_ = false;
+                       out_port_.sendRetryResp();
+                   }, name() + ".retry_event", false, Retry_Pri)
 {
+    fatal_if(!req_size_ || !resp_size_,
+             "%s: the request and response queues need room for at "
+             "least one packet.", name());
+
+    for (unsigned i = 0; i < p.port_in_port_connection_count; ++i) {
+        in_ports_.emplace_back(new IncomingPort(
+            csprintf("%s.in_port[%d]", name(), i), *this, i));
+    }
+}
+
+void
+ThreadBridge::init()
+{
+    SimObject::init();
+
+    fatal_if(numMainEventQueues > 1 && delay_ < simQuantum,
+             "%s: delay (%d) must be at least the simulation quantum "
+             "(%d) for timing packets to cross event queues.",
+             name(), delay_, simQuantum);
 }
 
 ThreadBridge::IncomingPort::IncomingPort(const std::string &name,
-                                         ThreadBridge &device)
-    : ResponsePort(name), device_(device)
+                                         ThreadBridge &device, PortID id)
+    : ResponsePort(name, id), resp_credits_(device.resp_size_),
+      device_(device), req_credits_(device.req_size_),
+      retry_event_([this]
+                   {
+                       retry_req_ = false;
+                       sendRetryReq();
+                   }, name + ".retry_event", false, Retry_Pri),
+      send_event_([this]{ trySendResp(); }, name + ".send_event", false,
+                  Send_Pri)
 {
 }
 
@@ -54,12 +90,69 @@ ThreadBridge::IncomingPort::getAddrRanges() const
 bool
 ThreadBridge::IncomingPort::recvTimingReq(PacketPtr pkt)
 {
-    panic("ThreadBridge only supports atomic/functional access.");
+    // The bridge's queue cannot be asked synchronously whether it has
+    // room, so only accept as many requests as there are credits left.
+    queue_ = curEventQueue();
+    if (!req_credits_) {
+        retry_req_ = true;
+        return false;
+    }
+    --req_credits_;
+    if (pkt->needsResponse())
+        pkt->pushSenderState(new PortSenderState(id));
+
+    const Tick when = curTick() + device_.delay_;
+    const PortID port = id;
+    const uint64_t seq = req_seq_++;
+    ThreadBridge &device = device_;
+    device.eventQueue()->schedule(new EventFunctionWrapper(
+        [&device, when, port, seq, pkt]
+        {
+            device.deliverReq(when, port, seq, pkt);
+        }, name() + ".deliver_event", true, Delivery_Pri), when);
+    return true;
 }
+
 void
 ThreadBridge::IncomingPort::recvRespRetry()
 {
-    panic("ThreadBridge only supports atomic/functional access.");
+    waiting_for_retry_ = false;
+    trySendResp();
+}
+
+void
+ThreadBridge::IncomingPort::deliverResp(uint64_t seq, PacketPtr pkt)
+{
+    resp_queue_.emplace(seq, pkt);
+    if (!waiting_for_retry_ && !send_event_.scheduled())
+        queue_->schedule(&send_event_, curTick());
+}
+
+void
+ThreadBridge::IncomingPort::trySendResp()
+{
+    while (!resp_queue_.empty()) {
+        if (!sendTimingResp(resp_queue_.begin()->second)) {
+            waiting_for_retry_ = true;
+            return;
+        }
+        resp_queue_.erase(resp_queue_.begin());
+
+        ThreadBridge &device = device_;
+        const PortID port = id;
+        device.eventQueue()->schedule(new EventFunctionWrapper(
+            [&device, port]{ device.returnRespCredit(port); },
+            name() + ".credit_event", true, Delivery_Pri),
+            curTick() + device.delay_);
+    }
+}
+
+void
+ThreadBridge::IncomingPort::returnReqCredit()
+{
+    ++req_credits_;
+    if (retry_req_ && !retry_event_.scheduled())
+        queue_->schedule(&retry_event_, curTick());
 }
 
 // AtomicResponseProtocol
@@ -87,26 +180,82 @@ ThreadBridge::OutgoingPort::OutgoingPort(const std::string &name,
 void
 ThreadBridge::OutgoingPort::recvRangeChange()
 {
-    device_.in_port_.sendRangeChange();
+    for (auto &port : device_.in_ports_)
+        port->sendRangeChange();
 }
 
 // TimingRequestProtocol
 bool
 ThreadBridge::OutgoingPort::recvTimingResp(PacketPtr pkt)
 {
-    panic("ThreadBridge only supports atomic/functional access.");
+    auto *state = dynamic_cast<PortSenderState *>(pkt->senderState);
+    panic_if(!state, "%s: response without a matching request.", name());
+    IncomingPort &port = *device_.in_ports_[state->port];
+    if (!port.resp_credits_) {
+        device_.retry_resp_ = true;
+        return false;
+    }
+    --port.resp_credits_;
+    delete pkt->popSenderState();
+
+    const uint64_t seq = port.resp_seq_++;
+    port.requestorQueue()->schedule(new EventFunctionWrapper(
+        [&port, seq, pkt]
+        {
+            port.deliverResp(seq, pkt);
+        }, name() + ".deliver_event", true, Delivery_Pri),
+        curTick() + device_.delay_);
+    return true;
 }
+
 void
 ThreadBridge::OutgoingPort::recvReqRetry()
 {
-    panic("ThreadBridge only supports atomic/functional access.");
+    device_.waiting_for_retry_ = false;
+    device_.trySendReq();
+}
+
+void
+ThreadBridge::deliverReq(Tick when, PortID port, uint64_t seq,
+                         PacketPtr pkt)
+{
+    req_queue_.emplace(std::make_tuple(when, port, seq), pkt);
+    if (!waiting_for_retry_ && !send_event_.scheduled())
+        schedule(send_event_, curTick());
+}
+
+void
+ThreadBridge::trySendReq()
+{
+    while (!req_queue_.empty()) {
+        if (!out_port_.sendTimingReq(req_queue_.begin()->second)) {
+            waiting_for_retry_ = true;
+            return;
+        }
+        IncomingPort &port =
+            *in_ports_[std::get<1>(req_queue_.begin()->first)];
+        req_queue_.erase(req_queue_.begin());
+
+        port.requestorQueue()->schedule(new EventFunctionWrapper(
+            [&port]{ port.returnReqCredit(); },
+            name() + ".credit_event", true, Delivery_Pri),
+            curTick() + delay_);
+    }
+}
+
+void
+ThreadBridge::returnRespCredit(PortID port)
+{
+    ++in_ports_[port]->resp_credits_;
+    if (retry_resp_ && !retry_event_.scheduled())
+        schedule(retry_event_, curTick());
 }
 
 Port &
 ThreadBridge::getPort(const std::string &if_name, PortID idx)
 {
-    if (if_name == "in_port")
-        return in_port_;
+    if (if_name == "in_port" && idx >= 0 && idx < (PortID)in_ports_.size())
+        return *in_ports_[idx];
     if (if_name == "out_port")
         return out_port_;
     return SimObject::getPort(if_name, idx);
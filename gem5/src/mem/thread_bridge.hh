@@ -28,8 +28,16 @@
 #ifndef __MEM_THREAD_BRIDGE_HH__
 #define __MEM_THREAD_BRIDGE_HH__
 
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <tuple>
+#include <vector>
+
+#include "mem/packet.hh"
 #include "mem/port.hh"
 #include "params/ThreadBridge.hh"
+#include "sim/eventq.hh"
 #include "sim/sim_object.hh"
 
 namespace gem5
@@ -40,16 +48,63 @@ class ThreadBridge : public SimObject
   public:
     explicit ThreadBridge(const ThreadBridgeParams &p);
 
+    void init() override;
+
     Port &getPort(const std::string &if_name,
                   PortID idx = InvalidPortID) override;
 
   private:
+    /**
+     * Timing packets are handed from one event queue to the other by
+     * one event per packet, which runs at this priority and only
+     * buffers the packet. The buffered packets are sent by an event
+     * local to the receiving queue at Send_Pri, in an order that does
+     * not depend on the order the hand-over events were inserted in.
+     *
+     * Each incoming port may have at most req_size requests and
+     * resp_size responses in the bridge. The space is tracked with
+     * credits that are handed back across the queues the same way as
+     * packets, and a refused sender is sent a retry at Retry_Pri once
+     * the credits it waits for are back.
+     */
+    static const Event::Priority Delivery_Pri =
+        Event::Delayed_Writeback_Pri - 3;
+    static const Event::Priority Send_Pri = Delivery_Pri + 1;
+    static const Event::Priority Retry_Pri = Send_Pri + 1;
+
+    /** Remembers which incoming port a request arrived on. */
+    struct PortSenderState : public Packet::SenderState
+    {
+        PortSenderState(PortID _port) : port(_port) {}
+        const PortID port;
+    };
+
     class IncomingPort : public ResponsePort
     {
       public:
-        IncomingPort(const std::string &name, ThreadBridge &device);
+        IncomingPort(const std::string &name, ThreadBridge &device,
+                     PortID id);
         AddrRangeList getAddrRanges() const override;
 
+        /** Buffer a response handed over from the bridge's queue. */
+        void deliverResp(uint64_t seq, PacketPtr pkt);
+
+        /** Send the buffered responses in order until refused. */
+        void trySendResp();
+
+        /** A request of this port has left the bridge. */
+        void returnReqCredit();
+
+        /** Queue of the requestor, known once it sends in timing. */
+        EventQueue *requestorQueue() const { return queue_; }
+
+        //! Response sequence number, only used by the bridge's queue.
+        uint64_t resp_seq_ = 0;
+
+        //! Responses this port can still be sent, only used by the
+        //! bridge's queue.
+        unsigned resp_credits_;
+
         // TimingResponseProtocol
         bool recvTimingReq(PacketPtr pkt) override;
         void recvRespRetry() override;
@@ -62,6 +117,21 @@ class ThreadBridge : public SimObject
 
       private:
         ThreadBridge &device_;
+        EventQueue *queue_ = nullptr;
+
+        //! Request sequence number, only used by the requestor's queue.
+        uint64_t req_seq_ = 0;
+
+        //! Requests this port can still accept, only used by the
+        //! requestor's queue.
+        unsigned req_credits_;
+        bool retry_req_ = false;
+        EventFunctionWrapper retry_event_;
+
+        //! Responses handed over and not sent yet, by sequence number.
+        std::map<uint64_t, PacketPtr> resp_queue_;
+        bool waiting_for_retry_ = false;
+        EventFunctionWrapper send_event_;
     };
 
     class OutgoingPort : public RequestPort
@@ -78,8 +148,34 @@ class ThreadBridge : public SimObject
         ThreadBridge &device_;
     };
 
-    IncomingPort in_port_;
+    /** Buffer a request handed over from a requestor's queue. */
+    void deliverReq(Tick when, PortID port, uint64_t seq, PacketPtr pkt);
+
+    /** Send the buffered requests in order until refused. */
+    void trySendReq();
+
+    /** A response for the given port has left the bridge. */
+    void returnRespCredit(PortID port);
+
+    /** Time taken by timing packets to cross between event queues. */
+    const Tick delay_;
+
+    /** Requests and responses buffered per incoming port. */
+    const unsigned req_size_;
+    const unsigned resp_size_;
+
+    std::vector<std::unique_ptr<IncomingPort>> in_ports_;
     OutgoingPort out_port_;
+
+    //! Requests handed over and not sent yet, ordered by the tick they
+    //! were handed over at, the incoming port and its sequence number.
+    std::map<std::tuple<Tick, PortID, uint64_t>, PacketPtr> req_queue_;
+    bool waiting_for_retry_ = false;
+    EventFunctionWrapper send_event_;
+
+    //! A response was refused for lack of credits.
+    bool retry_resp_ = false;
+    EventFunctionWrapper retry_event_;
 };
 
 }  // namespace gem5
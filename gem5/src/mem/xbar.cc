@@ -64,6 +64,7 @@ BaseXBar::BaseXBar(const BaseXBarParams &p)
       responseLatency(p.response_latency),
       headerLatency(p.header_latency),
       width(p.width),
+      numRoutes(0),
       gotAddrRanges(p.port_default_connection_count +
                           p.port_mem_side_ports_connection_count, false),
       gotAllAddrRanges(false), defaultPortID(InvalidPortID),
@@ -147,7 +148,8 @@ BaseXBar::Layer<SrcType, DstType>::Layer(DstType& _port, BaseXBar& _xbar,
                                        const std::string& _name) :
     statistics::Group(&_xbar, _name.c_str()),
     port(_port), xbar(_xbar), _name(xbar.name() + "." + _name), state(IDLE),
-    waitingForPeer(NULL), releaseEvent([this]{ releaseLayer(); }, name()),
+    releaseTick(0), waitingForPeer(NULL),
+    releaseEvent([this]{ releaseLayer(); }, name()),
     ADD_STAT(occupancy, statistics::units::Tick::get(), "Layer occupancy (ticks)"),
     ADD_STAT(utilization, statistics::units::Ratio::get(), "Layer utilization")
 {
@@ -172,7 +174,14 @@ void BaseXBar::Layer<SrcType, DstType>::occupyLayer(Tick until)
 
     // until should never be 0 as express snoops never occupy the layer
     assert(until != 0);
-    xbar.schedule(releaseEvent, until);
+    assert(!releaseEvent.scheduled());
+    releaseTick = until;
+
+    // only bother with an event if someone is waiting for the layer
+    // to be released, otherwise it is lazily considered idle again
+    // once we are past the release tick
+    if (!waitingForLayer.empty() || drainState() == DrainState::Draining)
+        xbar.schedule(releaseEvent, until);
 
     // account for the occupied ticks
     occupancy += until - curTick();
@@ -181,6 +190,18 @@ void BaseXBar::Layer<SrcType, DstType>::occupyLayer(Tick until)
             curTick(), until);
 }
 
+template <typename SrcType, typename DstType>
+void
+BaseXBar::Layer<SrcType, DstType>::scheduleRelease()
+{
+    // if the layer has been claimed but not yet occupied, the release
+    // is taken care of when the occupancy is known
+    if (state == BUSY && releaseTick != MaxTick &&
+        !releaseEvent.scheduled()) {
+        xbar.schedule(releaseEvent, std::max(releaseTick, curTick()));
+    }
+}
+
 template <typename SrcType, typename DstType>
 bool
 BaseXBar::Layer<SrcType, DstType>::tryTiming(SrcType* src_port)
@@ -194,6 +215,7 @@ BaseXBar::Layer<SrcType, DstType>::tryTiming(SrcType* src_port)
     // first we see if the layer is busy, next we check if the
     // destination port is already engaged in a transaction waiting
     // for a retry from the peer
+    updateState();
     if (state == BUSY || waitingForPeer != NULL) {
         // the port should not be waiting already
         assert(std::find(waitingForLayer.begin(), waitingForLayer.end(),
@@ -204,11 +226,17 @@ BaseXBar::Layer<SrcType, DstType>::tryTiming(SrcType* src_port)
         // that transaction to go through, and then the layer to free
         // up)
         waitingForLayer.push_back(src_port);
+
+        // the port now relies on the layer being released
+        scheduleRelease();
         return false;
     }
 
     state = BUSY;
 
+    // the release tick is not known until the layer is occupied
+    releaseTick = MaxTick;
+
     return true;
 }
 
@@ -323,10 +351,12 @@ BaseXBar::Layer<SrcType, DstType>::recvRetry()
 
     // if the layer is idle, retry this port straight away, if we
     // are busy, then simply let the port wait for its turn
+    updateState();
     if (state == IDLE) {
         retryWaiting();
     } else {
         assert(state == BUSY);
+        scheduleRelease();
     }
 }
 
@@ -600,7 +630,10 @@ BaseXBar::Layer<SrcType, DstType>::drain()
     //We should check that we're not "doing" anything, and that noone is
     //waiting. We might be idle but have someone waiting if the device we
     //contacted for a retry didn't actually retry.
+    updateState();
     if (state != IDLE) {
+        // make sure we get to signal the drain once released
+        scheduleRelease();
         DPRINTF(Drain, "Crossbar not drained\n");
         return DrainState::Draining;
     } else {
@@ -47,9 +47,10 @@
 #define __MEM_XBAR_HH__
 
 #include <deque>
-#include <unordered_map>
 
 #include "base/addr_range_map.hh"
+#include "base/cast.hh"
+#include "base/pool_allocator.hh"
 #include "base/types.hh"
 #include "mem/qport.hh"
 #include "params/BaseXBar.hh"
@@ -149,6 +150,14 @@ class BaseXBar : public ClockedObject
          */
         void failedTiming(SrcType* src_port, Tick busy_time);
 
+        /**
+         * Occupy the layer until the given tick. The layer only
+         * schedules an event to release itself if there is someone to
+         * retry or a drain to complete at that point, otherwise it
+         * becomes idle by itself once the tick has passed.
+         *
+         * @param until Tick at which the layer is free again
+         */
         void occupyLayer(Tick until);
 
         /**
@@ -164,6 +173,9 @@ class BaseXBar : public ClockedObject
          */
         void recvRetry();
 
+        /** Is a port waiting for a retry from the destination port? */
+        bool waitingForRetry() const { return waitingForPeer != NULL; }
+
       protected:
 
         /**
@@ -204,6 +216,28 @@ class BaseXBar : public ClockedObject
 
         State state;
 
+        /** Tick until which a busy layer is occupied. */
+        Tick releaseTick;
+
+        /**
+         * Move a busy layer that has reached its release tick without
+         * a scheduled release event back to the idle state.
+         */
+        void
+        updateState()
+        {
+            if (state == BUSY && curTick() >= releaseTick &&
+                !releaseEvent.scheduled()) {
+                state = IDLE;
+            }
+        }
+
+        /**
+         * Make sure the release event is scheduled for a busy layer, as
+         * someone now depends on it to be retried or drained.
+         */
+        void scheduleRelease();
+
         /**
          * A deque of ports that retry should be called on because
          * the original send was delayed due to a busy layer.
@@ -319,12 +353,98 @@ class BaseXBar : public ClockedObject
     AddrRangeMap<PortID, 3> portMap;
 
     /**
-     * Remember where request packets came from so that we can route
-     * responses to the appropriate port. This relies on the fact that
-     * the underlying Request pointer inside the Packet stays
-     * constant.
+     * Sender state remembering where a request came from, so that the
+     * response can be routed back to the appropriate port. Snoop
+     * responses are created by copying the snooped packet, and carry
+     * the route along with the rest of the sender state.
+     */
+    class RouteState : public Packet::SenderState
+    {
+      public:
+        RouteState(PortID _port, bool _snoop) : port(_port), snoop(_snoop)
+        {}
+
+        static void *
+        operator new(size_t size)
+        {
+            assert(size == sizeof(RouteState));
+            return PoolAllocator<RouteState>().allocate(1);
+        }
+
+        static void
+        operator delete(void *p)
+        {
+            PoolAllocator<RouteState>().deallocate(
+                static_cast<RouteState *>(p), 1);
+        }
+
+        /** Port to send the response to. */
+        const PortID port;
+
+        /** Does the route belong to a snoop forwarded from below? */
+        const bool snoop;
+    };
+
+    /** Number of routes currently held by packets, for sanity checks. */
+    unsigned int numRoutes;
+
+    /**
+     * Remember where a request came from by pushing a route onto its
+     * sender state.
+     *
+     * @param pkt Request to route the response of
+     * @param port_id Port the response should be sent to
+     * @param snoop Is the request a snoop forwarded from below?
+     * @return The route pushed onto the packet
      */
-    std::unordered_map<RequestPtr, PortID> routeTo;
+    RouteState *
+    pushRoute(PacketPtr pkt, PortID port_id, bool snoop=false)
+    {
+        RouteState *route = new RouteState(port_id, snoop);
+        pkt->pushSenderState(route);
+        ++numRoutes;
+        return route;
+    }
+
+    /**
+     * Get the route on top of the sender state of a response without
+     * removing it. A route to InvalidPortID belongs to a snoop made by
+     * the crossbar itself, and the response ends here.
+     */
+    static RouteState *
+    getRoute(PacketPtr pkt)
+    {
+        return safe_cast<RouteState *>(pkt->senderState);
+    }
+
+    /**
+     * Remove the route from the top of the sender state of a packet
+     * and release it.
+     *
+     * @return The port the route pointed at
+     */
+    PortID
+    popRoute(PacketPtr pkt)
+    {
+        RouteState *route = safe_cast<RouteState *>(pkt->popSenderState());
+        const PortID port_id = route->port;
+        delete route;
+        --numRoutes;
+        return port_id;
+    }
+
+    /**
+     * Take the route off the sender state of a request without
+     * releasing it, as it is now held by a copy of the packet made by
+     * a snooper committing to respond.
+     */
+    static void
+    handOverRoute(PacketPtr pkt)
+    {
+        // the copy still needs the link to the rest of the sender
+        // state, so do not clear it like popSenderState does
+        pkt->senderState = getRoute(pkt)->predecessor;
+    }
 
     /** all contigous ranges seen by this crossbar */
     AddrRangeList xbarRanges;
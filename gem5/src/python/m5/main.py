@@ -36,6 +36,7 @@
 # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
+import atexit
 import code
 import datetime
 import os
@@ -227,6 +228,15 @@ def parse_options():
         default="stats.txt",
         help="Sets the output file for statistics [Default: %default]",
     )
+    option(
+        "--stats-filter",
+        metavar="PATTERN[,PATTERN]",
+        action="append",
+        split=",",
+        help="Only dump stats whose full name matches one of the glob "
+        "patterns (e.g., system.cpu.ipc,system.*.overallMisses). Not "
+        "supported by json:// outputs",
+    )
     option(
         "--stats-help",
         action="callback",
@@ -301,6 +311,21 @@ def parse_options():
         help="Sets the output file for debug. Append '.gz' to the name for it"
         " to be compressed automatically [Default: %default]",
     )
+    option(
+        "--debug-binary",
+        action="store_true",
+        help="Record debug output in a compact binary form without "
+        "formatting it. Use util/decode_debug_trace.py to render it",
+    )
+    option(
+        "--debug-ring",
+        metavar="MB",
+        type="int",
+        default=0,
+        help="Only keep the last MB megabytes of binary debug output in "
+        "memory and write them out on panic, fatal or exit (implies "
+        "--debug-binary)",
+    )
     option(
         "--debug-activate",
         metavar="EXPR[,EXPR]",
@@ -315,6 +340,18 @@ def parse_options():
         split=":",
         help="Ignore EXPR sim objects",
     )
+    option(
+        "--debug-addr-range",
+        metavar="START:END",
+        help="Only trace addresses in [START, END) for address filtered "
+        "debug output (e.g., cache and prefetcher flags)",
+    )
+    option(
+        "--debug-pc-range",
+        metavar="START:END",
+        help="Only trace instructions with a PC in [START, END) for PC "
+        "filtered debug output (e.g., Exec flags)",
+    )
     option(
         "--remote-gdb-port",
         type="int",
@@ -400,6 +437,7 @@ def main():
         trace,
     )
     from .util import (
+        fatal,
         inform,
         isInteractive,
         panic,
@@ -571,6 +609,8 @@ def main():
 
     # set stats options
     stats.addStatVisitor(options.stats_file)
+    if options.stats_filter:
+        stats.setDumpFilter(options.stats_filter)
 
     # Disable listeners unless running interactively or explicitly
     # enabled
@@ -623,7 +663,16 @@ def main():
         e = event.create(trace.disable, event.Event.Debug_Enable_Pri)
         event.mainq.schedule(e, options.debug_end)
 
-    trace.output(options.debug_file)
+    if options.debug_binary or options.debug_ring:
+        debug_file = options.debug_file
+        if debug_file in ("cout", "cerr"):
+            debug_file = "debug_trace.bin.gz"
+        trace.binaryOutput(debug_file, options.debug_ring * 1024 * 1024)
+        # Registered before the simulator's own exit handlers, so this
+        # runs after them and catches everything they log.
+        atexit.register(trace.closeBinaryOutput)
+    else:
+        trace.output(options.debug_file)
 
     for activate in options.debug_activate:
         _check_tracing()
@@ -633,6 +682,25 @@ def main():
         _check_tracing()
         trace.ignore(ignore)
 
+    def parse_range(opt, value):
+        try:
+            start, end = (int(v, 0) for v in value.split(":"))
+        except ValueError:
+            fatal(f"{opt} expects START:END, got '{value}'")
+        return start, end
+
+    if options.debug_addr_range:
+        _check_tracing()
+        trace.addrRange(
+            *parse_range("--debug-addr-range", options.debug_addr_range)
+        )
+
+    if options.debug_pc_range:
+        _check_tracing()
+        trace.pcRange(
+            *parse_range("--debug-pc-range", options.debug_pc_range)
+        )
+
     sys.argv = arguments
 
     if options.m:
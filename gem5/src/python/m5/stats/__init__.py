@@ -190,6 +190,26 @@ def _hdf5Factory(fn, chunking=10, desc=True, formulas=True):
     return _m5.stats.initHDF5(fn, chunking, desc, formulas)
 
 
+@_url_factory(["bin"])
+def _binaryFactory(fn):
+    """Output stats in a streaming, columnar binary format.
+
+    Every stat is flattened into scalar columns. Column names are
+    written once and each dump only stores the values that changed
+    since the previous dump, which keeps frequent periodic dumps small
+    and cheap. The file is gzip compressed if its name ends in ".gz".
+
+    Use m5.stats.binary_reader (which can also be run as a standalone
+    script) to turn the file into NumPy arrays or a pandas DataFrame.
+
+    Example:
+      bin://stats.bin.gz
+
+    """
+
+    return _m5.stats.initBinary(fn)
+
+
 @_url_factory(["json"])
 def _jsonFactory(fn):
     """Output stats in JSON format.
@@ -232,6 +252,7 @@ def addStatVisitor(url):
         fatal(f"Stat type '{parsed.scheme}' disabled at compile time")
 
     outputList.append(factory(parsed))
+    _check_dump_filter()
 
 
 def printStatVisitorTypes():
@@ -356,6 +377,115 @@ def prepare():
     _visit_stats(lambda g, s: s.prepare())
 
 
+# Glob patterns selecting the stats to dump, or None to dump all stats.
+_dump_filter = None
+
+# Stat trees pruned by _dump_filter, indexed by the path of their root.
+_filtered_trees = {}
+
+
+def setDumpFilter(patterns):
+    """Only dump the stats matching one of the given patterns
+
+    Patterns are shell-style globs (see fnmatch) matched against the
+    full stat path, e.g., "system.cpu.ipc" or "system.*.overallMisses".
+    A plain stat path selects just that stat. Stats that are not
+    selected are neither prepared nor visited by the stat outputs, so
+    formulas and distributions that are not needed are never evaluated.
+    The filter applies to the text, HDF5 and binary outputs. The JSON
+    output walks the SimObject hierarchy rather than the stat tree, so
+    it cannot be combined with a filter.
+
+    Passing None or an empty list removes the filter.
+    """
+
+    global _dump_filter
+    if isinstance(patterns, str):
+        patterns = [patterns]
+    _dump_filter = list(patterns) if patterns else None
+    _filtered_trees.clear()
+    _check_dump_filter()
+
+
+def _check_dump_filter():
+    if _dump_filter is None:
+        return
+    if any(isinstance(output, JsonOutputVistor) for output in outputList):
+        fatal("The JSON stat output does not support a stat filter.")
+
+
+def _selected(name):
+    from fnmatch import fnmatchcase
+
+    return any(fnmatchcase(name, pattern) for pattern in _dump_filter)
+
+
+def _filtered_tree(group, path):
+    """Build the tree of selected stats below a group
+
+    Returns a (stats, children) tuple where children is a list of
+    (name, subtree) tuples, or None if no stat below the group is
+    selected. The tree only depends on the hierarchy and the filter, so
+    it is built once and reused for every dump.
+    """
+
+    prefix = ".".join(path)
+    stats = [
+        s
+        for s in group.getStats()
+        if _selected(f"{prefix}.{s.name}" if prefix else s.name)
+    ]
+    children = []
+    for n, g in group.getStatGroups().items():
+        subtree = _filtered_tree(g, path + [n])
+        if subtree is not None:
+            children.append((n, subtree))
+
+    if not stats and not children:
+        return None
+    return stats, children
+
+
+def _dump_tree(root=None):
+    path = root.path_list() if root is not None else []
+    key = tuple(path)
+    if key not in _filtered_trees:
+        group = root if root is not None else Root.getInstance()
+        tree = _filtered_tree(group, path)
+        if root is None:
+            # Legacy stats have fully qualified names and hang off the
+            # root of the hierarchy.
+            legacy = [s for s in stats_list if _selected(s.name)]
+            if tree is None and legacy:
+                tree = ([], [])
+        else:
+            legacy = []
+        _filtered_trees[key] = (tree, legacy)
+    return _filtered_trees[key]
+
+
+def _prepare_selected(roots=None):
+    """Prepare the stats that will be dumped for the given roots"""
+
+    if _dump_filter is None:
+        prepare()
+        return
+
+    def prepare_tree(tree):
+        stats, children = tree
+        for stat in stats:
+            stat.prepare()
+        for _, subtree in children:
+            prepare_tree(subtree)
+
+    for root in [None] + list(roots or []):
+        tree, legacy = _dump_tree(root)
+        if tree is not None:
+            prepare_tree(tree)
+        for stat in legacy:
+            stat.prepare()
+
+
 def _dump_to_visitor(visitor, roots=None):
     # New stats
     def dump_group(group):
@@ -366,21 +496,41 @@ def _dump_to_visitor(visitor, roots=None):
             dump_group(g)
             visitor.endGroup()
 
+    def dump_tree(tree):
+        stats, children = tree
+        for stat in stats:
+            stat.visit(visitor)
+        for n, subtree in children:
+            visitor.beginGroup(n)
+            dump_tree(subtree)
+            visitor.endGroup()
+
     if roots:
         # New stats from selected subroots.
         for root in roots:
             for p in root.path_list():
                 visitor.beginGroup(p)
-            dump_group(root)
+            if _dump_filter is None:
+                dump_group(root)
+            else:
+                tree, _ = _dump_tree(root)
+                if tree is not None:
+                    dump_tree(tree)
             for p in reversed(root.path_list()):
                 visitor.endGroup()
-    else:
+    elif _dump_filter is None:
         # New stats starting from root.
         dump_group(Root.getInstance())
 
         # Legacy stats
         for stat in stats_list:
             stat.visit(visitor)
+    else:
+        tree, legacy = _dump_tree()
+        if tree is not None:
+            dump_tree(tree)
+        for stat in legacy:
+            stat.visit(visitor)
 
 
 lastDump = 0
@@ -415,7 +565,7 @@ def dump(roots=None):
         sim_root = Root.getInstance()
         if sim_root:
             sim_root.preDumpStats()
-        prepare()
+        _prepare_selected(all_roots)
 
     for output in outputList:
         if isinstance(output, JsonOutputVistor):
@@ -0,0 +1,176 @@
+# Copyright (c) 2026 The Regents of The University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+"""
+Reader for the streaming binary stat format written by the "bin://" stat
+output (statistics::Binary in src/base/stats/binary.hh).
+
+This module has no gem5 dependencies and can be used from a normal Python
+interpreter, either by importing it or by running it as a script to
+convert a binary stat file to CSV:
+
+    python3 binary_reader.py m5out/stats.bin.gz > stats.csv
+
+The file stores, for each dump, only the columns that changed. The reader
+carries values forward so that every dump has a full row. Columns that
+have not been written yet are NaN.
+"""
+
+import gzip
+import struct
+import sys
+from typing import (
+    IO,
+    Dict,
+    List,
+    Tuple,
+)
+
+MAGIC = b"gem5stat"
+VERSION = 1
+
+
+class BinaryStatsError(Exception):
+    pass
+
+
+def _read_varint(f: IO[bytes]) -> int:
+    result = 0
+    shift = 0
+    while True:
+        b = f.read(1)
+        if not b:
+            raise BinaryStatsError("Truncated varint")
+        byte = b[0]
+        result |= (byte & 0x7F) << shift
+        if not byte & 0x80:
+            return result
+        shift += 7
+
+
+def _open(path: str) -> IO[bytes]:
+    f = open(path, "rb")
+    if f.peek(2)[:2] == b"\x1f\x8b":
+        f.close()
+        return gzip.open(path, "rb")
+    return f
+
+
+def read_records(
+    f: IO[bytes],
+) -> Tuple[Dict[int, str], List[Tuple[int, Dict[int, float]]]]:
+    """Parse a binary stat stream.
+
+    Returns a mapping from column id to column name and a list of
+    (tick, {column id: value}) tuples, one per dump, holding only the
+    values that changed in that dump.
+    """
+
+    if f.read(len(MAGIC)) != MAGIC:
+        raise BinaryStatsError("Not a gem5 binary stat file")
+    (version,) = struct.unpack("<I", f.read(4))
+    if version != VERSION:
+        raise BinaryStatsError(f"Unsupported format version {version}")
+
+    columns = {}
+    dumps = []
+    while True:
+        kind = f.read(1)
+        if not kind:
+            break
+        if kind == b"S":
+            for _ in range(_read_varint(f)):
+                column = _read_varint(f)
+                length = _read_varint(f)
+                columns[column] = f.read(length).decode()
+        elif kind == b"D":
+            tick = _read_varint(f)
+            changed = {}
+            column = 0
+            for _ in range(_read_varint(f)):
+                column += _read_varint(f)
+                (changed[column],) = struct.unpack("<d", f.read(8))
+                column += 1
+            dumps.append((tick, changed))
+        else:
+            raise BinaryStatsError(f"Unknown record type {kind!r}")
+
+    return columns, dumps
+
+
+def read(path: str):
+    """Read a binary stat file into NumPy arrays.
+
+    Returns a (ticks, names, values) tuple where ticks is a 1-D array of
+    dump ticks, names is the list of column names, and values is a 2-D
+    array with one row per dump and one column per name.
+    """
+
+    import numpy as np
+
+    with _open(path) as f:
+        columns, dumps = read_records(f)
+
+    names = [columns[i] for i in range(len(columns))]
+    ticks = np.array([tick for tick, _ in dumps], dtype=np.uint64)
+    values = np.full((len(dumps), len(names)), np.nan)
+    row = np.full(len(names), np.nan)
+    for i, (_, changed) in enumerate(dumps):
+        for column, value in changed.items():
+            row[column] = value
+        values[i] = row
+
+    return ticks, names, values
+
+
+def read_dataframe(path: str):
+    """Read a binary stat file into a pandas DataFrame indexed by tick."""
+
+    import pandas as pd
+
+    ticks, names, values = read(path)
+    return pd.DataFrame(
+        values, index=pd.Index(ticks, name="tick"), columns=names
+    )
+
+
+def _to_csv(path: str, out: IO[str]) -> None:
+    with _open(path) as f:
+        columns, dumps = read_records(f)
+
+    names = [columns[i] for i in range(len(columns))]
+    out.write(",".join(["tick"] + names) + "\n")
+    row = ["nan"] * len(names)
+    for tick, changed in dumps:
+        for column, value in changed.items():
+            row[column] = repr(value)
+        out.write(",".join([str(tick)] + row) + "\n")
+
+
+if __name__ == "__main__":
+    if len(sys.argv) != 2:
+        sys.exit(f"Usage: {sys.argv[0]} STATS_FILE")
+    _to_csv(sys.argv[1], sys.stdout)
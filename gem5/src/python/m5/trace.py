@@ -27,8 +27,13 @@
 # Export native methods to Python
 from _m5.trace import (
     activate,
+    addrRange,
+    binaryOutput,
+    closeBinaryOutput,
     disable,
     enable,
+    flush,
     ignore,
     output,
+    pcRange,
 )
@@ -42,9 +42,11 @@
 #include "pybind11/pybind11.h"
 #include "pybind11/stl.h"
 
+#include <iostream>
 #include <map>
 #include <vector>
 
+#include "base/binary_trace.hh"
 #include "base/compiler.hh"
 #include "base/debug.hh"
 #include "base/output.hh"
@@ -56,9 +58,36 @@ namespace py = pybind11;
 namespace gem5
 {
 
+/**
+ * Logger set up by binaryOutput(), and the file it writes to. They are
+ * not destroyed with the other statics, as simout may already be gone.
+ */
+static trace::BinaryLogger *binaryLogger = nullptr;
+static OutputStream *binaryStream = nullptr;
+
+/**
+ * Write out everything the binary logger still buffers and close its
+ * file, which also finishes a compressed file. Later messages go to
+ * std::cerr.
+ */
+static void
+closeBinaryOutput()
+{
+    if (!binaryLogger)
+        return;
+
+    trace::setDebugLogger(new trace::OstreamLogger(std::cerr));
+    delete binaryLogger;
+    binaryLogger = nullptr;
+    simout.close(binaryStream);
+    binaryStream = nullptr;
+}
+
 static void
 output(const char *filename)
 {
+    closeBinaryOutput();
+
     OutputStream *file_stream = simout.find(filename);
 
     if (!file_stream)
@@ -67,6 +96,33 @@ output(const char *filename)
     trace::setDebugLogger(new trace::OstreamLogger(*file_stream->stream()));
 }
 
+static void
+binaryOutput(const char *filename, size_t ring_size)
+{
+    closeBinaryOutput();
+
+    OutputStream *file_stream = simout.find(filename);
+
+    if (!file_stream)
+        file_stream = simout.create(filename, true);
+
+    binaryLogger =
+        new trace::BinaryLogger(*file_stream->stream(), ring_size);
+    binaryStream = file_stream;
+    trace::setDebugLogger(binaryLogger);
+}
+
+static void
+flush()
+{
+    auto *logger = dynamic_cast<trace::BinaryLogger *>(
+        trace::getDebugLogger());
+    if (logger)
+        logger->flush();
+    else
+        trace::output().flush();
+}
+
 static void
 activate(const char *expr)
 {
@@ -83,6 +139,18 @@ ignore(const char *expr)
     trace::getDebugLogger()->addIgnore(ignore);
 }
 
+static void
+addrRange(Addr start, Addr end)
+{
+    trace::addrFilter.set(start, end);
+}
+
+static void
+pcRange(Addr start, Addr end)
+{
+    trace::pcFilter.set(start, end);
+}
+
 void
 pybind_init_debug(py::module_ &m_native)
 {
@@ -129,8 +197,13 @@ pybind_init_debug(py::module_ &m_native)
     py::module_ m_trace = m_native.def_submodule("trace");
     m_trace
         .def("output", &output)
+        .def("binaryOutput", &binaryOutput)
+        .def("closeBinaryOutput", &closeBinaryOutput)
+        .def("flush", &flush)
         .def("activate", &activate)
         .def("ignore", &ignore)
+        .def("addrRange", &addrRange)
+        .def("pcRange", &pcRange)
         .def("enable", &trace::enable)
         .def("disable", &trace::disable)
         ;
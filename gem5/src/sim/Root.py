@@ -68,6 +68,13 @@ class Root(SimObject):
     # Needs to be set explicitly for a multi-eventq simulation.
     sim_quantum = Param.Tick(0, "simulation quantum")
 
+    # Merge events exchanged between event queues in a fixed order at
+    # each quantum barrier so that results do not depend on how many
+    # host threads are used or how they are scheduled.
+    deterministic_parallel = Param.Bool(
+        False, "order cross-queue events deterministically"
+    )
+
     full_system = Param.Bool("if this is a full system simulation")
 
     # Time syncing prevents the simulation from running faster than real time.
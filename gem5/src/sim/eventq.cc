@@ -30,10 +30,12 @@
 
 #include "sim/eventq.hh"
 
+#include <algorithm>
 #include <cassert>
 #include <iostream>
 #include <mutex>
 #include <string>
+#include <tuple>
 #include <unordered_map>
 #include <vector>
 
@@ -57,14 +59,16 @@ uint32_t numMainEventQueues = 0;
 std::vector<EventQueue *> mainEventQueue;
 __thread EventQueue *_curEventQueue = NULL;
 bool inParallelMode = false;
+bool deterministicParallel = false;
 
 EventQueue *
 getEventQueue(uint32_t index)
 {
     while (numMainEventQueues <= index) {
-        numMainEventQueues++;
-        mainEventQueue.push_back(
-            new EventQueue(csprintf("MainEventQueue-%d", index)));
+        EventQueue *eq =
+            new EventQueue(csprintf("MainEventQueue-%d", index));
+        eq->_index = numMainEventQueues++;
+        mainEventQueue.push_back(eq);
     }
 
     return mainEventQueue[index];
@@ -442,15 +446,28 @@ Event::dump() const
 }
 
 EventQueue::EventQueue(const std::string &n)
-    : objName(n), head(NULL), _curTick(0)
+    : objName(n), head(NULL), _curTick(0), _index(MaxQueueIndex),
+      asyncSeq(0), syncEpoch(0)
 {
 }
 
 void
 EventQueue::asyncInsert(Event *event)
 {
+    // The source queue is only ever touched by its own thread, so its
+    // sequence number and epoch can be read without locking. Insertions
+    // from threads that do not own a queue sort after all others and
+    // are merged at the next synchronisation point.
+    AsyncEntry entry{event, MaxQueueIndex, 0, 0};
+    EventQueue *src = curEventQueue();
+    if (src) {
+        entry.srcQueue = src->_index;
+        entry.seq = src->asyncSeq++;
+        entry.epoch = src->syncEpoch;
+    }
+
     async_queue_mutex.lock();
-    async_queue.push_back(event);
+    async_queue.push_back(entry);
     async_queue_mutex.unlock();
 }
 
@@ -458,14 +475,47 @@ void
 EventQueue::handleAsyncInsertions()
 {
     assert(this == curEventQueue());
-    async_queue_mutex.lock();
+    syncEpoch++;
+
+    if (!deterministicParallel) {
+        async_queue_mutex.lock();
+
+        while (!async_queue.empty()) {
+            insert(async_queue.front().event);
+            async_queue.pop_front();
+        }
 
-    while (!async_queue.empty()) {
-        insert(async_queue.front());
-        async_queue.pop_front();
+        async_queue_mutex.unlock();
+        return;
     }
 
+    // Threads that have already left the barrier may be inserting
+    // events for the next quantum while we drain. Only take the ones
+    // inserted before this synchronisation point so the set of merged
+    // events does not depend on how far ahead other threads are.
+    std::vector<AsyncEntry> ready;
+    async_queue_mutex.lock();
+    for (auto it = async_queue.begin(); it != async_queue.end(); ) {
+        if (it->epoch < syncEpoch) {
+            ready.push_back(*it);
+            it = async_queue.erase(it);
+        } else {
+            ++it;
+        }
+    }
     async_queue_mutex.unlock();
+
+    std::sort(ready.begin(), ready.end(),
+        [](const AsyncEntry &a, const AsyncEntry &b)
+        {
+            return std::make_tuple(a.event->when(), a.event->priority(),
+                                   a.srcQueue, a.seq) <
+                   std::make_tuple(b.event->when(), b.event->priority(),
+                                   b.srcQueue, b.seq);
+        });
+
+    for (const auto &entry : ready)
+        insert(entry.event);
 }
 
 } // namespace gem5
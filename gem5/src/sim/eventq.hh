@@ -38,6 +38,7 @@
 #include <algorithm>
 #include <cassert>
 #include <climits>
+#include <cstdint>
 #include <functional>
 #include <iosfwd>
 #include <list>
@@ -46,6 +47,7 @@
 
 #include "base/debug.hh"
 #include "base/flags.hh"
+#include "base/logging.hh"
 #include "base/named.hh"
 #include "base/trace.hh"
 #include "base/type_traits.hh"
@@ -82,6 +84,12 @@ extern __thread EventQueue *_curEventQueue;
 //! Current mode of execution: parallel / serial
 extern bool inParallelMode;
 
+//! Merge events exchanged between event queues in a fixed order (tick,
+//! priority, source queue, sequence number) at quantum barriers, so
+//! that the outcome of a parallel simulation does not depend on host
+//! thread timing.
+extern bool deterministicParallel;
+
 //! Function for returning eventq queue for the provided
 //! index. The function allocates a new queue in case one
 //! does not exist for the index, provided that the index
@@ -616,16 +624,43 @@ class EventQueue
 {
   private:
     friend void curEventQueue(EventQueue *);
+    friend EventQueue *getEventQueue(uint32_t index);
 
     std::string objName;
     Event *head;
     Tick _curTick;
 
+    /**
+     * An event inserted by another thread, tagged with its origin so
+     * that the async queue can be merged in an order that does not
+     * depend on when the inserting threads happened to run.
+     */
+    struct AsyncEntry
+    {
+        Event *event;
+        //! Index of the event queue that inserted the event.
+        uint32_t srcQueue;
+        //! Insertion sequence number local to the source queue.
+        uint64_t seq;
+        //! Synchronisation epoch of the source queue at insertion.
+        uint64_t epoch;
+    };
+
     //! Mutex to protect async queue.
     UncontendedMutex async_queue_mutex;
 
     //! List of events added by other threads to this event queue.
-    std::list<Event*> async_queue;
+    std::list<AsyncEntry> async_queue;
+
+    //! Index of this queue in mainEventQueue (MaxQueueIndex if none).
+    uint32_t _index;
+
+    //! Number of async insertions made by the thread owning this queue.
+    uint64_t asyncSeq;
+
+    //! Number of synchronisation points (calls to
+    //! handleAsyncInsertions()) this queue has gone through.
+    uint64_t syncEpoch;
 
     /**
      * Lock protecting event handling.
@@ -662,6 +697,8 @@ class EventQueue
     EventQueue(const EventQueue &);
 
   public:
+    static constexpr uint32_t MaxQueueIndex = UINT32_MAX;
+
     class ScopedMigration
     {
       public:
@@ -684,6 +721,9 @@ class EventQueue
              doMigrate((&new_eq != &old_eq)&&_doMigrate)
         {
             if (doMigrate){
+                warn_if_once(deterministicParallel,
+                    "Event queue migration makes parallel simulation "
+                    "non-deterministic.");
                 old_eq.unlock();
                 new_eq.lock();
                 curEventQueue(&new_eq);
@@ -748,6 +788,9 @@ class EventQueue
     void name(const std::string &st) { objName = st; }
     /** @}*/ //end of api_eventq group
 
+    /** Index of this queue in mainEventQueue, MaxQueueIndex if none. */
+    uint32_t index() const { return _index; }
+
     /**
      * Schedule the given event on this queue. Safe to call from any thread.
      *
@@ -902,6 +945,13 @@ class EventQueue
 
     /**
      * Function for moving events from the async_queue to the main queue.
+     *
+     * This must be called by every main event queue at the same
+     * synchronisation points (start of the simulation loop and quantum
+     * barriers). In deterministic parallel mode, only events inserted
+     * before the current synchronisation point are moved, and they are
+     * inserted in (tick, priority, source queue, sequence number)
+     * order.
      */
     void handleAsyncInsertions();
 
@@ -0,0 +1,114 @@
+# Copyright (c) 2026 The Regents of the University of California.
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+"""
+Runs the same program on two atomic CPUs, one of them with the basic
+block cache, stopping both every few instructions. The CPUs have to stop
+after exactly the requested number of instructions and at the same
+ticks, and the program, which modifies its own code, has to pass on
+both.
+"""
+
+import argparse
+import os
+
+import m5
+from m5.objects import *
+
+parser = argparse.ArgumentParser(description="Basic block cache tester")
+parser.add_argument("--cmd", required=True)
+parser.add_argument(
+    "--step", type=int, default=997, help="Instructions between stops"
+)
+
+args = parser.parse_args()
+
+system = System()
+system.clk_domain = SrcClockDomain(
+    clock="1GHz", voltage_domain=VoltageDomain()
+)
+system.mem_mode = "atomic"
+system.mem_ranges = [AddrRange("512MiB")]
+system.workload = SEWorkload.init_compatible(args.cmd)
+
+system.membus = SystemXBar()
+system.system_port = system.membus.cpu_side_ports
+system.physmem = SimpleMemory(range=system.mem_ranges[0])
+system.physmem.port = system.membus.mem_side_ports
+
+names = ("reference", "cached")
+system.cpu = [
+    X86AtomicSimpleCPU(cpu_id=i, basic_block_cache=(name == "cached"))
+    for i, name in enumerate(names)
+]
+for i, (cpu, name) in enumerate(zip(system.cpu, names)):
+    cpu.icache_port = system.membus.cpu_side_ports
+    cpu.dcache_port = system.membus.cpu_side_ports
+    cpu.workload = Process(
+        pid=100 + i, cmd=[args.cmd], output="smc-%s.out" % name
+    )
+    cpu.createThreads()
+    cpu.createInterruptController()
+    cpu.interrupts[0].pio = system.membus.mem_side_ports
+    cpu.interrupts[0].int_requestor = system.membus.cpu_side_ports
+    cpu.interrupts[0].int_responder = system.membus.mem_side_ports
+
+root = Root(full_system=False, system=system)
+m5.instantiate()
+
+for name, cpu in zip(names, system.cpu):
+    cpu.scheduleInstStop(0, args.step, name)
+
+targets = {name: args.step for name in names}
+stops = {name: [] for name in names}
+while True:
+    exit_event = m5.simulate()
+    cause = exit_event.getCause()
+    if cause not in names:
+        break
+
+    cpu = system.cpu[names.index(cause)]
+    count = cpu.getCurrentInstCount(0)
+    if count != targets[cause]:
+        m5.fatal(
+            "%s CPU stopped after %d instructions instead of %d"
+            % (cause, count, targets[cause])
+        )
+    stops[cause].append(m5.curTick())
+    targets[cause] += args.step
+    cpu.scheduleInstStop(0, args.step, cause)
+
+if stops["reference"] != stops["cached"]:
+    m5.fatal("The CPUs stopped at different ticks")
+if not stops["reference"]:
+    m5.fatal("The CPUs never stopped")
+
+for name in names:
+    with open(os.path.join(m5.options.outdir, "smc-%s.out" % name)) as f:
+        if f.read().strip() != "PASS":
+            m5.fatal("Self-modifying code failed on the %s CPU" % name)
+
+print("Stopped %d times at the same ticks" % len(stops["reference"]))
@@ -0,0 +1,79 @@
+# Copyright (c) 2026 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+"""
+Records a branch trace from a short SE workload and replays it through a
+branch predictor, to check that the traces written by BranchTraceRecorder
+can be read back by BranchTraceReplayer.
+"""
+
+import re
+
+from testlib import *
+
+if config.bin_path:
+    resource_path = config.bin_path
+else:
+    resource_path = joinpath(absdirpath(__file__), "..", "resources")
+
+# Shared between the two tests: the replay reads the trace the record test
+# wrote.
+trace_path = joinpath(resource_path, "bpred-replay-x86-hello.trace.gz")
+
+gem5_verify_config(
+    name="test-bpred-replay-record",
+    fixtures=(),
+    verifiers=(verifier.MatchRegex(re.compile(r"Hello world!")),),
+    config=joinpath(
+        config.base_dir,
+        "tests",
+        "gem5",
+        "bpred_replay",
+        "configs",
+        "record_branches.py",
+    ),
+    config_args=["--trace-file", trace_path],
+    valid_isas=(constants.all_compiled_tag,),
+    valid_hosts=constants.supported_hosts,
+    length=constants.quick_tag,
+)
+
+gem5_verify_config(
+    name="test-bpred-replay-replay",
+    fixtures=(),
+    verifiers=(
+        verifier.MatchRegex(re.compile(r"finished replaying")),
+        verifier.MatchFileRegex(
+            re.compile(r"^replayer\.branches::total\s+[1-9]"),
+            ["stats.txt"],
+        ),
+    ),
+    config=joinpath(config.base_dir, "configs", "example", "bpred_replay.py"),
+    config_args=[trace_path],
+    valid_isas=(constants.all_compiled_tag,),
+    valid_hosts=constants.supported_hosts,
+    length=constants.quick_tag,
+)
@@ -116,6 +116,16 @@ parser = argparse.ArgumentParser()
 parser.add_argument("binary", type=str)
 parser.add_argument("--cpu")
 parser.add_argument("--mem", choices=valid_mem.keys(), default="SimpleMemory")
+parser.add_argument(
+    "--iq-select-policy",
+    choices=("AgeList", "AgeMatrix", "Checked"),
+    help="How the IQ of the O3 CPUs selects ready instructions",
+)
+parser.add_argument(
+    "--rename-checkpoints",
+    type=int,
+    help="Number of rename map checkpoints per thread of the O3 CPUs",
+)
 
 args = parser.parse_args()
 
@@ -137,6 +147,10 @@ if args.cpu not in (
 system.mem_ranges = [AddrRange("512MiB")]
 
 system.cpu = valid_cpu[args.cpu]()
+if args.iq_select_policy:
+    system.cpu.iqSelectPolicy = args.iq_select_policy
+if args.rename_checkpoints is not None:
+    system.cpu.numRenameCheckpoints = args.rename_checkpoints
 
 if args.cpu in (
     "X86AtomicSimpleCPU",
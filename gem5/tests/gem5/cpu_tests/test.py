@@ -95,3 +95,40 @@ for isa in valid_isas:
                 valid_isas=(constants.all_compiled_tag,),
                 fixtures=[workload_binary],
             )
+
+            if not cpu.endswith("DerivO3CPU"):
+                continue
+
+            # The checked policy runs the age lists and the age matrix
+            # side by side and panics as soon as they select different
+            # instructions.
+            for policy in ("AgeMatrix", "Checked"):
+                gem5_verify_config(
+                    name=f"cpu_test_{cpu}_{workload}_{policy}",
+                    verifiers=verifiers,
+                    config=joinpath(getcwd(), "run.py"),
+                    config_args=[
+                        f"--cpu={cpu}",
+                        f"--iq-select-policy={policy}",
+                        binary,
+                    ],
+                    valid_isas=(constants.all_compiled_tag,),
+                    fixtures=[workload_binary],
+                )
+
+            # A single checkpoint runs out at almost every branch, while 16
+            # are rarely all taken, so both the restore and the history
+            # walk recovery paths are exercised.
+            for checkpoints in (1, 16):
+                gem5_verify_config(
+                    name=f"cpu_test_{cpu}_{workload}_ckpt{checkpoints}",
+                    verifiers=verifiers,
+                    config=joinpath(getcwd(), "run.py"),
+                    config_args=[
+                        f"--cpu={cpu}",
+                        f"--rename-checkpoints={checkpoints}",
+                        binary,
+                    ],
+                    valid_isas=(constants.all_compiled_tag,),
+                    fixtures=[workload_binary],
+                )
@@ -0,0 +1,62 @@
+# Copyright (c) 2026 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+"""
+Checks that a binary debug trace is complete after gem5 exits cleanly,
+both when it is streamed out (--debug-binary) and when it is only kept
+in memory (--debug-ring).
+"""
+
+from testlib import *
+
+for name, binary_arg in (
+    ("binary", "--debug-binary"),
+    # Large enough to hold the whole trace.
+    ("ring", "--debug-ring=64"),
+):
+    gem5_verify_config(
+        name=f"debug_trace_{name}_complete",
+        fixtures=(),
+        verifiers=(
+            verifier.CheckBinaryDebugTrace(
+                "debug_trace.bin.gz",
+                r": Read from ",
+                "system.mem.numReads::total",
+            ),
+        ),
+        config=joinpath(
+            config.base_dir,
+            "tests",
+            "gem5",
+            "debug_trace",
+            "configs",
+            "read_traffic.py",
+        ),
+        config_args=[],
+        gem5_args=["--debug-flags=MemoryAccess", binary_arg],
+        valid_isas=(constants.null_tag,),
+        length=constants.long_tag,
+    )
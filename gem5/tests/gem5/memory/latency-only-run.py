@@ -0,0 +1,96 @@
+# Copyright (c) 2026 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+"""
+Runs "x86-hello64-static" on a timing CPU without caches from a
+SimpleMemory, optionally in latency-only mode so that the fetches, loads
+and stores of the CPU take their data through the back door of the
+memory. The config fails if the memory saw instruction fetches in
+latency-only mode, or none without it.
+"""
+
+import argparse
+import os
+import re
+
+import m5
+
+from gem5.components.boards.simple_board import SimpleBoard
+from gem5.components.cachehierarchies.classic.no_cache import NoCache
+from gem5.components.memory.simple import SingleChannelSimpleMemory
+from gem5.components.processors.cpu_types import CPUTypes
+from gem5.components.processors.simple_processor import SimpleProcessor
+from gem5.isas import ISA
+from gem5.resources.resource import obtain_resource
+from gem5.simulate.simulator import Simulator
+from gem5.utils.requires import requires
+
+parser = argparse.ArgumentParser()
+parser.add_argument(
+    "--latency-only",
+    action="store_true",
+    help="Access the memory through its back door",
+)
+args = parser.parse_args()
+
+requires(isa_required=ISA.X86)
+
+memory = SingleChannelSimpleMemory(
+    latency="30ns", latency_var="0ns", bandwidth="12.8GiB/s", size="32MiB"
+)
+memory.module.latency_only = args.latency_only
+
+board = SimpleBoard(
+    clk_freq="3GHz",
+    processor=SimpleProcessor(
+        cpu_type=CPUTypes.TIMING, isa=ISA.X86, num_cores=1
+    ),
+    memory=memory,
+    cache_hierarchy=NoCache(),
+)
+board.set_se_binary_workload(
+    obtain_resource("x86-hello64-static", resource_version="1.0.0")
+)
+
+sim = Simulator(board=board, full_system=False)
+sim.run()
+
+print(
+    "Exiting @ tick {} because {}.".format(
+        sim.get_current_tick(), sim.get_last_exit_event_cause()
+    )
+)
+
+# Accesses through the back door are not counted by the memory
+m5.stats.dump()
+fetch_stat = re.compile(r"board\.memory\.module\.bytesInstRead::total\s+[1-9]")
+with open(os.path.join(m5.options.outdir, "stats.txt")) as f:
+    fetched = any(fetch_stat.match(line) for line in f)
+if fetched == args.latency_only:
+    m5.fatal(
+        "Instruction fetches %s the memory"
+        % ("reached" if fetched else "did not reach")
+    )
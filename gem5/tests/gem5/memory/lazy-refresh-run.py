@@ -0,0 +1,113 @@
+# Copyright (c) 2026 The Regents of the University of California.
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+"""
+Drives two identical DRAM channels with the same bursty traffic, one of
+them with its refreshes modelled lazily while idle, and checks that the
+stats of the two, including the power and energy stats of the ranks,
+come out the same.
+"""
+
+import os
+
+import m5
+from m5.objects import *
+
+# bursts of traffic separated by idle periods spanning many refresh
+# intervals, ending on an idle period so that refreshes are still being
+# modelled lazily when the stats are dumped
+burst = 2000000
+idle = 150000000
+bursts = 6
+mem_size = 0x10000000
+
+system = System(
+    clk_domain=SrcClockDomain(clock="2GHz", voltage_domain=VoltageDomain())
+)
+system.mem_ranges = [AddrRange(0, size=mem_size)]
+system.mmap_using_noreserve = True
+
+names = ("eager", "lazy")
+system.tgens = [PyTrafficGen() for name in names]
+system.mem_ctrls = [
+    MemCtrl(
+        dram=DDR3_1600_8x8(
+            range=AddrRange(i * mem_size, size=mem_size),
+            lazy_refresh=(name == "lazy"),
+        )
+    )
+    for i, name in enumerate(names)
+]
+for tgen, ctrl in zip(system.tgens, system.mem_ctrls):
+    tgen.port = ctrl.port
+
+root = Root(full_system=False, system=system)
+root.system.mem_mode = "timing"
+
+m5.instantiate()
+
+
+def traffic(tgen, base):
+    for i in range(bursts):
+        yield tgen.createLinear(
+            burst, base, base + mem_size - 1, 64, 3000, 3000, 70, 0
+        )
+        yield tgen.createIdle(idle)
+    yield tgen.createExit(0)
+
+
+for i, tgen in enumerate(system.tgens):
+    tgen.start(traffic(tgen, i * mem_size))
+
+exit_event = m5.simulate()
+if "has encountered the exit state" not in exit_event.getCause():
+    m5.fatal("Unexpected exit: %s" % exit_event.getCause())
+
+m5.stats.dump()
+
+
+def ctrl_stats(index):
+    prefix = "system.mem_ctrls%d." % index
+    stats = {}
+    with open(os.path.join(m5.options.outdir, "stats.txt")) as f:
+        for line in f:
+            if line.startswith(prefix):
+                name, value = line.split("#")[0].split(None, 1)
+                stats[name[len(prefix) :]] = value.split()
+    return stats
+
+
+eager, lazy = ctrl_stats(0), ctrl_stats(1)
+if not eager:
+    m5.fatal("No memory controller stats found")
+for name in sorted(set(eager) | set(lazy)):
+    if eager.get(name) != lazy.get(name):
+        m5.fatal(
+            "%s differs: %s eagerly, %s lazily"
+            % (name, eager.get(name), lazy.get(name))
+        )
+
+print("Compared %d stats" % len(eager))
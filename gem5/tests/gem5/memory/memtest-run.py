@@ -24,12 +24,27 @@
 # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
+import argparse
+import os
+
 import m5
 from m5.objects import *
 
 m5.util.addToPath("../../../configs/")
 from common.Caches import *
 
+parser = argparse.ArgumentParser()
+parser.add_argument(
+    "--sf-sets",
+    type=int,
+    default=0,
+    help="Sets of a bounded snoop filter on the L2 crossbar (0: unbounded)",
+)
+parser.add_argument(
+    "--sf-ways", type=int, default=8, help="Ways of a bounded snoop filter"
+)
+args = parser.parse_args()
+
 # MAX CORES IS 8 with the fals sharing method
 nb_cores = 8
 cpus = [MemTest(max_loads=1e5, progress_interval=1e4) for i in range(nb_cores)]
@@ -49,8 +64,18 @@ system.cpu_clk_domain = SrcClockDomain(
 )
 
 system.toL2Bus = L2XBar(clk_domain=system.cpu_clk_domain)
-system.l2c = L2Cache(clk_domain=system.cpu_clk_domain, size="64KiB", assoc=8)
+system.toL2Bus.snoop_filter.sets = args.sf_sets
+system.toL2Bus.snoop_filter.ways = args.sf_ways
+system.l2c = L2Cache(
+    clk_domain=system.cpu_clk_domain,
+    size="64KiB",
+    assoc=8,
+    replacement_policy=LRURP(),
+)
 system.l2c.cpu_side = system.toL2Bus.mem_side_ports
+# measure the miss ratio curve of the l2c with shadow tags, sampling all
+# the 128 sets of its own geometry so that it can be checked against it
+system.l2c.mrc = MissRatioCurveProbe(sampled_sets=128)
 
 # connect l2c to membus
 system.l2c.mem_side = system.membus.cpu_side_ports
@@ -80,3 +105,27 @@ m5.instantiate()
 exit_event = m5.simulate()
 if exit_event.getCause() != "maximum number of loads reached":
     exit(1)
+
+m5.stats.dump()
+
+# the shadow tags of the l2c geometry see the same accesses and replace
+# with the same LRU as the l2c, and only differ on the misses merged in
+# an MSHR, which they count as hits; the bound is a rough estimate of
+# these, not measured on gem5 runs
+max_miss_ratio_error = 0.05
+
+stats = {}
+with open(os.path.join(m5.options.outdir, "stats.txt")) as f:
+    for line in f:
+        fields = line.split()
+        if len(fields) >= 2:
+            stats[fields[0]] = fields[1]
+
+shadow = float(stats["system.l2c.mrc.missRatio_sets128::ways8"])
+actual = float(stats["system.l2c.demandMissRate::total"])
+print("Shadow tags miss ratio %.4f, l2c miss ratio %.4f" % (shadow, actual))
+if abs(shadow - actual) > max_miss_ratio_error:
+    m5.fatal(
+        "Shadow tags miss ratio %.4f is off the l2c one %.4f"
+        % (shadow, actual)
+    )
@@ -0,0 +1,147 @@
+# Copyright (c) 2026 The Regents of the University of California.
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+
+"""
+Runs random traffic over a small footprint past two stack distance
+probes, one exact and one sampling the lines on a budget, and checks
+that the histograms of the sampled one stay close to the exact ones.
+"""
+
+import os
+
+import m5
+from m5.objects import *
+
+# 16k lines, each of them reused a few times on average
+footprint = 0x100000
+period = 100000
+requests = 100000
+
+# bounds on the error of the sampled probe; these are rough estimates
+# for the sampled share of the lines, not measured on gem5 runs, and
+# should be tightened to the errors seen on them
+max_count_error = 0.15
+max_infinite_error = 0.2
+max_hist_distance = 0.15
+
+system = System(
+    membus=IOXBar(width=16),
+    physmem=SimpleMemory(range=AddrRange(footprint)),
+    clk_domain=SrcClockDomain(clock="1GHz", voltage_domain=VoltageDomain()),
+)
+system.mem_ranges = [system.physmem.range]
+system.tgen = PyTrafficGen()
+
+system.monitor = CommMonitor()
+system.monitor.stackdist = StackDistProbe()
+system.monitor.stackdist_sampled = StackDistProbe(
+    sampling_shift=1, max_tracked_lines=256
+)
+
+system.tgen.port = system.monitor.cpu_side_port
+system.monitor.mem_side_port = system.membus.cpu_side_ports
+system.system_port = system.membus.cpu_side_ports
+system.physmem.port = system.membus.mem_side_ports
+
+root = Root(full_system=False, system=system)
+root.system.mem_mode = "timing"
+
+m5.instantiate()
+
+tgen = system.tgen
+tgen.start(
+    [
+        tgen.createRandom(
+            requests * period, 0, footprint, 64, period, period, 50, 0
+        ),
+        tgen.createExit(0),
+    ]
+)
+
+exit_event = m5.simulate()
+if "has encountered the exit state" not in exit_event.getCause():
+    m5.fatal("Unexpected exit: %s" % exit_event.getCause())
+
+m5.stats.dump()
+
+
+def probe_stats(probe):
+    """The log histogram of reads and writes together, by bucket, and
+    the number of requests with an infinite stack distance."""
+    prefix = "system.monitor.%s." % probe
+    hist = {}
+    infinite = 0
+    with open(os.path.join(m5.options.outdir, "stats.txt")) as f:
+        for line in f:
+            if not line.startswith(prefix):
+                continue
+            name, value = line.split()[:2]
+            stat = name[len(prefix) :]
+            if stat == "infiniteSD":
+                infinite = float(value)
+            elif stat.startswith(("readLogHist::", "writeLogHist::")):
+                bucket = stat.split("::")[1]
+                if bucket not in ("samples", "total"):
+                    hist[bucket] = hist.get(bucket, 0) + float(value)
+    return hist, infinite
+
+
+exact, exact_infinite = probe_stats("stackdist")
+sampled, sampled_infinite = probe_stats("stackdist_sampled")
+
+exact_count = sum(exact.values())
+sampled_count = sum(sampled.values())
+if not exact_count or not exact_infinite:
+    m5.fatal("No stack distances found")
+
+
+def relative_error(estimate, reference):
+    return abs(estimate - reference) / reference
+
+
+count_error = relative_error(
+    sampled_count + sampled_infinite, exact_count + exact_infinite
+)
+infinite_error = relative_error(sampled_infinite, exact_infinite)
+distance = 0.5 * sum(
+    abs(exact.get(b, 0) / exact_count - sampled.get(b, 0) / sampled_count)
+    for b in set(exact) | set(sampled)
+)
+print(
+    "Request count error %.3f, infinite distance error %.3f, "
+    "histogram distance %.3f"
+    % (count_error, infinite_error, distance)
+)
+
+if count_error > max_count_error:
+    m5.fatal("Sampled request count is off by %.3f" % count_error)
+if infinite_error > max_infinite_error:
+    m5.fatal("Sampled infinite distances are off by %.3f" % infinite_error)
+if distance > max_hist_distance:
+    m5.fatal(
+        "Sampled histograms are %.3f away from the exact ones" % distance
+    )
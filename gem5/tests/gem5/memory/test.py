@@ -29,6 +29,8 @@ Test file for simple memory test
 TODO: Add stats checking
 """
 
+import re
+
 from testlib import *
 
 gem5_verify_config(
@@ -61,6 +63,19 @@ for name, params in simple_mem_params:
         length=constants.long_tag,
     )  # This tests for validity as well as performance
 
+# A timing CPU takes its data through the back door of a latency-only
+# memory, and the config fails unless the memory stats show it did
+for name, args in (("default", []), ("enabled", ["--latency-only"])):
+    gem5_verify_config(
+        name="simple_mem_latency_only_" + name,
+        verifiers=(verifier.MatchRegex(re.compile(r"Hello world!")),),
+        config=joinpath(getcwd(), "latency-only-run.py"),
+        config_args=args,
+        valid_isas=(constants.all_compiled_tag,),
+        valid_hosts=constants.supported_hosts,
+        length=constants.long_tag,
+    )
+
 gem5_verify_config(
     name="memtest",
     verifiers=(),  # No need for verfiers this will return non-zero on fail
@@ -70,6 +85,65 @@ gem5_verify_config(
     length=constants.long_tag,
 )
 
+# A snoop filter far smaller than the L1s keeps evicting lines, and the
+# data checks of the testers catch any lost by the back-invalidations,
+# while the stats show dirty lines were pinned and written back
+gem5_verify_config(
+    name="memtest_bounded_sf",
+    verifiers=(
+        verifier.MatchFileRegex(
+            r"^system\.toL2Bus\.snoop_filter\.backInvalidations\s+[1-9]",
+            ["stats.txt"],
+        ),
+        verifier.MatchFileRegex(
+            r"^system\.toL2Bus\.pinnedLines\s+[1-9]", ["stats.txt"]
+        ),
+    ),
+    config=joinpath(getcwd(), "memtest-run.py"),
+    config_args=["--sf-sets", "16", "--sf-ways", "4"],
+    valid_isas=(constants.null_tag,),
+    length=constants.long_tag,
+)
+
+# The stack distances of a probe that samples lines on a budget have to
+# stay close to the exact ones
+gem5_verify_config(
+    name="stackdist_sampled",
+    verifiers=(),  # The config fails if the error is too large
+    config=joinpath(getcwd(), "stackdist-run.py"),
+    config_args=[],
+    valid_isas=(constants.null_tag,),
+    length=constants.long_tag,
+)
+
+# Refreshes modelled lazily while the ranks are idle have to give the same
+# stats and energy as refreshes simulated with events
+gem5_verify_config(
+    name="lazy_refresh",
+    verifiers=(),  # The config fails if any stat differs
+    config=joinpath(getcwd(), "lazy-refresh-run.py"),
+    config_args=[],
+    valid_isas=(constants.null_tag,),
+    length=constants.long_tag,
+)
+
+# Exercise the bank-indexed FR-FCFS scheduler with a mix of row hits and
+# misses, checking each decision against a walk of the whole queue
+dram_sweep_params = [
+    ("dram_sweep_frfcfs", ["--rd_perc", "50"]),
+    ("dram_sweep_frfcfs_rotate", ["--mode", "DRAM_ROTATE", "-r", "2"]),
+]
+
+for name, args in dram_sweep_params:
+    gem5_verify_config(
+        name=name,
+        verifiers=(),  # No need for verfiers this will return non-zero on fail
+        config=joinpath(config.base_dir, "configs", "dram", "sweep.py"),
+        config_args=["--verify-frfcfs"] + args,
+        valid_isas=(constants.null_tag,),
+        length=constants.long_tag,
+    )
+
 null_tests = [
     ("garnet_synth_traffic", None, ["--sim-cycles", "5000000"]),
     ("memcheck", None, ["--maxtick", "2000000000", "--prefetchers"]),
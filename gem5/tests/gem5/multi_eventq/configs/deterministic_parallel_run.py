@@ -0,0 +1,185 @@
+# Copyright (c) 2026 The Regents of the University of California.
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+"""
+Runs a set of traffic generators, each on its own event queue, that
+share a crossbar and a memory on event queue 0 through a ThreadBridge.
+The same configuration is simulated with a varying number of event
+queues (host threads) in deterministic parallel mode, and the simulated
+statistics have to be bit-identical.
+
+Without `--child`, this script spawns one gem5 process per entry of
+`--threads` and compares the resulting stats files, exiting with a
+non-zero code on any difference. A thread count can be listed more than
+once to check that repeated runs agree. Host statistics (`host*`) are
+ignored.
+"""
+
+import argparse
+import difflib
+import os
+import subprocess
+import sys
+
+import m5
+from m5.objects import *
+
+parser = argparse.ArgumentParser(
+    description="Deterministic parallel event queue tester"
+)
+parser.add_argument(
+    "--threads",
+    type=int,
+    nargs="+",
+    default=[1, 2, 4],
+    help="Event queue counts to compare. The first one is the reference.",
+)
+parser.add_argument(
+    "--islands", type=int, default=4, help="Number of traffic generators"
+)
+parser.add_argument(
+    "--ticks", type=int, default=200000000, help="Ticks to simulate"
+)
+parser.add_argument(
+    "--child",
+    action="store_true",
+    help="Run the simulation instead of spawning and comparing runs",
+)
+
+args = parser.parse_args()
+
+
+def run_child(num_queues):
+    quantum = 1000000
+    system = System(
+        membus=IOXBar(width=16),
+        physmem=SimpleMemory(latency="30ns", latency_var="10ns"),
+        clk_domain=SrcClockDomain(
+            clock="1GHz", voltage_domain=VoltageDomain()
+        ),
+        mem_ranges=[AddrRange("16MB")],
+        mem_mode="timing",
+    )
+    system.physmem.range = system.mem_ranges[0]
+    system.physmem.port = system.membus.mem_side_ports
+    system.system_port = system.membus.cpu_side_ports
+
+    # Every request and response crosses between the queue of its
+    # generator and queue 0, where the generators contend for the
+    # crossbar and the memory.
+    system.bridge = ThreadBridge(eventq_index=0, delay=quantum)
+    system.bridge.out_port = system.membus.cpu_side_ports
+    system.tgens = [
+        PyTrafficGen(eventq_index=i % num_queues)
+        for i in range(args.islands)
+    ]
+    for tgen in system.tgens:
+        tgen.port = system.bridge.in_port
+
+    root = Root(
+        full_system=False,
+        system=system,
+        sim_quantum=quantum,
+        deterministic_parallel=True,
+    )
+
+    m5.instantiate()
+
+    for tgen in system.tgens:
+        tgen.start(
+            [
+                tgen.createRandom(
+                    args.ticks, 0, 16777216, 64, 500, 1500, 65, 0
+                )
+            ]
+        )
+
+    # Periodic dumps are global events, so they exercise the
+    # cross-queue insertion path on every interval.
+    m5.stats.periodicStatDump(args.ticks // 10)
+    exit_event = m5.simulate(args.ticks)
+    if exit_event.getCause() != "simulate() limit reached":
+        sys.exit(1)
+
+
+def simulated_stats(path):
+    with open(path) as f:
+        return [
+            line
+            for line in f
+            if not line.startswith("host") and line.strip() != ""
+        ]
+
+
+def compare_runs():
+    outdir = m5.options.outdir
+    reference = None
+    for run, num_queues in enumerate(args.threads):
+        run_dir = os.path.join(outdir, f"run{run}-threads{num_queues}")
+        subprocess.run(
+            [
+                sys.executable,
+                "-d",
+                run_dir,
+                os.path.abspath(__file__),
+                "--child",
+                "--threads",
+                str(num_queues),
+                "--islands",
+                str(args.islands),
+                "--ticks",
+                str(args.ticks),
+            ],
+            check=True,
+        )
+
+        stats = simulated_stats(os.path.join(run_dir, "stats.txt"))
+        if reference is None:
+            reference = (num_queues, stats)
+            continue
+
+        if stats != reference[1]:
+            diff = difflib.unified_diff(
+                reference[1],
+                stats,
+                fromfile=f"threads{reference[0]}",
+                tofile=f"threads{num_queues}",
+                n=0,
+            )
+            sys.stderr.writelines(list(diff)[:50])
+            print(
+                f"Stats with {num_queues} event queues differ from "
+                f"{reference[0]} event queue(s)."
+            )
+            sys.exit(1)
+
+    print("Stats are identical across event queue counts.")
+
+
+if args.child:
+    run_child(args.threads[0])
+else:
+    compare_runs()
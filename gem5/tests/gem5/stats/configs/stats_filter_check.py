@@ -0,0 +1,100 @@
+# Copyright (c) 2026 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+"""
+This script checks that a stat filter (``--stats-filter``) is applied to
+the text and binary ("bin://") stat outputs, and that the binary output
+can be read back with ``m5.stats.binary_reader``.
+
+It is expected to be run with ``--stats-filter=system.*,simTicks``. Two
+stat testers are created, "system" and "other", and only the stat of the
+former, along with simTicks, may be dumped. Two dumps are taken at
+different ticks to check that the binary output only writes the values
+that changed.
+"""
+
+import os
+import sys
+
+import m5
+from m5.objects import (
+    Root,
+    ScalarStatTester,
+)
+from m5.stats import binary_reader
+
+expected_names = ["simTicks", "system.kept"]
+
+m5.stats.addStatVisitor("bin://stats.bin")
+
+root = Root(full_system=False)
+root.system = ScalarStatTester(name="kept", value=1)
+root.other = ScalarStatTester(name="dropped", value=2)
+
+m5.instantiate()
+
+ticks = []
+for _ in range(2):
+    m5.simulate(1000)
+    m5.stats.dump()
+    ticks.append(m5.curTick())
+
+errors = []
+
+# The text output has a header and a footer around each dump. Every
+# other non-empty line starts with the stat name.
+with open(os.path.join(m5.options.outdir, "stats.txt")) as f:
+    text_names = [
+        line.split()[0]
+        for line in f
+        if line.strip() and not line.startswith("-")
+    ]
+if sorted(set(text_names)) != expected_names:
+    errors.append(f"stats.txt has {sorted(set(text_names))}")
+if len(text_names) != 2 * len(expected_names):
+    errors.append(f"stats.txt has {len(text_names)} stats over two dumps")
+
+# The binary output writes every column in the first dump, but only the
+# columns that changed (here simTicks) in the second one.
+with open(os.path.join(m5.options.outdir, "stats.bin"), "rb") as f:
+    columns, dumps = binary_reader.read_records(f)
+names = {name: column for column, name in columns.items()}
+if sorted(names) != expected_names:
+    errors.append(f"stats.bin has {sorted(names)}")
+elif [tick for tick, _ in dumps] != ticks:
+    errors.append(f"stats.bin has dumps at {[t for t, _ in dumps]}")
+else:
+    expected_dumps = [
+        {names["simTicks"]: ticks[0], names["system.kept"]: 1},
+        {names["simTicks"]: ticks[1]},
+    ]
+    if [changed for _, changed in dumps] != expected_dumps:
+        errors.append(f"stats.bin has dumps {dumps}")
+
+if errors:
+    for error in errors:
+        print(error, file=sys.stderr)
+    sys.exit(1)
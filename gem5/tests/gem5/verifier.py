@@ -43,9 +43,14 @@ Built in test cases that verify particular details about a gem5 run.
 import json
 import os
 import re
+import subprocess
+import sys
 
 from testlib import test_util
-from testlib.configuration import constants
+from testlib.configuration import (
+    config,
+    constants,
+)
 from testlib.helper import (
     diff_out_file,
     joinpath,
@@ -80,6 +85,53 @@ class CheckH5StatsExist(Verifier):
             test_util.fail("Could not find h5 stats file %s", h5_file)
 
 
+class CheckBinaryDebugTrace(Verifier):
+    """
+    Decodes a binary debug trace (--debug-binary or --debug-ring) with
+    util/decode_debug_trace.py and checks that it holds as many messages
+    matching a regex as the value of a stat in stats.txt, i.e., that no
+    message was lost when gem5 exited.
+    """
+
+    def __init__(self, trace_file, regex, stat):
+        super().__init__()
+        self.trace_file = trace_file
+        self.regex = re.compile(regex)
+        self.stat = stat
+
+    def test(self, params):
+        tempdir = params.fixtures[constants.tempdir_fixture_name].path
+        decoder = joinpath(config.base_dir, "util", "decode_debug_trace.py")
+        decoded = subprocess.run(
+            [sys.executable, decoder, joinpath(tempdir, self.trace_file)],
+            capture_output=True,
+            text=True,
+        )
+        if decoded.returncode != 0:
+            test_util.fail(
+                f"Could not decode {self.trace_file}:\n{decoded.stderr}"
+            )
+        messages = sum(
+            1
+            for line in decoded.stdout.splitlines()
+            if self.regex.search(line)
+        )
+
+        expected = None
+        with open(joinpath(tempdir, "stats.txt")) as f:
+            for line in f:
+                fields = line.split()
+                if fields and fields[0] == self.stat:
+                    expected = int(float(fields[1]))
+        if expected is None:
+            test_util.fail(f"Could not find {self.stat} in stats.txt")
+        if messages != expected:
+            test_util.fail(
+                f"{self.trace_file} has {messages} messages matching "
+                f"{self.regex.pattern}, {self.stat} is {expected}"
+            )
+
+
 class MatchGoldStandard(Verifier):
     """
     Compares a standard output to the test output and passes if they match,
@@ -0,0 +1,135 @@
+# Copyright (c) 2026 The Regents of the University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+import gzip
+import io
+import os
+import struct
+import tempfile
+import unittest
+
+from m5.stats import binary_reader
+
+
+def _varint(value):
+    out = bytearray()
+    while True:
+        byte = value & 0x7F
+        value >>= 7
+        if value:
+            out.append(byte | 0x80)
+        else:
+            out.append(byte)
+            return bytes(out)
+
+
+def _names(columns):
+    out = b"S" + _varint(len(columns))
+    for column, name in columns:
+        out += _varint(column) + _varint(len(name)) + name.encode()
+    return out
+
+
+def _dump(tick, changed):
+    out = b"D" + _varint(tick) + _varint(len(changed))
+    next_column = 0
+    for column, value in changed:
+        out += _varint(column - next_column) + struct.pack("<d", value)
+        next_column = column + 1
+    return out
+
+
+def _header():
+    return binary_reader.MAGIC + struct.pack("<I", binary_reader.VERSION)
+
+
+def _stream():
+    """A stream the way statistics::Binary writes it: the second dump adds
+    a column and only stores the values that changed."""
+
+    return (
+        _header()
+        + _names([(0, "system.a"), (1, "system.b")])
+        + _dump(1000, [(0, 1.0), (1, 2.0)])
+        + _names([(2, "system.c")])
+        + _dump(2000, [(0, 3.0), (2, 300.0)])
+        + _dump(3000, [])
+    )
+
+
+class BinaryReaderTestSuite(unittest.TestCase):
+    """Test cases for the binary stat reader"""
+
+    def test_varint(self):
+        for value in [0, 1, 127, 128, 300, 2**35 + 7]:
+            f = io.BytesIO(_varint(value))
+            self.assertEqual(binary_reader._read_varint(f), value)
+
+    def test_read_records(self):
+        columns, dumps = binary_reader.read_records(io.BytesIO(_stream()))
+        self.assertEqual(
+            columns, {0: "system.a", 1: "system.b", 2: "system.c"}
+        )
+        self.assertEqual(
+            dumps,
+            [
+                (1000, {0: 1.0, 1: 2.0}),
+                (2000, {0: 3.0, 2: 300.0}),
+                (3000, {}),
+            ],
+        )
+
+    def test_csv_carries_values_forward(self):
+        with tempfile.TemporaryDirectory() as tmpdir:
+            path = os.path.join(tmpdir, "stats.bin.gz")
+            with gzip.open(path, "wb") as f:
+                f.write(_stream())
+            out = io.StringIO()
+            binary_reader._to_csv(path, out)
+
+        self.assertEqual(
+            out.getvalue().splitlines(),
+            [
+                "tick,system.a,system.b,system.c",
+                "1000,1.0,2.0,nan",
+                "2000,3.0,2.0,300.0",
+                "3000,3.0,2.0,300.0",
+            ],
+        )
+
+    def test_bad_magic(self):
+        with self.assertRaises(binary_reader.BinaryStatsError):
+            binary_reader.read_records(io.BytesIO(b"notgem5!" + b"\0" * 4))
+
+    def test_bad_version(self):
+        stream = binary_reader.MAGIC + struct.pack("<I", 99)
+        with self.assertRaises(binary_reader.BinaryStatsError):
+            binary_reader.read_records(io.BytesIO(stream))
+
+    def test_truncated(self):
+        stream = _header() + b"D" + b"\x80"
+        with self.assertRaises(binary_reader.BinaryStatsError):
+            binary_reader.read_records(io.BytesIO(stream))
@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2026 The Regents of the University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+/*
+ * Self-modifying code test. A small function is copied to a page and
+ * run, then patched both from outside and by itself, the latter from
+ * the instruction right before the one it patches. It is finally
+ * patched by the kernel, reading from a pipe, which the CPU does not see
+ * as one of its own stores, much like a DMA transfer. Prints PASS if
+ * every call sees the code as last written.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+/* int f(unsigned char *p, int v) { *p = v; return 1; } */
+static const unsigned char code[] = {
+    0x40, 0x88, 0x37,             /* mov %sil, (%rdi) */
+    0xb8, 0x01, 0x00, 0x00, 0x00, /* mov $1, %eax */
+    0xc3,                         /* ret */
+};
+
+/* Offset of the immediate that f returns */
+#define IMM_OFFSET 4
+
+typedef int (*func_t)(unsigned char *, int);
+
+static int
+run(func_t f, unsigned char *p, int v, int expected, int times)
+{
+    int failures = 0;
+    for (int i = 0; i < times; i++) {
+        if (f(p, v) != expected)
+            failures++;
+    }
+    return failures;
+}
+
+int
+main()
+{
+    unsigned char *page = mmap(NULL, 4096,
+                               PROT_READ | PROT_WRITE | PROT_EXEC,
+                               MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (page == MAP_FAILED) {
+        perror("mmap");
+        return 1;
+    }
+
+    memcpy(page, code, sizeof(code));
+    __builtin___clear_cache((char *)page, (char *)page + sizeof(code));
+    func_t f = (func_t)page;
+    unsigned char data;
+    int failures = 0;
+
+    /* Warm up, so that the code is cached by the simulator */
+    failures += run(f, &data, 0, 1, 100);
+
+    /* Patch the code from outside */
+    page[IMM_OFFSET] = 2;
+    failures += run(f, &data, 0, 2, 100);
+
+    /* Have the store in f patch the very next instruction */
+    failures += run(f, page + IMM_OFFSET, 3, 3, 1);
+    failures += run(f, &data, 0, 3, 100);
+
+    /* Have the kernel patch the code */
+    int fds[2];
+    unsigned char imm = 4;
+    if (pipe(fds) != 0 || write(fds[1], &imm, 1) != 1 ||
+            read(fds[0], page + IMM_OFFSET, 1) != 1) {
+        perror("pipe");
+        return 1;
+    }
+    failures += run(f, &data, 0, 4, 100);
+
+    printf("%s\n", failures ? "FAIL" : "PASS");
+    return failures != 0;
+}
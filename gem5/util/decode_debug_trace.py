@@ -0,0 +1,260 @@
+#!/usr/bin/env python3
+
+# Copyright (c) 2026 The Regents of the University of California.
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+"""
+Render a binary debug trace, as written by gem5 when run with
+--debug-binary or --debug-ring, in the same text format as the regular
+debug output.
+
+Usage: decode_debug_trace.py [--flags] [--no-ticks] <trace> [output]
+"""
+
+import argparse
+import gzip
+import heapq
+import re
+import struct
+import sys
+
+MAGIC = b"gem5dbgt"
+VERSION = 1
+
+INT, UINT, FLOAT, CHAR, STRING, POINTER = range(6)
+
+# Conversion specification as accepted by cprintf. Length modifiers are
+# ignored since the arguments carry their own types.
+SPEC_RE = re.compile(
+    r"%(?P<flags>[-+ #0]*)(?P<width>\*|\d+)?(?:\.(?P<prec>\*|\d+))?"
+    r"(?:hh|h|ll|l|q|L|j|z|t)*(?P<conv>[%a-zA-Z])"
+)
+
+
+def open_trace(path):
+    with open(path, "rb") as f:
+        gzipped = f.read(2) == b"\x1f\x8b"
+    return gzip.open(path, "rb") if gzipped else open(path, "rb")
+
+
+class Reader:
+    def __init__(self, data):
+        self.data = data
+        self.pos = 0
+
+    def done(self):
+        return self.pos >= len(self.data)
+
+    def byte(self):
+        b = self.data[self.pos]
+        self.pos += 1
+        return b
+
+    def varint(self):
+        value = 0
+        shift = 0
+        while True:
+            b = self.byte()
+            value |= (b & 0x7F) << shift
+            if not b & 0x80:
+                return value
+            shift += 7
+
+    def raw(self, size):
+        b = self.data[self.pos : self.pos + size]
+        self.pos += size
+        return b
+
+    def arg(self):
+        kind = self.byte()
+        if kind == INT:
+            v = self.varint()
+            return (v >> 1) ^ -(v & 1)
+        if kind in (UINT, POINTER):
+            return self.varint()
+        if kind == FLOAT:
+            return struct.unpack("<d", self.raw(8))[0]
+        if kind == CHAR:
+            return chr(self.byte())
+        if kind == STRING:
+            return self.raw(self.varint()).decode("utf-8", "replace")
+        raise ValueError(f"Unknown argument type {kind}")
+
+
+def read_trace(path):
+    """
+    Read a trace file. Returns the string table and a list with the
+    messages of each block as (tick, name, flag, fmt, args) tuples, with
+    ids instead of strings. A tick of None marks an untimed message.
+    """
+    with open_trace(path) as f:
+        reader = Reader(f.read())
+
+    if reader.raw(8) != MAGIC:
+        sys.exit(f"{path} is not a binary debug trace")
+    version = struct.unpack("<I", reader.raw(4))[0]
+    if version != VERSION:
+        sys.exit(f"Unsupported trace version {version}")
+
+    strings = {}
+    blocks = []
+    while not reader.done():
+        kind = reader.raw(1)
+        if kind == b"T":
+            sid = reader.varint()
+            strings[sid] = reader.raw(reader.varint()).decode(
+                "utf-8", "replace"
+            )
+        elif kind == b"B":
+            thread = reader.varint()
+            end = reader.varint() + reader.pos
+            messages = []
+            while reader.pos < end:
+                tick = reader.varint()
+                name, flag, fmt = (reader.varint() for _ in range(3))
+                args = [reader.arg() for _ in range(reader.varint())]
+                tick = tick - 1 if tick else None
+                messages.append((tick, name, flag, fmt, args))
+            blocks.append((thread, messages))
+        else:
+            sys.exit(f"Corrupt trace at offset {reader.pos - 1}")
+    return strings, blocks
+
+
+def convert(spec, arg):
+    """Format one argument, accepting type mismatches like cprintf."""
+    conv = spec.group("conv")
+    flags = spec.group("flags") or ""
+    width = spec.group("width") or ""
+    prec = spec.group("prec")
+    prec = "" if prec is None else "." + prec
+
+    if conv in "csS" or isinstance(arg, str):
+        if conv == "c" and isinstance(arg, int):
+            arg = chr(arg & 0xFF)
+        text = str(arg)
+        if prec:
+            text = text[: int(prec[1:])]
+        return ("{:" + ("<" if "-" in flags else ">") + width + "}").format(
+            text
+        )
+    if conv == "p":
+        return ("{:" + ("<" if "-" in flags else ">") + width + "}").format(
+            hex(int(arg))
+        )
+    if conv in "diu":
+        conv = "d"
+    if conv in "dxXo" and isinstance(arg, float):
+        arg = int(arg)
+    if conv in "eEfFgG" and isinstance(arg, int):
+        arg = float(arg)
+    if conv in "xXo" and arg < 0:
+        arg &= (1 << 64) - 1
+    try:
+        return ("%" + flags + width + prec + conv) % arg
+    except (TypeError, ValueError):
+        return str(arg)
+
+
+def render(fmt, args):
+    out = []
+    pos = 0
+    args = iter(args)
+    for spec in SPEC_RE.finditer(fmt):
+        out.append(fmt[pos : spec.start()])
+        pos = spec.end()
+        if spec.group("conv") == "%":
+            out.append("%")
+            continue
+        if spec.group("width") == "*":
+            spec = SPEC_RE.match(
+                spec.group(0).replace("*", str(next(args, "")), 1)
+            )
+        if spec.group("prec") == "*":
+            spec = SPEC_RE.match(
+                spec.group(0).replace("*", str(next(args, "")), 1)
+            )
+        arg = next(args, None)
+        out.append("<missing>" if arg is None else convert(spec, arg))
+    out.append(fmt[pos:])
+    return "".join(out)
+
+
+def thread_messages(blocks, thread):
+    """Messages of one thread, with untimed ones given a sort key."""
+    last = 0
+    for tid, messages in blocks:
+        if tid != thread:
+            continue
+        for msg in messages:
+            if msg[0] is not None:
+                last = msg[0]
+            yield last, msg
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n\n")[0])
+    parser.add_argument("trace", help="binary debug trace")
+    parser.add_argument(
+        "output", nargs="?", help="output file (default: stdout)"
+    )
+    parser.add_argument(
+        "--flags",
+        action="store_true",
+        help="prefix messages with their flag (like --debug-flags=FmtFlag)",
+    )
+    parser.add_argument(
+        "--no-ticks",
+        action="store_true",
+        help="omit ticks (like --debug-flags=FmtTicksOff)",
+    )
+    args = parser.parse_args()
+
+    strings, blocks = read_trace(args.trace)
+    threads = sorted({tid for tid, _ in blocks})
+    # Each thread logs in tick order, merge the threads on tick.
+    merged = heapq.merge(
+        *(thread_messages(blocks, tid) for tid in threads),
+        key=lambda m: m[0],
+    )
+
+    out = open(args.output, "w") if args.output else sys.stdout
+    for _, (tick, name, flag, fmt, msg_args) in merged:
+        line = []
+        if not args.no_ticks and tick is not None:
+            line.append(f"{tick:7d}: ")
+        if args.flags and strings[flag]:
+            line.append(f"{strings[flag]}: ")
+        if strings[name]:
+            line.append(f"{strings[name]}: ")
+        line.append(render(strings[fmt], msg_args))
+        out.write("".join(line))
+    if out is not sys.stdout:
+        out.close()
+
+
+if __name__ == "__main__":
+    main()